@@ -8,6 +8,7 @@ UTIL_SOURCES = \
 	$(UTIL_SRC_DIR)/UTF8.cpp \
 	$(UTIL_SRC_DIR)/EscapeBackslash.cpp \
 	$(UTIL_SRC_DIR)/ConvertString.cpp \
-	$(UTIL_SRC_DIR)/StringUtil.cpp
+	$(UTIL_SRC_DIR)/StringUtil.cpp \
+	$(UTIL_SRC_DIR)/StringPool.cpp
 
 $(eval $(call link-library,util,UTIL))
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "Airspace/AirspaceGlue.hpp"
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/CompiledAirspaceFile.hpp"
 #include "Engine/Airspace/Airspaces.hpp"
 #include "Profile/ProfileKeys.hpp"
 #include "Terrain/RasterTerrain.hpp"
@@ -30,6 +31,7 @@ Copyright_License {
 #include "Language/Language.hpp"
 #include "LogFile.hpp"
 #include "IO/TextFile.hpp"
+#include "IO/FileCache.hpp"
 #include "Profile/Profile.hpp"
 
 #include <windef.h> /* for MAX_PATH */
@@ -53,9 +55,55 @@ ParseAirspaceFile(AirspaceParser &parser, const TCHAR *path,
   return true;
 }
 
+/**
+ * Load the airspace file from its compiled version in the cache, and
+ * compile it if the cache does not have a valid one.  Falls back to
+ * parsing the file if there is no cache, or if the file cannot be
+ * cached.
+ *
+ * @param name the name of the compiled airspace file in the cache
+ */
+static bool
+ReadAirspaceFile(Airspaces &airspaces, AirspaceParser &parser,
+                 FileCache *cache, const TCHAR *name, const TCHAR *path,
+                 OperationEnvironment &operation)
+{
+  if (cache != NULL) {
+    CompiledAirspacesLoader loader(airspaces);
+    if (CompiledFile::Load(*cache, name, path, loader))
+      return true;
+
+    /* create the cache file before parsing; if the file cannot be
+       cached (e.g. the airspace.txt inside a map file), it is parsed
+       only once below */
+    FILE *file = cache->Save(name, path);
+    if (file != NULL) {
+      Airspaces parsed;
+      AirspaceParser compile_parser(parsed);
+      if (!ParseAirspaceFile(compile_parser, path, operation)) {
+        cache->Cancel(name, file);
+        return false;
+      }
+
+      parsed.Optimise();
+
+      if (CompiledFile::Finish(*cache, name, file,
+                               SaveCompiledAirspaces(file, path, parsed)) &&
+          CompiledFile::Load(*cache, name, path, loader))
+        return true;
+
+      /* writing or loading the compiled file has failed; parse the
+         file again */
+    }
+  }
+
+  return ParseAirspaceFile(parser, path, operation);
+}
+
 void
 ReadAirspace(Airspaces &airspaces,
              RasterTerrain *terrain,
+             FileCache *cache,
              const AtmosphericPressure &press,
              OperationEnvironment &operation)
 {
@@ -69,14 +117,18 @@ ReadAirspace(Airspaces &airspaces,
   // Read the airspace filenames from the registry
   TCHAR path[MAX_PATH];
   if (Profile::GetPath(ProfileKeys::AirspaceFile, path))
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= ReadAirspaceFile(airspaces, parser, cache,
+                                    _T("airspace"), path, operation);
 
   if (Profile::GetPath(ProfileKeys::AdditionalAirspaceFile, path))
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= ReadAirspaceFile(airspaces, parser, cache,
+                                    _T("airspace_additional"), path,
+                                    operation);
 
   if (Profile::GetPath(ProfileKeys::MapFile, path)) {
     _tcscat(path, _T("/airspace.txt"));
-    airspace_ok |= ParseAirspaceFile(parser, path, operation);
+    airspace_ok |= ReadAirspaceFile(airspaces, parser, cache,
+                                    _T("airspace_map"), path, operation);
   }
 
   if (airspace_ok) {
@@ -0,0 +1,239 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Airspace/CompiledAirspaceFile.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Airspace/AirspaceCircle.hpp"
+#include "Engine/Airspace/AirspacePolygon.hpp"
+#include "IO/MemoryReader.hpp"
+#include "Util/tstring.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace CompiledAirspaceFile {
+  /**
+   * Followed by the base and the top #Altitude, the name, the radio
+   * frequency and the geometry: the center (#GeoPoint) and the radius
+   * (fixed) of a circle, and the #num_points border points (#GeoPoint)
+   * of both shapes.
+   */
+  struct Record {
+    uint8_t shape;
+    uint8_t type;
+    uint8_t days;
+
+    /**
+     * The result of AbstractAirspace::IsConvex(), which is expensive
+     * to compute for large polygons.
+     */
+    uint8_t convex;
+
+    uint32_t name_length, radio_length;
+    uint32_t num_points;
+  };
+
+  struct Altitude {
+    fixed altitude;
+    fixed flight_level;
+    fixed altitude_above_terrain;
+    int32_t reference;
+  };
+}
+
+using namespace CompiledAirspaceFile;
+
+static bool
+WriteString(FILE *file, const tstring &value)
+{
+  return fwrite(value.data(), sizeof(TCHAR), value.length(),
+                file) == value.length();
+}
+
+static bool
+WriteAltitude(FILE *file, const AirspaceAltitude &value)
+{
+  Altitude altitude;
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(&altitude, 0, sizeof(altitude));
+
+  altitude.altitude = value.altitude;
+  altitude.flight_level = value.flight_level;
+  altitude.altitude_above_terrain = value.altitude_above_terrain;
+  altitude.reference = (int32_t)value.reference;
+
+  return fwrite(&altitude, sizeof(altitude), 1, file) == 1;
+}
+
+static bool
+WriteRecord(FILE *file, const AbstractAirspace &airspace)
+{
+  const tstring name = airspace.GetName();
+  const tstring radio = airspace.GetRadioText();
+  const SearchPointVector &points = airspace.GetPoints();
+  const bool circle = airspace.GetShape() == AbstractAirspace::Shape::CIRCLE;
+
+  Record record;
+  record.shape = (uint8_t)airspace.GetShape();
+  record.type = airspace.GetType();
+  record.days = airspace.GetDays().GetMask();
+  record.convex = airspace.IsConvex();
+  record.name_length = name.length();
+  record.radio_length = radio.length();
+  record.num_points = points.size();
+
+  if (fwrite(&record, sizeof(record), 1, file) != 1 ||
+      !WriteAltitude(file, airspace.GetBase()) ||
+      !WriteAltitude(file, airspace.GetTop()) ||
+      !WriteString(file, name) ||
+      !WriteString(file, radio))
+    return false;
+
+  if (circle) {
+    const AirspaceCircle &c = (const AirspaceCircle &)airspace;
+    const GeoPoint center = c.GetCenter();
+    if (fwrite(&center, sizeof(center), 1, file) != 1 ||
+        fwrite(&c.GetRadius(), sizeof(c.GetRadius()), 1, file) != 1)
+      return false;
+  }
+
+  for (const auto &point : points)
+    if (fwrite(&point.GetLocation(), sizeof(GeoPoint), 1, file) != 1)
+      return false;
+
+  return true;
+}
+
+bool
+SaveCompiledAirspaces(FILE *file, const TCHAR *source_path,
+                      const Airspaces &airspaces)
+{
+  if (!CompiledFile::WriteHeader(file, source_path, airspaces.size()))
+    return false;
+
+  for (const auto &i : airspaces)
+    if (!WriteRecord(file, *i.GetAirspace()))
+      return false;
+
+  return true;
+}
+
+static bool
+ReadAltitude(MemoryReader &reader, AirspaceAltitude &value)
+{
+  Altitude altitude;
+  if (!reader.Read(altitude))
+    return false;
+
+  value.altitude = altitude.altitude;
+  value.flight_level = altitude.flight_level;
+  value.altitude_above_terrain = altitude.altitude_above_terrain;
+  value.reference = (AltitudeReference)altitude.reference;
+  return true;
+}
+
+static AbstractAirspace *
+ReadRecord(MemoryReader &reader)
+{
+  Record record;
+  AirspaceAltitude base, top;
+  tstring name, radio;
+  if (!reader.Read(record) ||
+      record.type >= AIRSPACECLASSCOUNT ||
+      !ReadAltitude(reader, base) ||
+      !ReadAltitude(reader, top) ||
+      !reader.ReadString(name, record.name_length) ||
+      !reader.ReadString(radio, record.radio_length))
+    return nullptr;
+
+  const auto shape = (AbstractAirspace::Shape)record.shape;
+  GeoPoint center;
+  fixed radius;
+  if (shape == AbstractAirspace::Shape::CIRCLE &&
+      (!reader.Read(center) || !reader.Read(radius)))
+    return nullptr;
+
+  if (record.num_points > reader.GetRemaining() / sizeof(GeoPoint))
+    return nullptr;
+
+  SearchPointVector border;
+  border.reserve(record.num_points);
+  for (unsigned i = 0; i < record.num_points; ++i) {
+    GeoPoint point;
+    reader.Read(point);
+    border.emplace_back(point);
+  }
+
+  AbstractAirspace *airspace;
+  switch (shape) {
+  case AbstractAirspace::Shape::CIRCLE:
+    airspace = new AirspaceCircle(center, radius, std::move(border));
+    break;
+
+  case AbstractAirspace::Shape::POLYGON:
+    airspace = new AirspacePolygon(std::move(border), record.convex);
+    break;
+
+  default:
+    return nullptr;
+  }
+
+  AirspaceActivity days;
+  days.SetMask(record.days);
+
+  airspace->SetProperties(name, (AirspaceClass)record.type, base, top);
+  airspace->SetRadio(radio);
+  airspace->SetDays(days);
+  return airspace;
+}
+
+CompiledAirspacesLoader::CompiledAirspacesLoader(Airspaces &_airspaces)
+  :airspaces(_airspaces) {}
+
+CompiledAirspacesLoader::~CompiledAirspacesLoader() {}
+
+bool
+CompiledAirspacesLoader::Read(MemoryReader &reader, unsigned n_records)
+{
+  loaded.clear();
+
+  for (unsigned i = 0; i < n_records; ++i) {
+    AbstractAirspace *airspace = ReadRecord(reader);
+    if (airspace == nullptr)
+      return false;
+
+    loaded.emplace_back(airspace);
+  }
+
+  return true;
+}
+
+void
+CompiledAirspacesLoader::Commit()
+{
+  for (auto &airspace : loaded)
+    airspaces.Add(airspace.release());
+
+  loaded.clear();
+}
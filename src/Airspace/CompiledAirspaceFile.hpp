@@ -0,0 +1,71 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_COMPILED_AIRSPACE_FILE_HPP
+#define XCSOAR_COMPILED_AIRSPACE_FILE_HPP
+
+#include "IO/CompiledFile.hpp"
+
+#include <memory>
+#include <vector>
+
+class Airspaces;
+class AbstractAirspace;
+
+/**
+ * The payload of a compiled airspace file (see #CompiledFile): the
+ * geometry, altitudes, classes, names, radio frequencies and days of
+ * operation of the airspaces parsed from one OpenAir or TNP file.
+ */
+
+/**
+ * Write all airspaces of the given #Airspaces object to a compiled
+ * airspace file.
+ *
+ * @param source_path the path of the text file the airspaces were
+ * parsed from
+ * @return true on success
+ */
+bool
+SaveCompiledAirspaces(FILE *file, const TCHAR *source_path,
+                      const Airspaces &airspaces);
+
+/**
+ * Reads the airspaces of a compiled airspace file, and adds them to
+ * the #Airspaces object when the file is valid.
+ */
+class CompiledAirspacesLoader final : public CompiledFile::Loader {
+  Airspaces &airspaces;
+
+  std::vector<std::unique_ptr<AbstractAirspace>> loaded;
+
+public:
+  explicit CompiledAirspacesLoader(Airspaces &_airspaces);
+  ~CompiledAirspacesLoader();
+
+  /* virtual methods from CompiledFile::Loader */
+  virtual bool Read(MemoryReader &reader, unsigned n_records) override;
+  virtual void Commit() override;
+};
+
+#endif
@@ -36,6 +36,7 @@ FileCache *file_cache;
 ProtectedMarkers *protected_marks;
 TopographyStore *topography;
 RasterTerrain *terrain;
+TerrainPrefetchThread *terrain_prefetch;
 RasterWeather RASP;
 
 #ifndef ENABLE_OPENGL
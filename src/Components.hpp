@@ -30,6 +30,7 @@ class FileCache;
 class ProtectedMarkers;
 class TopographyStore;
 class RasterTerrain;
+class TerrainPrefetchThread;
 class RasterWeather;
 class GlideComputer;
 class DrawThread;
@@ -55,6 +56,7 @@ extern Replay *replay;
 extern ProtectedMarkers *protected_marks;
 extern TopographyStore *topography;
 extern RasterTerrain *terrain;
+extern TerrainPrefetchThread *terrain_prefetch;
 extern RasterWeather RASP;
 extern GlideComputer *glide_computer;
 #ifndef ENABLE_OPENGL
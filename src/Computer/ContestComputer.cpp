@@ -25,11 +25,46 @@ Copyright_License {
 #include "Engine/Contest/Settings.hpp"
 #include "NMEA/Derived.hpp"
 
-ContestComputer::ContestComputer(const Trace &trace_full,
-                                 const Trace &trace_sprint)
-  :contest_manager(Contest::OLC_SPRINT, trace_full, trace_sprint, true)
+ContestComputer::ContestComputer(const Trace &_trace_full,
+                                 const Trace &_trace_sprint)
+  :trace_full(_trace_full), trace_sprint(_trace_sprint),
+   snapshot_full(0, Trace::null_time, _trace_full.GetMaxSize()),
+   snapshot_sprint(0, Trace::null_time, _trace_sprint.GetMaxSize()),
+   contest_manager(Contest::OLC_SPRINT, snapshot_full, snapshot_sprint, true),
+   predicted(TracePoint::Invalid())
 {
   contest_manager.SetIncremental(true);
+  stats.Reset();
+}
+
+ContestComputer::~ContestComputer()
+{
+  ScopeLock protect(mutex);
+  StandbyThread::Stop();
+}
+
+void
+ContestComputer::Reset()
+{
+  ScopeLock protect(mutex);
+  WaitDone();
+
+  contest_manager.Reset();
+  stats.Reset();
+}
+
+void
+ContestComputer::Prepare(const ContestSettings &settings)
+{
+  if (snapshot_full.GetAppendSerial() != trace_full.GetAppendSerial())
+    snapshot_full.CopyFrom(trace_full);
+
+  if (snapshot_sprint.GetAppendSerial() != trace_sprint.GetAppendSerial())
+    snapshot_sprint.CopyFrom(trace_sprint);
+
+  contest_manager.SetPredicted(predicted);
+  contest_manager.SetHandicap(settings.handicap);
+  contest_manager.SetContest(settings.contest);
 }
 
 void
@@ -39,12 +74,15 @@ ContestComputer::Solve(const ContestSettings &settings,
   if (!settings.enable)
     return;
 
-  contest_manager.SetHandicap(settings.handicap);
-  contest_manager.SetContest(settings.contest);
+  ScopeLock protect(mutex);
+  contest_stats = stats;
 
-  contest_manager.UpdateIdle();
+  if (IsBusy())
+    /* still running, try again later */
+    return;
 
-  contest_stats = contest_manager.GetStats();
+  Prepare(settings);
+  Trigger();
 }
 
 bool
@@ -54,12 +92,24 @@ ContestComputer::SolveExhaustive(const ContestSettings &settings,
   if (!settings.enable)
     return false;
 
-  contest_manager.SetHandicap(settings.handicap);
-  contest_manager.SetContest(settings.contest);
+  ScopeLock protect(mutex);
+  WaitDone();
+
+  Prepare(settings);
 
   bool result = contest_manager.SolveExhaustive();
 
-  contest_stats = contest_manager.GetStats();
+  stats = contest_stats = contest_manager.GetStats();
 
   return result;
 }
+
+void
+ContestComputer::Tick()
+{
+  mutex.Unlock();
+  contest_manager.UpdateIdle();
+  mutex.Lock();
+
+  stats = contest_manager.GetStats();
+}
@@ -25,33 +25,83 @@ Copyright_License {
 #define XCSOAR_CONTEST_COMPUTER_HPP
 
 #include "Engine/Contest/ContestManager.hpp"
+#include "Engine/Trace/Trace.hpp"
+#include "Thread/StandbyThread.hpp"
 
 struct ContestSettings;
 struct ContestStatistics;
-class Trace;
 
-class ContestComputer {
+/**
+ * Runs the contest solvers in a background thread, so the
+ * #CalculationThread never waits for them.  The solvers work on
+ * snapshots of the traces, which are updated each time a new job is
+ * started.
+ */
+class ContestComputer final : private StandbyThread {
+  /**
+   * The traces owned by the #TraceComputer.  They may only be
+   * accessed by the #CalculationThread.
+   */
+  const Trace &trace_full, &trace_sprint;
+
+  /**
+   * Copies of the traces which are used by the solvers.  These and
+   * the #ContestManager may only be accessed by the background
+   * thread while it is busy, and by the caller while it is not.
+   */
+  Trace snapshot_full, snapshot_sprint;
+
   ContestManager contest_manager;
 
+  /**
+   * The results of the most recent job.  Protected by the mutex.
+   */
+  ContestStatistics stats;
+
+  /**
+   * The predicted trace point which will be passed to the
+   * #ContestManager when the next job is started.
+   */
+  TracePoint predicted;
+
 public:
   ContestComputer(const Trace &trace_full, const Trace &trace_sprint);
+  ~ContestComputer();
 
-  void Reset() {
-    contest_manager.Reset();
-  }
+  void Reset();
 
   /**
    * @see ContestDijkstra::SetPredicted()
    */
-  void SetPredicted(const TracePoint &predicted) {
-    contest_manager.SetPredicted(predicted);
+  void SetPredicted(const TracePoint &_predicted) {
+    predicted = _predicted;
   }
 
+  /**
+   * Copy the most recent results to #contest_stats, and start a new
+   * job in the background thread unless it is still busy.  This
+   * method does not block.
+   */
   void Solve(const ContestSettings &settings_computer,
              ContestStatistics &contest_stats);
 
+  /**
+   * Wait for the background thread, and find the final solution in
+   * the calling thread.
+   */
   bool SolveExhaustive(const ContestSettings &settings_computer,
                        ContestStatistics &contest_stats);
+
+private:
+  /**
+   * Copy the traces and the parameters to the #ContestManager.  The
+   * background thread must not be busy.
+   */
+  void Prepare(const ContestSettings &settings);
+
+protected:
+  /* virtual methods from class StandbyThread */
+  virtual void Tick() override;
 };
 
 #endif
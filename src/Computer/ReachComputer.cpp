@@ -0,0 +1,132 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "ReachComputer.hpp"
+#include "Task/ProtectedRoutePlanner.hpp"
+#include "Terrain/RasterTerrain.hpp"
+
+/**
+ * Runs a #ReachWorkers::Job in the #ThreadPool.
+ */
+class ReachJobAdapter final : public ThreadPool::Job {
+  ReachWorkers::Job &job;
+
+public:
+  explicit ReachJobAdapter(ReachWorkers::Job &_job):job(_job) {}
+
+  virtual void Run(unsigned index, unsigned n) override {
+    job.Run(index, n);
+  }
+};
+
+void
+ReachComputer::Workers::Run(Job &job)
+{
+  ReachJobAdapter adapter(job);
+  thread_pool.Run(adapter);
+}
+
+ReachComputer::ReachComputer()
+  :origin(GeoPoint::Invalid(), RoughAltitude(0)),
+   terrain(NULL), do_solve(false), ready(false) {}
+
+ReachComputer::~ReachComputer()
+{
+  ScopeLock protect(mutex);
+  StandbyThread::Stop();
+}
+
+bool
+ReachComputer::Start(ProtectedRoutePlanner &route_planner,
+                     const RasterTerrain *_terrain,
+                     const AGeoPoint &_origin,
+                     const RoutePlannerConfig &config,
+                     const RoughAltitude h_ceiling, const bool _do_solve)
+{
+  ScopeLock protect(mutex);
+  if (IsBusy() || ready)
+    /* still running, try again later */
+    return false;
+
+  {
+    ProtectedRoutePlanner::Lease lease(route_planner);
+    rpolars = lease->PrepareReach(_origin, config, h_ceiling);
+  }
+
+  terrain = _terrain;
+  origin = _origin;
+  do_solve = _do_solve;
+
+  Trigger();
+  return true;
+}
+
+bool
+ReachComputer::Publish(ProtectedRoutePlanner &route_planner)
+{
+  ScopeLock protect(mutex);
+  if (!ready)
+    return false;
+
+  ready = false;
+
+  {
+    ProtectedRoutePlanner::ExclusiveLease lease(route_planner);
+    lease->SwapReach(reach, rpolars);
+  }
+
+  /* free the old fans in this thread; the allocator of the fan tree
+     is not thread-safe */
+  reach.Reset();
+
+  return do_solve;
+}
+
+void
+ReachComputer::Cancel()
+{
+  ScopeLock protect(mutex);
+  WaitDone();
+
+  if (ready) {
+    reach.Reset();
+    ready = false;
+  }
+}
+
+void
+ReachComputer::Tick()
+{
+  mutex.Unlock();
+
+  if (terrain != NULL) {
+    RasterTerrain::Lease lease(*terrain);
+    const RasterMap &map = lease;
+    reach.Solve(origin, rpolars, &map, do_solve, &workers);
+  } else
+    reach.Solve(origin, rpolars, NULL, do_solve, &workers);
+
+  mutex.Lock();
+
+  ready = true;
+}
@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_REACH_COMPUTER_HPP
+#define XCSOAR_REACH_COMPUTER_HPP
+
+#include "Engine/Route/ReachFan.hpp"
+#include "Engine/Route/RoutePolars.hpp"
+#include "Engine/Route/ReachWorkers.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Thread/StandbyThread.hpp"
+#include "Thread/ThreadPool.hpp"
+
+struct RoutePlannerConfig;
+class RoughAltitude;
+class RasterTerrain;
+class ProtectedRoutePlanner;
+
+/**
+ * Solves the reach fans in a background thread, so the
+ * #CalculationThread never waits for them.  The fans of each depth
+ * are calculated in parallel by a #ThreadPool.  A finished reach is
+ * installed in the #RoutePlanner by Publish().
+ */
+class ReachComputer final : private StandbyThread {
+  /**
+   * Adapts the #ThreadPool to the #ReachWorkers interface of the
+   * engine library.
+   */
+  class Workers final : public ReachWorkers {
+    ThreadPool thread_pool;
+
+  public:
+    Workers() {
+      thread_pool.SetConcurrency(0);
+    }
+
+    /* virtual methods from class ReachWorkers */
+    virtual void Run(Job &job) override;
+  };
+
+  Workers workers;
+
+  /**
+   * The reach which is being solved.  This and the job parameters
+   * may only be accessed by the background thread while it is busy,
+   * and by the caller while it is not.
+   */
+  ReachFan reach;
+
+  /**
+   * The polars the reach is solved with.  They are calculated from
+   * the #RoutePlanner's reach polars when the job is started, and
+   * installed together with the reach by Publish().
+   */
+  RoutePolars rpolars;
+
+  AGeoPoint origin;
+
+  const RasterTerrain *terrain;
+
+  bool do_solve;
+
+  /**
+   * Has the job finished, and not been published yet?  Protected by
+   * the mutex.
+   */
+  bool ready;
+
+public:
+  ReachComputer();
+  ~ReachComputer();
+
+  /**
+   * Start solving the reach in the background thread.  Does nothing
+   * if the previous job has not been published yet.
+   *
+   * @param do_solve actually solve or just perform minimal calculations
+   * @return false if the previous job was still pending
+   */
+  bool Start(ProtectedRoutePlanner &route_planner,
+             const RasterTerrain *terrain,
+             const AGeoPoint &origin, const RoutePlannerConfig &config,
+             RoughAltitude h_ceiling, bool do_solve);
+
+  /**
+   * Install the result of a finished job in the #RoutePlanner.  This
+   * method does not block.
+   *
+   * @return true if a reach was published, and it was solved (see
+   * the do_solve parameter of Start())
+   */
+  bool Publish(ProtectedRoutePlanner &route_planner);
+
+  /**
+   * Wait for the current job to finish, and discard its result.
+   * Call this before the reach or the terrain are replaced.
+   */
+  void Cancel();
+
+protected:
+  /* virtual methods from class StandbyThread */
+  virtual void Tick() override;
+};
+
+#endif
@@ -47,6 +47,7 @@ RouteComputer::ResetFlight()
 {
   route_clock.Reset();
   reach_clock.Reset();
+  reach_computer.Cancel();
   protected_route_planner.Reset();
 
   last_task_type = TaskType::NONE;
@@ -138,10 +139,16 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
     /* without valid terrain information, we cannot calculate
        reachabilty, so let's skip that step completely */
     calculated.terrain_base_valid = false;
+    reach_computer.Cancel();
     protected_route_planner.ClearReach();
     return;
   }
 
+  if (reach_computer.Publish(protected_route_planner)) {
+    calculated.terrain_base = route_planner.GetTerrainBase();
+    calculated.terrain_base_valid = true;
+  }
+
   const bool do_solve = config.IsReachEnabled() && terrain != NULL;
 
   const AircraftState state = ToAircraftState(basic, calculated);
@@ -149,18 +156,16 @@ RouteComputer::Reach(const MoreData &basic, DerivedInfo &calculated,
   const RoughAltitude h_ceiling((short)std::max((int)basic.nav_altitude + 500,
                                                 (int)calculated.thermal_band.working_band_ceiling));
 
-  if (reach_clock.CheckAdvance(basic.time)) {
-    protected_route_planner.SolveReach(start, config, h_ceiling, do_solve);
-
-    if (do_solve) {
-      calculated.terrain_base = route_planner.GetTerrainBase();
-      calculated.terrain_base_valid = true;
-    }
-  }
+  if (reach_clock.CheckAdvance(basic.time) &&
+      !reach_computer.Start(protected_route_planner, terrain,
+                            start, config, h_ceiling, do_solve))
+    /* the previous job is still running, try again next time */
+    reach_clock.Reset();
 }
 
 void
 RouteComputer::set_terrain(const RasterTerrain* _terrain) {
+  reach_computer.Cancel();
   terrain = _terrain;
   protected_route_planner.SetTerrain(terrain);
 }
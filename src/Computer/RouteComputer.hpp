@@ -27,6 +27,7 @@ Copyright_License {
 #include "Task/ProtectedRoutePlanner.hpp"
 #include "Engine/Task/TaskType.hpp"
 #include "Engine/Route/RoutePlanner.hpp"
+#include "ReachComputer.hpp"
 #include "GPSClock.hpp"
 
 struct MoreData;
@@ -42,6 +43,8 @@ class RouteComputer {
   RoutePlannerGlue route_planner;
   ProtectedRoutePlanner protected_route_planner;
 
+  ReachComputer reach_computer;
+
   GPSClock route_clock;
   GPSClock reach_clock;
 
@@ -70,6 +73,7 @@ public:
    * container.  Call this before modifying the container.
    */
   void ClearAirspaces() {
+    reach_computer.Cancel();
     route_planner.Reset();
   }
 
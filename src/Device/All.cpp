@@ -98,6 +98,13 @@ AllDevicesPutQNH(const AtmosphericPressure &pres,
     device_list[i]->PutQNH(pres, env);
 }
 
+void
+AllDevicesCommitSamples()
+{
+  for (unsigned i = 0; i < NUMDEV; ++i)
+    device_list[i]->CommitSample();
+}
+
 void
 AllDevicesNotifySensorUpdate(const MoreData &basic)
 {
@@ -62,6 +62,13 @@ AllDevicesPutStandbyFrequency(RadioFrequency frequency,
 void
 AllDevicesPutQNH(const AtmosphericPressure &pres, OperationEnvironment &env);
 
+/**
+ * Copy the samples published by the port threads to the
+ * #DeviceBlackboard.  The caller must lock the #DeviceBlackboard.
+ */
+void
+AllDevicesCommitSamples();
+
 void
 AllDevicesNotifySensorUpdate(const MoreData &basic);
 
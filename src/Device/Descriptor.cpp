@@ -113,9 +113,11 @@ DeviceDescriptor::DeviceDescriptor(unsigned _index)
    adcairspeed(nullptr),
 #endif
 #endif
+   n_published_samples(0), n_replaced_samples(0),
    ticker(false), borrowed(false)
 {
   config.Clear();
+  parsed.Reset();
 #ifdef IOIOLIB
   for (unsigned i=0; i<sizeof i2cbaro/sizeof i2cbaro[0]; i++)
     i2cbaro[i] = nullptr;
@@ -210,11 +212,18 @@ DeviceDescriptor::Open(Port &_port, OperationEnvironment &env)
 
   device_blackboard->mutex.Lock();
   device_blackboard->SetRealState(index).Reset();
+  samples.Discard();
   device_blackboard->ScheduleMerge();
   device_blackboard->mutex.Unlock();
 
+  n_published_samples.store(0, std::memory_order_relaxed);
+  n_replaced_samples.store(0, std::memory_order_relaxed);
+
+  settings_mutex.Lock();
   settings_sent.Clear();
   settings_received.Clear();
+  settings_mutex.Unlock();
+
   was_alive = false;
 
   port = &_port;
@@ -233,6 +242,7 @@ DeviceDescriptor::Open(Port &_port, OperationEnvironment &env)
   }
 
   parser.Reset();
+  parsed.Reset();
   parser.SetReal(_tcscmp(driver->name, _T("Condor")) != 0);
   parser.SetIgnoreChecksum(config.ignore_checksum);
   if (config.IsDriver(_T("Condor")))
@@ -550,11 +560,23 @@ DeviceDescriptor::Close()
 
   device_blackboard->mutex.Lock();
   device_blackboard->SetRealState(index).Reset();
+  samples.Discard();
   device_blackboard->ScheduleMerge();
   device_blackboard->mutex.Unlock();
 
+  const unsigned n_published =
+    n_published_samples.load(std::memory_order_relaxed);
+  if (n_published > 0) {
+    TCHAR buffer[64];
+    LogFormat(_T("Device %s: %u samples, %u replaced before merge"),
+              config.GetPortName(buffer, 64), n_published,
+              n_replaced_samples.load(std::memory_order_relaxed));
+  }
+
+  settings_mutex.Lock();
   settings_sent.Clear();
   settings_received.Clear();
+  settings_mutex.Unlock();
 }
 
 void
@@ -695,7 +717,9 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
 
   /* restore the driver's ExternalSettings */
   const ExternalSettings old_settings = info.settings;
+  settings_mutex.Lock();
   info.settings = settings_received;
+  settings_mutex.Unlock();
 
   if (device != NULL && device->ParseNMEA(line, info)) {
     info.alive.Update(info.clock);
@@ -705,6 +729,7 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
 
     /* clear the settings when the values are the same that we already
        sent to the device */
+    const ScopeLock protect(settings_mutex);
     const ExternalSettings old_received = settings_received;
     settings_received = info.settings;
     info.settings.EliminateRedundant(settings_sent, old_received);
@@ -782,6 +807,7 @@ DeviceDescriptor::PutMacCready(fixed value, OperationEnvironment &env)
 
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
+  const ScopeLock protect_settings(settings_mutex);
   settings_sent.mac_cready = value;
   settings_sent.mac_cready_available.Update(basic.clock);
 
@@ -807,6 +833,7 @@ DeviceDescriptor::PutBugs(fixed value, OperationEnvironment &env)
 
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
+  const ScopeLock protect_settings(settings_mutex);
   settings_sent.bugs = value;
   settings_sent.bugs_available.Update(basic.clock);
 
@@ -834,6 +861,7 @@ DeviceDescriptor::PutBallast(fixed fraction, fixed overload,
 
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
+  const ScopeLock protect_settings(settings_mutex);
   settings_sent.ballast_fraction = fraction;
   settings_sent.ballast_fraction_available.Update(basic.clock);
   settings_sent.ballast_overload = overload;
@@ -912,6 +940,7 @@ DeviceDescriptor::PutQNH(const AtmosphericPressure &value,
 
   ScopeLock protect(device_blackboard->mutex);
   NMEAInfo &basic = device_blackboard->SetRealState(index);
+  const ScopeLock protect_settings(settings_mutex);
   settings_sent.qnh = value;
   settings_sent.qnh_available.Update(basic.clock);
 
@@ -1070,10 +1099,28 @@ DeviceDescriptor::OnCalculatedUpdate(const MoreData &basic,
 bool
 DeviceDescriptor::ParseLine(const char *line)
 {
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
-  basic.UpdateClock();
-  return ParseNMEA(line, basic);
+  parsed.UpdateClock();
+  parsed.Expire();
+  return ParseNMEA(line, parsed);
+}
+
+void
+DeviceDescriptor::PublishSample()
+{
+  samples.GetBack() = parsed;
+
+  n_published_samples.fetch_add(1, std::memory_order_relaxed);
+  if (!samples.Publish())
+    n_replaced_samples.fetch_add(1, std::memory_order_relaxed);
+
+  device_blackboard->ScheduleMerge();
+}
+
+void
+DeviceDescriptor::CommitSample()
+{
+  if (samples.Fetch())
+    device_blackboard->SetRealState(index) = samples.GetFront();
 }
 
 void
@@ -1098,17 +1145,16 @@ DeviceDescriptor::DataReceived(const void *data, size_t length)
 
   // Pass data directly to drivers that use binary data protocols
   if (driver != NULL && device != NULL && driver->UsesRawData()) {
-    ScopeLock protect(device_blackboard->mutex);
-    NMEAInfo &basic = device_blackboard->SetRealState(index);
-    basic.UpdateClock();
+    parsed.UpdateClock();
+    parsed.Expire();
 
-    const ExternalSettings old_settings = basic.settings;
+    const ExternalSettings old_settings = parsed.settings;
 
-    if (device->DataReceived(data, length, basic)) {
+    if (device->DataReceived(data, length, parsed)) {
       if (!config.sync_from_device)
-        basic.settings = old_settings;
+        parsed.settings = old_settings;
 
-      device_blackboard->ScheduleMerge();
+      PublishSample();
     }
 
     return;
@@ -1127,5 +1173,5 @@ DeviceDescriptor::LineReceived(const char *line)
     dispatcher->LineReceived(line);
 
   if (ParseLine(line))
-    device_blackboard->ScheduleMerge();
+    PublishSample();
 }
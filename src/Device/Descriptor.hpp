@@ -30,18 +30,21 @@ Copyright_License {
 #include "Device/Parser.hpp"
 #include "Profile/DeviceConfig.hpp"
 #include "RadioFrequency.hpp"
+#include "NMEA/Info.hpp"
 #include "NMEA/ExternalSettings.hpp"
 #include "Time/PeriodClock.hpp"
 #include "Job/Async.hpp"
 #include "Event/Notify.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/TripleBuffer.hpp"
 #include "Thread/Debug.hpp"
 
+#include <atomic>
+
 #include <assert.h>
 #include <tchar.h>
 #include <stdio.h>
 
-struct NMEAInfo;
 struct MoreData;
 struct DerivedInfo;
 struct Declaration;
@@ -154,6 +157,38 @@ class DeviceDescriptor final : private Notify, private PortLineSplitter {
    */
   NMEAParser parser;
 
+  /**
+   * The data parsed from this device.  It is owned by the thread
+   * which receives data from the #Port, and is updated without
+   * locking the #DeviceBlackboard.  After each update, a copy is
+   * published to #samples.
+   */
+  NMEAInfo parsed;
+
+  /**
+   * Passes copies of #parsed from the port thread to the
+   * #MergeThread, which commits them to the #DeviceBlackboard in
+   * CommitSample().
+   */
+  TripleBuffer<NMEAInfo> samples;
+
+  /**
+   * The number of samples published by the port thread, and the
+   * number of samples which were replaced by a newer one before the
+   * #MergeThread committed them.  These replace the blackboard lock
+   * acquisitions of the port thread; the ratio shows how often the
+   * #MergeThread runs per sample.  They are logged by Close().
+   */
+  std::atomic<unsigned> n_published_samples, n_replaced_samples;
+
+  /**
+   * Protects #settings_sent and #settings_received, which are
+   * written by the main thread and used by the port thread in
+   * ParseNMEA().  The main thread is the only writer of
+   * #settings_sent, and may read it without locking.
+   */
+  Mutex settings_mutex;
+
   /**
    * The settings that were sent to the device.  This is used to check
    * if the device is sending back the new configuration; then the
@@ -394,6 +429,13 @@ public:
   gcc_pure
   bool IsAlive() const;
 
+  /**
+   * Copy the latest sample published by the port thread to the
+   * #DeviceBlackboard.  Called by the #MergeThread; the caller must
+   * lock the #DeviceBlackboard.
+   */
+  void CommitSample();
+
 private:
   bool ParseNMEA(const char *line, struct NMEAInfo &info);
 
@@ -461,6 +503,12 @@ public:
 private:
   bool ParseLine(const char *line);
 
+  /**
+   * Publish a copy of #parsed to the #MergeThread.  Called by the
+   * port thread.
+   */
+  void PublishSample();
+
   /* virtual methods from class Notify */
   virtual void OnNotification() override;
 
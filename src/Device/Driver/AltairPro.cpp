@@ -121,22 +121,23 @@ AltairProDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
   // no propriatary sentence
 
-  if (StringIsEqual(type, "$PGRMZ")) {
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$PGRMZ"): {
     fixed value;
     if (ReadAltitude(line, value))
       info.ProvidePressureAltitude(value);
 
     return true;
-  } else if (StringIsEqual(type, "$PTFRS")) {
-    return PTFRS(line, info);
   }
 
-  return false;
+  case MakeNMEASentenceKey("$PTFRS"):
+    return PTFRS(line, info);
+
+  default:
+    return false;
+  }
 }
 
 bool
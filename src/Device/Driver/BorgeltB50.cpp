@@ -130,10 +130,7 @@ B50Device::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PBB50"))
+  if (line.ReadCompare("$PBB50"))
     return PBB50(line, info);
   else
     return false;
@@ -146,17 +146,17 @@ CAI302Device::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PCAIB"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$PCAIB"):
     return cai_PCAIB(line, info);
 
-  if (StringIsEqual(type, "$PCAID"))
+  case MakeNMEASentenceKey("$PCAID"):
     return cai_PCAID(line, info);
 
-  if (StringIsEqual(type, "!w"))
+  case MakeNMEASentenceKey("!w"):
     return cai_w(line, info);
 
-  return false;
+  default:
+    return false;
+  }
 }
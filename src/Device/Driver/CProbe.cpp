@@ -122,14 +122,10 @@ bool
 CProbeDevice::ParseNMEA(const char *_line, NMEAInfo &info)
 {
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (!StringIsEqual(type, "$PCPROBE"))
+  if (!line.ReadCompare("$PCPROBE"))
     return false;
 
-  line.Read(type, 16);
-  if (StringIsEqual(type, "T"))
+  if (line.ReadCompare("T"))
     return ParseData(line, info);
   else
     return false;
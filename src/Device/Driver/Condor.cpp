@@ -105,10 +105,7 @@ CondorDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$LXWP0"))
+  if (line.ReadCompare("$LXWP0"))
     return cLXWP0(line, info);
 
   return false;
@@ -81,10 +81,7 @@ EWMicroRecorderDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PGRMZ")) {
+  if (line.ReadCompare("$PGRMZ")) {
     fixed value;
 
     /* The normal Garmin $PGRMZ line contains the "true" barometric
@@ -51,15 +51,16 @@ EyeDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PEYA"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$PEYA"):
     return PEYA(line, info);
-  else if (StringIsEqual(type, "$PEYI"))
+
+  case MakeNMEASentenceKey("$PEYI"):
     return PEYI(line, info);
-  else
+
+  default:
     return false;
+  }
 }
 
 bool
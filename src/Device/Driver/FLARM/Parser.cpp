@@ -58,10 +58,7 @@ FlarmDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (strcmp(type, "$PFLAC") == 0)
+  if (line.ReadCompare("$PFLAC"))
     return ParsePFLAC(line);
   else
     return false;
@@ -96,10 +96,7 @@ FlymasterF1Device::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$VARIO"))
+  if (line.ReadCompare("$VARIO"))
     return VARIO(line, info);
   else
     return false;
@@ -253,15 +253,17 @@ FlytecDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$BRSF"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$BRSF"):
     return FlytecParseBRSF(line, info);
-  else if (StringIsEqual(type, "$VMVABD"))
+
+  case MakeNMEASentenceKey("$VMVABD"):
     return FlytecParseVMVABD(line, info);
-  else if (StringIsEqual(type, "$FLYSEN"))
+
+  case MakeNMEASentenceKey("$FLYSEN"):
     return ParseFLYSEN(line, info);
-  else
+
+  default:
     return false;
+  }
 }
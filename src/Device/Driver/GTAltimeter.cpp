@@ -79,10 +79,7 @@ GTAltimeterDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$LK8EX1"))
+  if (line.ReadCompare("$LK8EX1"))
     return LK8EX1(line, info);
 
   return false;
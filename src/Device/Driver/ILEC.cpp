@@ -90,12 +90,8 @@ ILECDevice::ParseNMEA(const char *_line, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, sizeof(type));
-
-  if (StringIsEqual(type, "$PILC")) {
-    line.Read(type, sizeof(type));
-    if (StringIsEqual(type, "PDA1"))
+  if (line.ReadCompare("$PILC")) {
+    if (line.ReadCompare("PDA1"))
       return ParsePDA1(line, info);
     else
       return false;
@@ -345,13 +345,12 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
 
-  if (StringIsEqual(type, "$LXWP0"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$LXWP0"):
     return LXWP0(line, info);
 
-  if (StringIsEqual(type, "$LXWP1")) {
+  case MakeNMEASentenceKey("$LXWP1"): {
     /* if in pass-through mode, assume that this line was sent by the
        secondary device */
     DeviceInfo &device_info = mode == Mode::PASS_THROUGH
@@ -384,19 +383,19 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (StringIsEqual(type, "$LXWP2"))
+  case MakeNMEASentenceKey("$LXWP2"):
     return LXWP2(line, info);
 
-  if (StringIsEqual(type, "$LXWP3"))
+  case MakeNMEASentenceKey("$LXWP3"):
     return LXWP3(line, info);
 
-  if (StringIsEqual(type, "$PLXV0")) {
+  case MakeNMEASentenceKey("$PLXV0"): {
     is_v7 = true;
     is_colibri = false;
     return PLXV0(line, v7_settings);
   }
 
-  if (StringIsEqual(type, "$PLXVC")) {
+  case MakeNMEASentenceKey("$PLXVC"): {
     is_nano = true;
     is_colibri = false;
     PLXVC(line, info.device, info.secondary_device, nano_settings);
@@ -404,17 +403,19 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (StringIsEqual(type, "$PLXVF")) {
+  case MakeNMEASentenceKey("$PLXVF"): {
     is_v7 = true;
     is_colibri = false;
     return PLXVF(line, info);
   }
 
-  if (StringIsEqual(type, "$PLXVS")) {
+  case MakeNMEASentenceKey("$PLXVS"): {
     is_v7 = true;
     is_colibri = false;
     return PLXVS(line, info);
   }
 
-  return false;
+  default:
+    return false;
+  }
 }
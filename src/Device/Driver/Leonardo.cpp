@@ -208,22 +208,22 @@ bool
 LeonardoDevice::ParseNMEA(const char *_line, NMEAInfo &info)
 {
   NMEAInputLine line(_line);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$C") ||
-      StringIsEqual(type, "$c"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$C"):
+  case MakeNMEASentenceKey("$c"):
     return LeonardoParseC(line, info);
 
-  else if (StringIsEqual(type, "$D") ||
-           StringIsEqual(type, "$d"))
+  case MakeNMEASentenceKey("$D"):
+  case MakeNMEASentenceKey("$d"):
     return LeonardoParseD(line, info);
 
-  else if (StringIsEqual(type, "$PDGFTL1") ||
-           StringIsEqual(type, "$PDGFTTL"))
+  case MakeNMEASentenceKey("$PDGFTL1"):
+  case MakeNMEASentenceKey("$PDGFTTL"):
     return PDGFTL1(line, info);
 
-  return false;
+  default:
+    return false;
+  }
 }
 
 static Device *
@@ -65,12 +65,9 @@ bool
 PGDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
   // $GPWIN ... Winpilot proprietary sentance includinh baro altitude
   // $GPWIN ,01900 , 0 , 5159 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 * 6 B , 0 7 * 6 0 E
-  if (StringIsEqual(type, "$GPWIN"))
+  if (line.ReadCompare("$GPWIN"))
     return GPWIN(line, info);
   else
     return LXDevice::ParseNMEA(String, info);
@@ -220,32 +220,42 @@ bool
 VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
+  const Range<const char *> type = line.ReadView();
 
-  if (memcmp(type, "$PD", 3) == 0)
+  if (type.end() - type.begin() >= 3 && memcmp(type.begin(), "$PD", 3) == 0)
     detected = true;
 
-  if (strcmp(type, "$PDSWC") == 0)
+  switch (MakeNMEASentenceKey(type.begin(), type.end())) {
+  case MakeNMEASentenceKey("$PDSWC"):
     return PDSWC(line, info, volatile_data);
-  else if (strcmp(type, "$PDAAV") == 0)
+
+  case MakeNMEASentenceKey("$PDAAV"):
     return PDAAV(line, info);
-  else if (strcmp(type, "$PDVSC") == 0)
+
+  case MakeNMEASentenceKey("$PDVSC"):
     return PDVSC(line, info);
-  else if (strcmp(type, "$PDVDV") == 0)
+
+  case MakeNMEASentenceKey("$PDVDV"):
     return PDVDV(line, info);
-  else if (strcmp(type, "$PDVDS") == 0)
+
+  case MakeNMEASentenceKey("$PDVDS"):
     return PDVDS(line, info);
-  else if (strcmp(type, "$PDVVT") == 0)
+
+  case MakeNMEASentenceKey("$PDVVT"):
     return PDVVT(line, info);
-  else if (strcmp(type, "$PDVSD") == 0) {
+
+  case MakeNMEASentenceKey("$PDVSD"): {
     const auto message = line.Rest();
     StaticString<256> buffer;
     buffer.SetASCII(message.begin(), message.end());
     Message::AddMessage(buffer);
     return true;
-  } else if (strcmp(type, "$PDTSM") == 0)
+  }
+
+  case MakeNMEASentenceKey("$PDTSM"):
     return PDTSM(line, info);
-  else
+
+  default:
     return false;
+  }
 }
@@ -66,10 +66,7 @@ VolksloggerDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PGCS"))
+  if (line.ReadCompare("$PGCS"))
     return vl_PGCS1(line, info);
   else
     return false;
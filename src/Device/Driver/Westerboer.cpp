@@ -139,16 +139,16 @@ WesterboerDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PWES0"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$PWES0"):
     return PWES0(line, info);
 
-  if (StringIsEqual(type, "$PWES1"))
+  case MakeNMEASentenceKey("$PWES1"):
     return PWES1(line, info);
 
-  return false;
+  default:
+    return false;
+  }
 }
 
 bool
@@ -132,25 +132,25 @@ ZanderDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return false;
 
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
-
-  if (StringIsEqual(type, "$PZAN1"))
+  switch (line.ReadSentenceKey()) {
+  case MakeNMEASentenceKey("$PZAN1"):
     return PZAN1(line, info);
 
-  if (StringIsEqual(type, "$PZAN2"))
+  case MakeNMEASentenceKey("$PZAN2"):
     return PZAN2(line, info);
 
-  if (StringIsEqual(type, "$PZAN3"))
+  case MakeNMEASentenceKey("$PZAN3"):
     return PZAN3(line, info);
 
-  if (StringIsEqual(type, "$PZAN4"))
+  case MakeNMEASentenceKey("$PZAN4"):
     return PZAN4(line, info);
 
-  if (StringIsEqual(type, "$PZAN5"))
+  case MakeNMEASentenceKey("$PZAN5"):
     return PZAN5(line, info);
 
-  return false;
+  default:
+    return false;
+  }
 }
 
 static Device *
@@ -30,7 +30,6 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
-#include "Util/StringUtil.hpp"
 #include "Units/System.hpp"
 #include "OS/Clock.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
@@ -74,58 +73,59 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
 
   NMEAInputLine line(string);
 
-  char type[16];
-  line.Read(type, 16);
+  const Range<const char *> type = line.ReadView();
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
+  if (type.end() - type.begin() == 6 &&
+      IsAlphaASCII(type.begin()[1]) && IsAlphaASCII(type.begin()[2])) {
+    /* standard sentence: ignore the talker id */
+    switch (MakeNMEASentenceKey(type.begin() + 3, type.end())) {
+    case MakeNMEASentenceKey("GSA"):
       return GSA(line, info);
 
-    if (StringIsEqual(type + 3, "GLL"))
+    case MakeNMEASentenceKey("GLL"):
       return GLL(line, info);
 
-    if (StringIsEqual(type + 3, "RMC"))
+    case MakeNMEASentenceKey("RMC"):
       return RMC(line, info);
 
-    if (StringIsEqual(type + 3, "GGA"))
+    case MakeNMEASentenceKey("GGA"):
       return GGA(line, info);
+    }
   }
 
   // if (proprietary sentence) ...
-  if (type[1] == 'P') {
-    // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
-      return PTAS1(line, info);
-
-    // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
-      ParsePFLAE(line, info.flarm.error, info.clock);
-      return true;
-    }
+  if (type.end() - type.begin() < 2 || type.begin()[1] != 'P')
+    return false;
 
-    if (StringIsEqual(type + 1, "PFLAV")) {
-      ParsePFLAV(line, info.flarm.version, info.clock);
-      return true;
-    }
+  switch (MakeNMEASentenceKey(type.begin(), type.end())) {
+  // Airspeed and vario sentence
+  case MakeNMEASentenceKey("$PTAS1"):
+    return PTAS1(line, info);
 
-    if (StringIsEqual(type + 1, "PFLAA")) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
-      return true;
-    }
+  // FLARM sentences
+  case MakeNMEASentenceKey("$PFLAE"):
+    ParsePFLAE(line, info.flarm.error, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAU")) {
-      ParsePFLAU(line, info.flarm.status, info.clock);
-      return true;
-    }
+  case MakeNMEASentenceKey("$PFLAV"):
+    ParsePFLAV(line, info.flarm.version, info.clock);
+    return true;
+
+  case MakeNMEASentenceKey("$PFLAA"):
+    ParsePFLAA(line, info.flarm.traffic, info.clock);
+    return true;
 
-    // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
-      return RMZ(line, info);
+  case MakeNMEASentenceKey("$PFLAU"):
+    ParsePFLAU(line, info.flarm.status, info.clock);
+    return true;
+
+  // Garmin altitude sentence
+  case MakeNMEASentenceKey("$PGRMZ"):
+    return RMZ(line, info);
 
+  default:
     return false;
   }
-
-  return false;
 }
 
 /**
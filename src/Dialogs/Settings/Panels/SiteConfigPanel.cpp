@@ -135,10 +135,12 @@ SiteConfigPanel::Save(bool &_changed, bool &_require_restart)
   AirspaceFileChanged = SaveValueFileReader(AirspaceFile, ProfileKeys::AirspaceFile);
   AirspaceFileChanged |= SaveValueFileReader(AdditionalAirspaceFile, ProfileKeys::AdditionalAirspaceFile);
 
-  AirfieldFileChanged = SaveValueFileReader(AirfieldFile, ProfileKeys::AirfieldFile);
+  /* the airfield details are read on demand, nothing needs to be
+     reloaded; only the profile must be saved */
+  const bool airfield_file_changed =
+    SaveValueFileReader(AirfieldFile, ProfileKeys::AirfieldFile);
 
-
-  changed = WaypointFileChanged || AirfieldFileChanged || MapFileChanged;
+  changed = WaypointFileChanged || airfield_file_changed || MapFileChanged;
 
   _changed |= changed;
   _require_restart |= require_restart;
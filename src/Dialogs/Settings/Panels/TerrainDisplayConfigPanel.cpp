@@ -48,6 +48,7 @@ enum ControlIndex {
   TerrainSlopeShading,
   TerrainContrast,
   TerrainBrightness,
+  TerrainThreads,
   TerrainPreview,
 };
 
@@ -100,6 +101,7 @@ TerrainDisplayConfigPanel::ShowTerrainControls()
   SetRowVisible(TerrainSlopeShading, show);
   SetRowVisible(TerrainContrast, show);
   SetRowVisible(TerrainBrightness, show);
+  SetRowVisible(TerrainThreads, show);
   if (terrain != NULL)
     SetRowVisible(TerrainPreview, show);
 }
@@ -130,6 +132,7 @@ TerrainDisplayConfigPanel::OnModified(DataField &df)
     terrain_settings.brightness =
       PercentToByte(GetValueInteger(TerrainBrightness));
     terrain_settings.ramp = GetValueInteger(TerrainColors);
+    terrain_settings.threads = GetValueInteger(TerrainThreads);
 
     // Invalidate terrain preview
     if (terrain != NULL)
@@ -229,6 +232,21 @@ TerrainDisplayConfigPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
   GetDataField(TerrainBrightness).SetListener(this);
   SetExpertRow(TerrainBrightness);
 
+  static constexpr StaticEnumChoice terrain_threads_list[] = {
+    { 0, N_("Auto"), },
+    { 1, _T("1"), },
+    { 2, _T("2"), },
+    { 4, _T("4"), },
+    { 8, _T("8"), },
+    { 0 }
+  };
+
+  AddEnum(_("Terrain threads"),
+          _("The number of CPU cores used for shading the terrain.  \"Auto\" uses all of them; select 1 on single-core devices."),
+          terrain_threads_list, terrain.threads);
+  GetDataField(TerrainThreads).SetListener(this);
+  SetExpertRow(TerrainThreads);
+
   if (::terrain != NULL) {
     WindowStyle style;
     style.Border();
@@ -255,6 +273,7 @@ TerrainDisplayConfigPanel::Save(bool &_changed, bool &_require_restart)
   Profile::Set(ProfileKeys::TerrainContrast, terrain_settings.contrast);
   Profile::Set(ProfileKeys::TerrainBrightness, terrain_settings.brightness);
   Profile::Set(ProfileKeys::TerrainRamp, terrain_settings.ramp);
+  Profile::Set(ProfileKeys::TerrainThreads, terrain_settings.threads);
   Profile::SetEnum(ProfileKeys::SlopeShadingType, terrain_settings.slope_shading);
 
   changed |= SaveValue(EnableTopography, ProfileKeys::DrawTopography,
@@ -52,6 +52,7 @@ Copyright_License {
 #include "Util/Macros.hpp"
 #include "Language/Language.hpp"
 #include "Waypoint/LastUsed.hpp"
+#include "Waypoint/WaypointDetailsReader.hpp"
 #include "Profile/Profile.hpp"
 #include "Profile/ProfileKeys.hpp"
 
@@ -381,7 +382,11 @@ void
 dlgWaypointDetailsShowModal(SingleWindow &parent, const Waypoint &_waypoint,
                             bool allow_navigation)
 {
-  waypoint = &_waypoint;
+  /* the airfield details are not kept in the waypoint database, look
+     them up now */
+  Waypoint detailed(_waypoint);
+  WaypointDetails::ReadFromProfile(way_points, detailed);
+  waypoint = &detailed;
 
   form = LoadDialog(CallBackTable, parent,
                   Layout::landscape ? _T("IDR_XML_WAYPOINTDETAILS_L") :
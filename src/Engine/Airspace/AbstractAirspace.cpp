@@ -212,7 +212,7 @@ AbstractAirspace::MatchNamePrefix(const TCHAR *prefix) const
 const tstring 
 AbstractAirspace::GetRadioText() const
 {
-  return radio;
+  return radio.ToString();
 }
 
 void
@@ -23,6 +23,7 @@
 #define ABSTRACTAIRSPACE_HPP
 
 #include "Util/tstring.hpp"
+#include "Util/InternedString.hpp"
 #include "AirspaceAltitude.hpp"
 #include "AirspaceClass.hpp"
 #include "AirspaceActivity.hpp"
@@ -71,10 +72,10 @@ protected:
   AirspaceAltitude altitude_top;
 
   /** Airspace name (identifier) */
-  tstring name;
+  InternedString name;
 
   /** Radio frequency (optional) */
-  tstring radio;
+  InternedString radio;
 
   /** Actual border */
   SearchPointVector m_border;
@@ -92,6 +93,10 @@ public:
     return shape;
   }
 
+  bool IsConvex() const {
+    return m_is_convex;
+  }
+
   /** 
    * Compute bounding box enclosing the airspace.  Rounds up/down
    * so discretisation ensures bounding box is indeed enclosing.
@@ -203,7 +208,7 @@ public:
     type = _Type;
     altitude_base = _base;
     altitude_top = _top;
-    radio = _T("");
+    radio.clear();
   }
 
   /**
@@ -224,6 +229,13 @@ public:
     days_of_operation = mask;
   }
 
+  /**
+   * Returns the days of operation set by SetDays().
+   */
+  AirspaceActivity GetDays() const {
+    return days_of_operation;
+  }
+
   /** 
    * Get type of airspace
    * 
@@ -99,6 +99,18 @@ public:
     mask.days.sunday = 1;
   }
 
+  /**
+   * Returns the days as a bit mask (bit 0 is Sunday), for storing
+   * them in a file.
+   */
+  unsigned char GetMask() const {
+    return mask.value;
+  }
+
+  void SetMask(unsigned char value) {
+    mask.value = value;
+  }
+
   bool Matches(AirspaceActivity _mask) const {
     return mask.value & _mask.mask.value;
   }
@@ -0,0 +1,123 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "AirspaceCandidateCache.hpp"
+#include "AbstractAirspace.hpp"
+#include "AirspaceVisitor.hpp"
+#include "AirspaceIntersectionVisitor.hpp"
+#include "Navigation/Aircraft.hpp"
+#include "Geo/Flat/FlatRay.hpp"
+
+const Airspaces::AirspaceVector &
+AirspaceCandidateCache::Cover(const FlatBoundingBox &box)
+{
+  if (valid && serial == airspaces.GetSerial() &&
+      region.IsInside(box.GetLowerLeft()) &&
+      region.IsInside(box.GetUpperRight()))
+    return candidates;
+
+  region = box;
+
+  if (location.IsValid()) {
+    /* twice the range of the queries, leaving a margin of one range
+       for the aircraft to move, see SetRegion() */
+    const TaskProjection &projection = airspaces.GetProjection();
+    region.Merge(FlatBoundingBox(projection.ProjectInteger(location),
+                                 projection.ProjectRangeInteger(location,
+                                                                Double(range))));
+  }
+
+  candidates = airspaces.FindOverlapping(region);
+  serial = airspaces.GetSerial();
+  valid = true;
+  ++n_requeries;
+
+  return candidates;
+}
+
+void
+AirspaceCandidateCache::VisitIntersecting(const GeoPoint &loc,
+                                          const GeoPoint &end,
+                                          AirspaceIntersectionVisitor &visitor)
+{
+  if (airspaces.empty())
+    // nothing to do
+    return;
+
+  const TaskProjection &projection = airspaces.GetProjection();
+
+  const GeoPoint c = loc.Middle(end);
+  FlatBoundingBox box = Airspace(c, projection);
+  box.Grow(projection.ProjectRangeInteger(c, loc.Distance(end) / 2));
+
+  const FlatRay ray(projection.ProjectInteger(loc),
+                    projection.ProjectInteger(end));
+
+  for (const auto &as : Cover(box)) {
+    ++n_examined;
+
+    if (as.Overlaps(box) && as.Intersects(ray) &&
+        visitor.SetIntersections(as.Intersects(loc, end, projection)))
+      visitor.Visit(as);
+  }
+}
+
+void
+AirspaceCandidateCache::VisitInside(const GeoPoint &loc,
+                                    AirspaceVisitor &visitor)
+{
+  if (airspaces.empty())
+    // nothing to do
+    return;
+
+  const FlatBoundingBox box = Airspace(loc, airspaces.GetProjection());
+
+  for (const auto &as : Cover(box)) {
+    ++n_examined;
+
+    if (as.Overlaps(box) && as.IsInside(loc))
+      visitor.Visit(as);
+  }
+}
+
+const Airspaces::AirspaceVector
+AirspaceCandidateCache::FindInside(const AircraftState &state,
+                                   const AirspacePredicate &condition)
+{
+  Airspaces::AirspaceVector result;
+
+  if (airspaces.empty())
+    return result;
+
+  const FlatBoundingBox box = Airspace(state.location,
+                                       airspaces.GetProjection());
+
+  for (const auto &as : Cover(box)) {
+    ++n_examined;
+
+    if (as.Overlaps(box) && condition(*as.GetAirspace()) &&
+        as.IsInside(state))
+      result.push_back(as);
+  }
+
+  return result;
+}
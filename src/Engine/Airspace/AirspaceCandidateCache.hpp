@@ -0,0 +1,149 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef AIRSPACE_CANDIDATE_CACHE_HPP
+#define AIRSPACE_CANDIDATE_CACHE_HPP
+
+#include "Airspaces.hpp"
+
+class AirspaceVisitor;
+class AirspaceIntersectionVisitor;
+
+/**
+ * A cache of the airspaces in a region around the aircraft, for
+ * clients which query #Airspaces repeatedly with slowly moving
+ * locations (like #AirspaceWarningManager).
+ *
+ * The queries have the same semantics as the corresponding
+ * #Airspaces methods.  They are answered from the cached airspaces
+ * as long as the query region lies within the cached region and
+ * #Airspaces has not changed; otherwise the cache is filled again
+ * with the airspaces around the current location, plus a margin
+ * which allows the aircraft to move on before the next re-query.
+ */
+class AirspaceCandidateCache {
+  const Airspaces &airspaces;
+
+  /**
+   * The airspaces whose bounding box overlaps #region.
+   */
+  Airspaces::AirspaceVector candidates;
+
+  /**
+   * The region covered by #candidates, in the flat projection of
+   * #airspaces.
+   */
+  FlatBoundingBox region;
+
+  /**
+   * The Airspaces::GetSerial() value #candidates was filled with.
+   */
+  unsigned serial;
+
+  bool valid;
+
+  /**
+   * The centre of the region queried by the next re-query.
+   */
+  GeoPoint location;
+
+  /**
+   * The distance from #location reached by the queries of one
+   * update [m].
+   */
+  fixed range;
+
+  /**
+   * The number of candidates examined by queries since construction.
+   */
+  unsigned long n_examined;
+
+  /**
+   * The number of re-queries of #airspaces since construction.
+   */
+  unsigned n_requeries;
+
+public:
+  explicit AirspaceCandidateCache(const Airspaces &_airspaces)
+    :airspaces(_airspaces), valid(false),
+     location(GeoPoint::Invalid()), range(fixed(0)),
+     n_examined(0), n_requeries(0) {}
+
+  /**
+   * Discard the cached airspaces.
+   */
+  void Clear() {
+    valid = false;
+    candidates.clear();
+  }
+
+  /**
+   * Set the region which will be cached by the next re-query.  Call
+   * this before the queries of each update.  The cached region
+   * extends twice the given range from the location in each
+   * direction; the queries of one update reach only one range, so
+   * the aircraft can move by about one range before they leave the
+   * cached region.
+   *
+   * @param location the current location of the aircraft
+   * @param range the distance from the location reached by the
+   * queries of one update [m]
+   */
+  void SetRegion(const GeoPoint &_location, fixed _range) {
+    location = _location;
+    range = _range;
+  }
+
+  /**
+   * @see Airspaces::VisitIntersecting()
+   */
+  void VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
+                         AirspaceIntersectionVisitor &visitor);
+
+  /**
+   * @see Airspaces::VisitInside()
+   */
+  void VisitInside(const GeoPoint &loc, AirspaceVisitor &visitor);
+
+  /**
+   * @see Airspaces::FindInside()
+   */
+  const Airspaces::AirspaceVector FindInside(const AircraftState &state,
+                                             const AirspacePredicate &condition);
+
+  unsigned long GetExaminedCount() const {
+    return n_examined;
+  }
+
+  unsigned GetRequeryCount() const {
+    return n_requeries;
+  }
+
+private:
+  /**
+   * Make sure that all airspaces overlapping the given box are in
+   * #candidates.
+   */
+  const Airspaces::AirspaceVector &Cover(const FlatBoundingBox &box);
+};
+
+#endif
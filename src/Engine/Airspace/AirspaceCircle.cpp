@@ -44,6 +44,14 @@ AirspaceCircle::AirspaceCircle(const GeoPoint &loc, const fixed _radius)
   }
 }
 
+AirspaceCircle::AirspaceCircle(const GeoPoint &loc, const fixed _radius,
+                               SearchPointVector &&border)
+  :AbstractAirspace(Shape::CIRCLE), m_center(loc), m_radius(_radius)
+{
+  m_is_convex = true;
+  m_border = std::move(border);
+}
+
 bool 
 AirspaceCircle::Inside(const GeoPoint &loc) const
 {
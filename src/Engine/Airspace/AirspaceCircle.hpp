@@ -48,6 +48,17 @@ public:
    */
   AirspaceCircle(const GeoPoint &loc, const fixed _radius);
 
+  /**
+   * Constructor for a circle whose border has been calculated before
+   * (e.g. one loaded from a compiled airspace file).  This skips the
+   * geodesic calculation of the border points.
+   *
+   * @param border the border which was calculated by the other
+   * constructor
+   */
+  AirspaceCircle(const GeoPoint &loc, const fixed _radius,
+                 SearchPointVector &&border);
+
   /**
    * Get arbitrary center or reference point for use in determining
    * overall center location of all airspaces
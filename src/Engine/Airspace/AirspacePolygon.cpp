@@ -25,6 +25,7 @@
 #include "Geo/Flat/FlatRay.hpp"
 #include "AirspaceIntersectSort.hpp"
 #include "AirspaceIntersectionVector.hpp"
+#include "Geo/ConvexHull/PolygonInterior.hpp"
 
 #include <assert.h>
 
@@ -55,6 +56,44 @@ AirspacePolygon::AirspacePolygon(const std::vector<GeoPoint> &pts,
       m_is_convex = m_border.IsConvex();
     }
   }
+
+  BuildInsideIndex();
+}
+
+AirspacePolygon::AirspacePolygon(SearchPointVector &&border,
+                                 const bool is_convex)
+  :AbstractAirspace(Shape::POLYGON)
+{
+  m_border = std::move(border);
+  m_is_convex = is_convex;
+
+  BuildInsideIndex();
+}
+
+void
+AirspacePolygon::BuildInsideIndex()
+{
+  if (m_border.size() < MIN_INDEXED_POINTS)
+    return;
+
+  std::vector<fixed> latitudes;
+  latitudes.reserve(m_border.size());
+  for (const SearchPoint &p : m_border)
+    latitudes.push_back(p.GetLocation().latitude.Native());
+  inside_index.Build(latitudes);
+}
+
+void
+AirspacePolygon::BuildIntersectIndex()
+{
+  if (m_border.size() < MIN_INDEXED_POINTS)
+    return;
+
+  std::vector<fixed> latitudes;
+  latitudes.reserve(m_border.size());
+  for (const SearchPoint &p : m_border)
+    latitudes.push_back(fixed(p.GetFlatLocation().latitude));
+  intersect_index.Build(latitudes);
 }
 
 const GeoPoint 
@@ -69,7 +108,14 @@ AirspacePolygon::GetCenter() const
 bool 
 AirspacePolygon::Inside(const GeoPoint &loc) const
 {
-  return m_border.IsInside(loc);
+  if (!inside_index.IsDefined())
+    return m_border.IsInside(loc);
+
+  /* only edges crossing the latitude of the location contribute to
+     the winding number */
+  const auto edges = inside_index.Find(loc.latitude.Native());
+  return PolygonInterior(loc, &*m_border.begin(), &*m_border.end(),
+                         edges.first, edges.second);
 }
 
 AirspaceIntersectionVector
@@ -81,14 +127,31 @@ AirspacePolygon::Intersects(const GeoPoint &start, const GeoPoint &end,
 
   AirspaceIntersectSort sorter(start, *this);
 
-  for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it) {
-
+  const auto check_edge = [&](SearchPointVector::const_iterator it) {
     const FlatRay r_seg(it->GetFlatLocation(), (it + 1)->GetFlatLocation());
     fixed t = ray.DistinctIntersection(r_seg);
     if (!negative(t))
       sorter.add(t, projection.Unproject(ray.Parametric(t)));
+  };
+
+  if (!intersect_index.IsDefined()) {
+    for (auto it = m_border.begin(); it + 1 != m_border.end(); ++it)
+      check_edge(it);
+
+    return sorter.all();
   }
 
+  /* an edge can only intersect the ray if their latitude ranges
+     overlap; the edges are checked in the same order as above, so
+     the sorter sees the same sequence of intersections */
+  const FlatGeoPoint ray_end = ray.point + ray.vector;
+  std::vector<unsigned> edges;
+  intersect_index.Find(fixed(std::min(ray.point.latitude, ray_end.latitude)),
+                       fixed(std::max(ray.point.latitude, ray_end.latitude)),
+                       edges);
+  for (unsigned i : edges)
+    check_edge(m_border.begin() + i);
+
   return sorter.all();
 }
 
@@ -100,3 +163,10 @@ AirspacePolygon::ClosestPoint(const GeoPoint &loc,
   const FlatGeoPoint pb = m_border.NearestPoint(p);
   return projection.Unproject(pb);
 }
+
+void
+AirspacePolygon::Project(const TaskProjection &tp)
+{
+  AbstractAirspace::Project(tp);
+  BuildIntersectIndex();
+}
@@ -24,6 +24,7 @@
 #define AIRSPACEPOLYGON_HPP
 
 #include "AbstractAirspace.hpp"
+#include "Geo/EdgeStripIndex.hpp"
 #include <vector>
 
 #ifdef DO_PRINT
@@ -34,6 +35,24 @@
 class AirspacePolygon: 
   public AbstractAirspace 
 {
+  /**
+   * Borders with fewer points are not indexed; walking all edges is
+   * cheap enough.
+   */
+  static constexpr unsigned MIN_INDEXED_POINTS = 32;
+
+  /**
+   * Index of the border edges by latitude for Inside().  It is built
+   * by the constructor.
+   */
+  EdgeStripIndex inside_index;
+
+  /**
+   * Index of the border edges by projected latitude for
+   * Intersects().  It is rebuilt by Project().
+   */
+  EdgeStripIndex intersect_index;
+
 public:
   /** 
    * Constructor.  For testing, pts vector is a cloud of points,
@@ -46,6 +65,16 @@ public:
    */
   AirspacePolygon(const std::vector<GeoPoint> &pts, const bool prune = false);
 
+  /**
+   * Constructor for a border which has been checked before (e.g. one
+   * loaded from a compiled airspace file).  This skips the convexity
+   * check, which is expensive for large polygons.
+   *
+   * @param border the closed border
+   * @param is_convex the result of a previous IsConvex() call
+   */
+  AirspacePolygon(SearchPointVector &&border, const bool is_convex);
+
   /**
    * Get arbitrary center or reference point for use in determining
    * overall center location of all airspaces
@@ -79,6 +108,12 @@ public:
   virtual GeoPoint ClosestPoint(const GeoPoint &loc,
                                 const TaskProjection &projection) const;
 
+  virtual void Project(const TaskProjection &tp) override;
+
+private:
+  void BuildInsideIndex();
+  void BuildIntersectIndex();
+
 public:
 #ifdef DO_PRINT
   friend std::ostream& operator<< (std::ostream& f, 
@@ -33,7 +33,7 @@
 #define CRUISE_FILTER_FACT fixed(0.5)
 
 AirspaceWarningManager::AirspaceWarningManager(const Airspaces &_airspaces)
-  :airspaces(_airspaces)
+  :airspaces(_airspaces), candidates(_airspaces), n_updates(0)
 {
   /* force filter initialisation in the first SetConfig() call */
   config.warning_time = -1;
@@ -63,6 +63,7 @@ void
 AirspaceWarningManager::Reset(const AircraftState &state)
 {
   warnings.clear();
+  candidates.Clear();
   cruise_filter.Reset(state);
   circling_filter.Reset(state);
 }
@@ -121,6 +122,18 @@ AirspaceWarningManager::Update(const AircraftState& state,
     return false;
   }
 
+  ++n_updates;
+
+  // the predicted locations are no further away than this; the task
+  // prediction is limited to the configured warning time at VMax
+  const fixed speed = glide_polar.IsValid()
+    ? std::max(state.ground_speed, glide_polar.GetVMax())
+    : state.ground_speed;
+  const fixed time = std::max(std::max(prediction_time_glide,
+                                       prediction_time_filter),
+                              fixed(config.warning_time));
+  candidates.SetRegion(state.location, speed * time);
+
   // save old state
   for (auto &w : warnings)
     w.SaveState();
@@ -287,10 +300,10 @@ AirspaceWarningManager::UpdatePredicted(const AircraftState& state,
                                              warning_state, max_time_limit,
                                              ceiling);
 
-  airspaces.VisitIntersecting(state.location, location_predicted, visitor);
+  candidates.VisitIntersecting(state.location, location_predicted, visitor);
 
   visitor.SetMode(true);
-  airspaces.VisitInside(state.location, visitor);
+  candidates.VisitInside(state.location, visitor);
 
   return visitor.Found();
 }
@@ -381,7 +394,7 @@ AirspaceWarningManager::UpdateInside(const AircraftState& state,
 
   AirspacePredicateAircraftInside condition(state);
 
-  Airspaces::AirspaceVector results = airspaces.FindInside(state, condition);
+  Airspaces::AirspaceVector results = candidates.FindInside(state, condition);
   for (const auto &i : results) {
     const AbstractAirspace& airspace = *i.GetAirspace();
 
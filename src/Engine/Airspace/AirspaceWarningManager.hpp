@@ -25,6 +25,7 @@
 #include "Util/NonCopyable.hpp"
 #include "AirspaceWarning.hpp"
 #include "AirspaceWarningConfig.hpp"
+#include "AirspaceCandidateCache.hpp"
 #include "Util/AircraftStateFilter.hpp"
 #include "Compiler.h"
 
@@ -54,6 +55,18 @@ class AirspaceWarningManager:
 
   const Airspaces &airspaces;
 
+  /**
+   * The airspaces near the aircraft, which are checked by the
+   * predictions and interior search.
+   */
+  AirspaceCandidateCache candidates;
+
+  /**
+   * The number of Update() calls with a non-empty airspace
+   * database.
+   */
+  unsigned n_updates;
+
   fixed prediction_time_glide;
   fixed prediction_time_filter;
 
@@ -108,6 +121,30 @@ public:
               const TaskStats &task_stats,
               const bool circling, const unsigned dt);
 
+  /**
+   * Returns the number of updates since construction.
+   */
+  unsigned GetUpdateCount() const {
+    return n_updates;
+  }
+
+  /**
+   * Returns the number of times the airspace database was queried
+   * for airspaces near the aircraft since construction.  Updates
+   * which don't need a query use the airspaces found earlier.
+   */
+  unsigned GetRequeryCount() const {
+    return candidates.GetRequeryCount();
+  }
+
+  /**
+   * Returns the number of airspaces examined by all updates since
+   * construction.
+   */
+  unsigned long GetExaminedCount() const {
+    return candidates.GetExaminedCount();
+  }
+
   /**
    * Adjust time of glide predictor
    *
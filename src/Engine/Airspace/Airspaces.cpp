@@ -62,7 +62,7 @@ Airspaces::VisitWithinRange(const GeoPoint &location, fixed range,
   Airspace bb_target(location, task_projection);
   int projected_range = task_projection.ProjectRangeInteger(location, range);
   AirspacePredicateVisitorAdapter adapter(predicate, visitor);
-  airspace_tree.visit_within_range(bb_target, -projected_range, adapter);
+  airspace_tree.visit_within_range(bb_target, projected_range, adapter);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -103,7 +103,7 @@ Airspaces::VisitIntersecting(const GeoPoint &loc, const GeoPoint &end,
   Airspace bb_target(c, task_projection);
   int projected_range = task_projection.ProjectRangeInteger(c, loc.Distance(end) / 2);
   IntersectingAirspaceVisitorAdapter adapter(loc, end, task_projection, visitor);
-  airspace_tree.visit_within_range(bb_target, -projected_range, adapter);
+  airspace_tree.visit_within_range(bb_target, projected_range, adapter);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -134,9 +134,8 @@ Airspaces::FindNearest(const GeoPoint &location,
   const int projected_range =
     task_projection.ProjectRangeInteger(location, fixed(30000));
   const AirspacePredicateAdapter predicate(condition);
-  std::pair<AirspaceTree::const_iterator, AirspaceTree::distance_type> found =
-    airspace_tree.find_nearest_if(bb_target, BBDist(0, projected_range),
-                                  predicate);
+  const auto found =
+    airspace_tree.find_nearest_if(bb_target, projected_range, predicate);
 
   return found.first != airspace_tree.end() ? &*found.first : NULL;
 }
@@ -153,7 +152,7 @@ Airspaces::ScanRange(const GeoPoint &location, fixed range,
   int projected_range = task_projection.ProjectRangeInteger(location, range);
   
   std::deque< Airspace > vectors;
-  airspace_tree.find_within_range(bb_target, -projected_range,
+  airspace_tree.find_within_range(bb_target, projected_range,
                                   std::back_inserter(vectors));
 
 #ifdef INSTRUMENT_TASK
@@ -204,6 +203,19 @@ Airspaces::FindInside(const AircraftState &state,
   return vectors;
 }
 
+const Airspaces::AirspaceVector
+Airspaces::FindOverlapping(const FlatBoundingBox &box) const
+{
+  AirspaceVector vectors;
+  airspace_tree.find_within_range(box, 0, std::back_inserter(vectors));
+
+#ifdef INSTRUMENT_TASK
+  n_queries++;
+#endif
+
+  return vectors;
+}
+
 void 
 Airspaces::Optimise()
 {
@@ -217,6 +229,7 @@ Airspaces::Optimise()
       tmp_as.push_back(i.GetAirspace());
 
     airspace_tree.clear();
+    ++serial;
   }
 
   if (!tmp_as.empty()) {
@@ -226,6 +239,7 @@ Airspaces::Optimise()
       tmp_as.pop_front();
     }
     airspace_tree.optimise();
+    ++serial;
   }
 }
 
@@ -276,6 +290,7 @@ Airspaces::clear()
 
   // then delete the tree
   airspace_tree.clear();
+  ++serial;
 }
 
 unsigned
@@ -321,6 +336,7 @@ Airspaces::Airspaces(const Airspaces& master, bool _owns_children):
   qnh(master.qnh),
   activity_mask(master.activity_mask),
   owns_children(_owns_children),
+  serial(0),
   task_projection(master.task_projection)
 {
 }
@@ -374,10 +390,7 @@ Airspaces::SynchroniseInRange(const Airspaces& master,
     gcc_unused bool found = false;
     for (auto t = airspace_tree.begin(); t != airspace_tree.end(); ) {
       if (t->GetAirspace() == v->GetAirspace()) {
-        AirspaceTree::const_iterator new_t = t;
-        ++new_t;
-        airspace_tree.erase_exact(*t);
-        t = new_t;
+        t = airspace_tree.erase(t);
         found = true;
       } else {
         ++t;
@@ -388,8 +401,10 @@ Airspaces::SynchroniseInRange(const Airspaces& master,
     v = contents_self.erase(v);
     changed = true;
   }
-  if (changed)
+  if (changed) {
+    ++serial;
     Optimise();
+  }
   return changed;
 }
 
@@ -37,21 +37,24 @@ class AirspaceVisitor;
 class AirspaceIntersectionVisitor;
 
 /**
- * Container for airspaces using kd-tree representation internally for fast 
- * geospatial lookups.
+ * Container for airspaces using a bulk-loaded R-tree representation
+ * internally for fast geospatial lookups.
+ *
+ * Complexity analysis (with R-tree):
  *
- * Complexity analysis (with kdtree):
- *   
  *    Find within range (k points found):
- *     O(n^(3/4) + k)
+ *     O(log(n) + k) typically
  *
  *    Find intersecting:
- *     O(n^(3/4) + k)
+ *     O(log(n) + k) typically
  *
  *    Find nearest:
- *     O(log(n))
+ *     O(log(n)) typically
+ *
+ *    Optimise:
+ *     O(n log(n))
  *
- *  Without kd-tree:
+ *  Without R-tree:
  *
  *    Find within range:
  *     O(n)
@@ -70,6 +73,12 @@ class Airspaces:
 
   bool owns_children;
 
+  /**
+   * Incremented whenever the contents of #airspace_tree or the
+   * projection change.
+   */
+  unsigned serial;
+
   AirspaceTree airspace_tree;
   TaskProjection task_projection;
 
@@ -85,7 +94,8 @@ public:
    *
    * @return empty Airspaces class.
    */
-  Airspaces():qnh(AtmosphericPressure::Zero()), owns_children(true) {}
+  Airspaces()
+    :qnh(AtmosphericPressure::Zero()), owns_children(true), serial(0) {}
 
   /**
    * Make a copy of the airspaces metadata
@@ -119,6 +129,15 @@ public:
    */
   void clear();
 
+  /**
+   * Returns a number which changes whenever airspaces are added to
+   * or removed from the tree, or the projection changes.  Results of
+   * earlier queries may be reused as long as it stays the same.
+   */
+  unsigned GetSerial() const {
+    return serial;
+  }
+
   /**
    * Size of airspace (in tree, not in temporary store) ---
    * must call optimise() before this for it to be accurate.
@@ -226,6 +245,16 @@ public:
                                   const AirspacePredicate &condition =
                                         AirspacePredicate::always_true) const;
 
+  /**
+   * Find all airspaces whose bounding box overlaps the given box.
+   *
+   * @param box a box in the flat projection returned by
+   * GetProjection()
+   *
+   * @return Vector of airspaces overlapping the box
+   */
+  const AirspaceVector FindOverlapping(const FlatBoundingBox &box) const;
+
   /**
    * Access first airspace in store, for use in iterators.
    *
@@ -25,6 +25,7 @@
 #include "Util/SliceAllocator.hpp"
 #include "Airspace.hpp"
 #include "Geo/Flat/BoundingBoxDistance.hpp"
+#include "Geo/Flat/FlatRTree.hpp"
 
 #include <kdtree++/kdtree.hpp>
 
@@ -91,14 +92,21 @@ public:
   typedef std::vector<Airspace> AirspaceVector; /**< Vector of airspaces (used internally) */
 
   /**
-   * Type of KD-tree data structure for airspace container
+   * Type of KD-tree data structure for airspace container.  This was
+   * the airspace container before #AirspaceTree replaced it, and is
+   * kept for comparison.
    */
   typedef KDTree::KDTree<4, 
                          Airspace, 
                          kd_get_bounds, kd_distance,
                          std::less<kd_get_bounds::result_type>,
                          SliceAllocator<KDTree::_Node<Airspace>, 256>
-                         > AirspaceTree;
+                         > AirspaceKDTree;
+
+  /**
+   * Type of the bulk-loaded R-tree used as airspace container
+   */
+  typedef FlatRTree<Airspace> AirspaceTree;
 };
 
 #endif
@@ -48,13 +48,10 @@ void
 ContestManager::SetIncremental(bool incremental)
 {
   olc_sprint.SetIncremental(incremental);
-  olc_fai.SetIncremental(incremental);
   olc_classic.SetIncremental(incremental);
   dmst_quad.SetIncremental(incremental);
   xcontest_free.SetIncremental(incremental);
-  xcontest_triangle.SetIncremental(incremental);
   dhv_xc_free.SetIncremental(incremental);
-  dhv_xc_triangle.SetIncremental(incremental);
   sis_at.SetIncremental(incremental);
   net_coupe.SetIncremental(incremental);
 }
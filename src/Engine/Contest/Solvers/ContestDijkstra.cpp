@@ -42,7 +42,8 @@ ContestDijkstra::ContestDijkstra(const Trace &_trace,
    trace_master(_trace),
    continuous(_continuous),
    incremental(false),
-   predicted(TracePoint::Invalid())
+   predicted(TracePoint::Invalid()),
+   predicted_index(_trace.GetMaxSize())
 {
   assert(num_stages <= MAX_STAGES);
 
@@ -96,7 +96,11 @@ private:
 
   TracePoint predicted;
 
-  static const unsigned predicted_index = 0xffff;
+  /**
+   * The point index of the #predicted point.  It is just beyond the
+   * maximum trace size, to keep the Dijkstra edge table small.
+   */
+  const unsigned predicted_index;
 
 protected:
   /** Number of points in current trace set */
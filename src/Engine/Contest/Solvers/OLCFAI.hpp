@@ -33,7 +33,7 @@ public:
   OLCFAI(const Trace &_trace, bool predict);
 
 protected:
-  /* virtual methods from class ContestDijkstra */
+  /* virtual methods from class OLCTriangle */
   virtual ContestResult CalculateResult(const ContestTraceVector &solution) const override;
 };
 
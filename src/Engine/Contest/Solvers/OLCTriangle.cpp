@@ -23,10 +23,14 @@
 #include "OLCTriangle.hpp"
 #include "Cast.hpp"
 #include "Trace/Trace.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "Math/FastMath.h"
 
-/*
- @todo potential to use 3d convex hull to speed search
+#include <algorithm>
+
+#include <limits.h>
 
+/*
  2nd point inclusion rules:
    if min leg length is 25%, max is 45%
    pmin = 0.25
@@ -56,22 +60,21 @@ static constexpr fixed max_distance(5000);
 
 OLCTriangle::OLCTriangle(const Trace &_trace,
                          const bool _is_fai, bool _predict)
-  :ContestDijkstra(_trace, false, 3, 1000),
+  :AbstractContest(1000),
+   trace_master(_trace),
    is_fai(_is_fai), predict(_predict),
-   is_closed(false),
-   is_complete(false),
-   first_tp(0)
+   searching(false),
+   best_distance(0),
+   n_points(0)
 {
 }
 
 void
 OLCTriangle::Reset()
 {
-  ContestDijkstra::Reset();
-  is_complete = false;
-  is_closed = false;
-  first_tp = 0;
-  best_d = 0;
+  AbstractContest::Reset();
+  ClearTrace();
+  solution.clear();
 }
 
 gcc_pure
@@ -82,39 +85,27 @@ CalcLegDistance(const ContestTraceVector &solution, const unsigned index)
   // leg 1: 2-3
   // leg 2: 3-1
 
-  const GeoPoint &p_start = solution[index].GetLocation();
-  const GeoPoint &p_dest = solution[index < 2 ? index + 1 : 0].GetLocation();
+  const GeoPoint &p_start = solution[1 + index].GetLocation();
+  const GeoPoint &p_dest = solution[index < 2 ? index + 2 : 1].GetLocation();
 
   return p_start.Distance(p_dest);
 }
 
-bool
-OLCTriangle::IsPathClosed() const
+/**
+ * Calculate the maximum flat distance between two points in the
+ * given boxes.
+ */
+gcc_pure
+static unsigned
+MaxDistance(const FlatBoundingBox &a, const FlatBoundingBox &b)
 {
-
-  // RESERVED FOR FUTURE USE: DO NOT DELETE
-
-  // note this may fail if resolution of sampled trace is too low
-  assert(n_points > 0);
-
-  const GeoPoint end_location = GetPoint(n_points - 1).GetLocation();
-
-  fixed d_min(-1);
-
-  assert(first_tp < n_points);
-
-  for (unsigned start_index = 0; start_index <= first_tp; ++start_index) {
-    const fixed d_this =
-      GetPoint(start_index).GetLocation().Distance(end_location);
-
-    if (!positive(d_min) || d_this < d_min)
-      d_min = d_this;
-
-    if (d_this <= max_distance)
-      return true;
-  }
-
-  return false;
+  const int dx =
+    std::max(a.GetUpperRight().longitude - b.GetLowerLeft().longitude,
+             b.GetUpperRight().longitude - a.GetLowerLeft().longitude);
+  const int dy =
+    std::max(a.GetUpperRight().latitude - b.GetLowerLeft().latitude,
+             b.GetUpperRight().latitude - a.GetLowerLeft().latitude);
+  return ihypot(dx, dy);
 }
 
 class TriangleSecondLeg {
@@ -206,114 +197,375 @@ TriangleSecondLeg::Calculate(const SearchPoint &c, unsigned best) const
   return Result(0, 0);
 }
 
-
 void
-OLCTriangle::AddStartEdges()
+OLCTriangle::ClearTrace()
 {
-  // use last point as single start,
-  // this is out of order but required
+  append_serial = Serial();
+  trace.clear();
+  n_points = 0;
+  queue.clear();
+  overflow.clear();
+  searching = false;
+}
 
-  ScanTaskPoint destination(0, n_points - 1);
-  LinkStart(destination);
+void
+OLCTriangle::UpdateTrace()
+{
+  trace_master.GetPoints(trace);
+  n_points = trace.size();
+  append_serial = trace_master.GetAppendSerial();
 }
 
 void
-OLCTriangle::AddTurn1Edges(const ScanTaskPoint origin)
+OLCTriangle::BuildTree()
 {
-  // add points up to finish
+  n_leaves = 1;
+  while (n_leaves < n_points)
+    n_leaves <<= 1;
+
+  tree.resize(2 * n_leaves);
 
-  const ScanTaskPoint begin(origin.GetStageNumber() + 1, 0);
-  const ScanTaskPoint end(origin.GetStageNumber() + 1, origin.GetPointIndex());
+  for (unsigned i = 0; i < n_leaves; ++i) {
+    TreeNode &node = tree[n_leaves + i];
+    if (i < n_points) {
+      node.box = FlatBoundingBox(GetPoint(i).GetFlatLocation());
+      node.first = node.last = i;
+    } else {
+      node.first = 1;
+      node.last = 0;
+    }
+  }
 
-  for (ScanTaskPoint i = begin; i != end; i.IncrementPointIndex()) {
-    const unsigned d = CalcEdgeDistance(origin, i);
+  for (unsigned i = n_leaves - 1; i > 0; --i) {
+    const TreeNode &right = tree[2 * i + 1];
+    TreeNode &node = tree[i];
 
-    if (!is_fai || 4 * d >= best_d)
-      /* no reason to add candidate if worse than 25% rule for FAI
-         tasks */
-      Link(i, origin, GetStageWeight(origin.GetStageNumber()) * d);
+    node = tree[2 * i];
+    if (!right.IsEmpty()) {
+      node.box.Merge(right.box);
+      node.last = right.last;
+    }
   }
 }
 
+unsigned
+OLCTriangle::GetClosingRange(unsigned start) const
+{
+  return trace_master.ProjectRange(GetPoint(start).GetLocation(),
+                                   max_distance);
+}
+
+bool
+OLCTriangle::IsClosed(unsigned start, unsigned range, unsigned finish) const
+{
+  const TracePoint &start_point = GetPoint(start);
+  const TracePoint &finish_point = GetPoint(finish);
+
+  return start_point.FlatDistanceTo(finish_point) <= range &&
+    start_point.GetLocation().Distance(finish_point.GetLocation()) < max_distance;
+}
+
+unsigned
+OLCTriangle::FindLastClosing(unsigned start, unsigned range,
+                             unsigned after, unsigned node_index) const
+{
+  const TreeNode &node = tree[node_index];
+  if (node.IsEmpty() || node.last <= after ||
+      node.box.Distance(FlatBoundingBox(GetPoint(start).GetFlatLocation())) > range)
+    return after;
+
+  if (node_index >= n_leaves)
+    return IsClosed(start, range, node.first)
+      ? node.first
+      : after;
+
+  // look at the later points first
+  const unsigned result =
+    FindLastClosing(start, range, after, 2 * node_index + 1);
+  if (result > after)
+    return result;
+
+  return FindLastClosing(start, range, after, 2 * node_index);
+}
+
 void
-OLCTriangle::AddTurn2Edges(const ScanTaskPoint origin)
+OLCTriangle::StartSearch()
+{
+  queue.clear();
+  overflow.clear();
+  best_distance = 0;
+  searching = false;
+
+  if (n_points < 3)
+    return;
+
+  BuildTree();
+
+  if (is_fai) {
+    /* determine the flat distance below which a triangle is surely
+       shorter than 500 km, allowing for the distortion of the
+       projection within the trace and for rounding */
+    const TaskProjection &projection = trace_master.GetProjection();
+
+    fixed max_cos(0);
+    for (const TracePoint &point : trace)
+      max_cos = std::max(max_cos, point.GetLocation().latitude.fastcosine());
+
+    const fixed max_scale = projection.GetApproximateScale() *
+      std::max(fixed(1), max_cos / projection.GetCenter().latitude.fastcosine());
+    fai_limit = uround(fixed(500000) / (max_scale * fixed(1.05)));
+  }
+
+  if (!predict) {
+    closing.resize(n_points);
+
+    unsigned last = 0;
+    for (unsigned i = 0; i < n_points; ++i) {
+      if (last < n_points - 1)
+        last = FindLastClosing(i, GetClosingRange(i), std::max(i, last), 1);
+      closing[i] = last;
+    }
+  }
+
+  queue.reserve(QUEUE_SIZE);
+
+  Candidate root;
+  std::fill_n(root.tp, 3, 1);
+  root.bound = CalculateBound(root);
+  if (root.bound > 0) {
+    queue.push_back(root);
+    searching = true;
+  }
+}
+
+unsigned
+OLCTriangle::CalculateBound(const Candidate &c) const
 {
-  ScanTaskPoint previous = dijkstra.GetPredecessor(origin);
+  const TreeNode &tp1 = tree[c.tp[0]];
+  const TreeNode &tp2 = tree[c.tp[1]];
+  const TreeNode &tp3 = tree[c.tp[2]];
+
+  // the turn points must be in order
+
+  const unsigned first2 = std::max(tp2.first, tp1.first + 1);
+  if (first2 > tp2.last)
+    return 0;
+
+  const unsigned first3 = std::max(tp3.first, first2 + 1);
+  if (first3 > tp3.last)
+    return 0;
 
-  // give first leg points to penultimate node
-  TriangleSecondLeg sl(is_fai, GetPoint(previous), GetPoint(origin));
+  // there must be a finish point close to a start point
 
-  const ScanTaskPoint begin(origin.GetStageNumber() + 1,
-                            origin.GetPointIndex() + 1);
-  const ScanTaskPoint end(origin.GetStageNumber() + 1, n_points - 1);
+  if (!predict && closing[std::min(tp1.last, tp2.last - 1)] < first3)
+    return 0;
 
-  for (ScanTaskPoint i = begin; i != end; i.IncrementPointIndex()) {
-    TriangleSecondLeg::Result result = sl.Calculate(GetPoint(i), best_d);
-    const unsigned d = result.leg_distance;
-    if (d > 0) {
-      best_d = result.total_distance;
+  const unsigned max_1 = MaxDistance(tp1.box, tp2.box);
+  const unsigned max_2 = MaxDistance(tp2.box, tp3.box);
+  const unsigned max_3 = MaxDistance(tp3.box, tp1.box);
 
-      Link(i, origin, GetStageWeight(origin.GetStageNumber()) * d);
+  unsigned bound = max_1 + max_2 + max_3;
 
-      // we have an improved solution
-      is_complete = true;
+  if (is_fai) {
+    const unsigned min_1 = tp1.box.Distance(tp2.box);
+    const unsigned min_2 = tp2.box.Distance(tp3.box);
+    const unsigned min_3 = tp3.box.Distance(tp1.box);
 
-      // need to scan again whether path is closed
-      is_closed = false;
-      first_tp = origin.GetPointIndex();
+    // each leg must be able to reach 25% of the total
+
+    if (3 * max_1 < min_2 + min_3 ||
+        3 * max_2 < min_3 + min_1 ||
+        3 * max_3 < min_1 + min_2)
+      return 0;
+
+    // no leg may be longer than 45% of the total
+
+    if (11 * min_1 > 9 * (max_2 + max_3) ||
+        11 * min_2 > 9 * (max_3 + max_1) ||
+        11 * min_3 > 9 * (max_1 + max_2))
+      return 0;
+
+    const unsigned max_shortest = std::min({max_1, max_2, max_3});
+    bound = std::min(bound, 4 * max_shortest);
+
+    if (bound < fai_limit) {
+      // below 500 km, each leg must be able to reach 28% of the total
+
+      if (18 * max_1 < 7 * (min_2 + min_3) ||
+          18 * max_2 < 7 * (min_3 + min_1) ||
+          18 * max_3 < 7 * (min_1 + min_2))
+        return 0;
+
+      bound = std::min(bound, max_shortest * 25 / 7);
     }
   }
+
+  return bound;
 }
 
 void
-OLCTriangle::AddFinishEdges(const ScanTaskPoint origin)
+OLCTriangle::Evaluate(const Candidate &c)
 {
-  assert(IsFinal(origin.GetStageNumber() + 1));
-
-  if (predict) {
-    // dummy just to close the triangle
-    Link(ScanTaskPoint(origin.GetStageNumber() + 1, n_points - 1), origin, 0);
-  } else {
-    const ScanTaskPoint start = FindStart(origin);
-    const TracePoint &start_point = GetPoint(start);
-    const TracePoint &origin_point = GetPoint(origin);
-
-    const unsigned max_range =
-      trace_master.ProjectRange(origin_point.GetLocation(), max_distance);
-
-    /* check all remaining points, see which ones match the
-       conditions */
-    const ScanTaskPoint begin(origin.GetStageNumber() + 1, 0);
-    const ScanTaskPoint end(origin.GetStageNumber() + 1,
-                            origin.GetPointIndex());
-    for (ScanTaskPoint i = begin; i != end; i.IncrementPointIndex())
-      if (CalcEdgeDistance(start, i) <= max_range &&
-          start_point.GetLocation().Distance(GetPoint(i).GetLocation()) < max_distance)
-        Link(i, origin, CalcEdgeDistance(origin, i));
+  const unsigned tp1 = c.tp[0] - n_leaves;
+  const unsigned tp2 = c.tp[1] - n_leaves;
+  const unsigned tp3 = c.tp[2] - n_leaves;
+
+  const TriangleSecondLeg sl(is_fai, GetPoint(tp1), GetPoint(tp2));
+  const TriangleSecondLeg::Result result =
+    sl.Calculate(GetPoint(tp3), best_distance);
+  if (result.total_distance > best_distance) {
+    best_distance = result.total_distance;
+    best_tp[0] = tp1;
+    best_tp[1] = tp2;
+    best_tp[2] = tp3;
   }
 }
 
 void
-OLCTriangle::AddEdges(const ScanTaskPoint origin)
+OLCTriangle::Expand(const Candidate &c)
 {
-  assert(origin.GetPointIndex() < n_points);
+  // split the largest tree node which is not a leaf
+
+  unsigned split = 3, split_size = 0;
+  for (unsigned i = 0; i < 3; ++i) {
+    const TreeNode &node = tree[c.tp[i]];
+    if (c.tp[i] < n_leaves &&
+        (split == 3 || node.last - node.first > split_size)) {
+      split = i;
+      split_size = node.last - node.first;
+    }
+  }
 
-  switch (origin.GetStageNumber()) {
-  case 0:
-    AddTurn1Edges(origin);
-    break;
+  if (split == 3) {
+    Evaluate(c);
+    return;
+  }
 
-  case 1:
-    AddTurn2Edges(origin);
-    break;
+  for (unsigned i = 0; i < 2; ++i) {
+    Candidate child = c;
+    child.tp[split] = 2 * c.tp[split] + i;
+    if (tree[child.tp[split]].IsEmpty())
+      continue;
 
-  case 2:
-    AddFinishEdges(origin);
-    break;
+    child.bound = CalculateBound(child);
+    if (child.bound > best_distance)
+      AddCandidate(child);
+  }
+}
 
-  default:
-    gcc_unreachable();
+void
+OLCTriangle::AddCandidate(const Candidate &c)
+{
+  if (queue.size() < QUEUE_SIZE) {
+    queue.push_back(c);
+    std::push_heap(queue.begin(), queue.end());
+  } else
+    /* the queue is full: search this one depth-first to keep the
+       memory usage bounded */
+    overflow.push_back(c);
+}
+
+bool
+OLCTriangle::RunSearch(unsigned max_steps)
+{
+  while (!queue.empty() || !overflow.empty()) {
+    if (max_steps-- == 0)
+      return false;
+
+    if (!overflow.empty()) {
+      const Candidate c = overflow.back();
+      overflow.pop_back();
+
+      if (c.bound > best_distance)
+        Expand(c);
+      continue;
+    }
+
+    std::pop_heap(queue.begin(), queue.end());
+    const Candidate c = queue.back();
+    queue.pop_back();
+
+    if (c.bound <= best_distance) {
+      /* no remaining candidate can beat the best triangle */
+      queue.clear();
+      break;
+    }
+
+    Expand(c);
   }
+
+  return true;
+}
+
+void
+OLCTriangle::CopyBestTriangle()
+{
+  assert(best_distance > 0);
+
+  unsigned start = 0, finish = n_points - 1;
+
+  if (!predict) {
+    // find the closest start/finish pair around the triangle
+
+    unsigned best_gap = UINT_MAX;
+    for (unsigned i = 0; i <= best_tp[0]; ++i) {
+      if (closing[i] < best_tp[2])
+        continue;
+
+      const unsigned range = GetClosingRange(i);
+      for (unsigned j = best_tp[2]; j < n_points; ++j) {
+        const unsigned gap = GetPoint(i).FlatDistanceTo(GetPoint(j));
+        if (gap < best_gap && IsClosed(i, range, j)) {
+          best_gap = gap;
+          start = i;
+          finish = j;
+        }
+      }
+    }
+
+    assert(best_gap != UINT_MAX);
+  }
+
+  solution.clear();
+  solution.append(GetPoint(start));
+  for (unsigned i = 0; i < 3; ++i)
+    solution.append(GetPoint(best_tp[i]));
+  solution.append(GetPoint(finish));
+}
+
+SolverResult
+OLCTriangle::Solve(bool exhaustive)
+{
+  if (trace_master.size() < 3) {
+    /* not enough data in master trace */
+    ClearTrace();
+    return SolverResult::FAILED;
+  }
+
+  if (!searching ||
+      (exhaustive && append_serial != trace_master.GetAppendSerial())) {
+    if (append_serial == trace_master.GetAppendSerial())
+      /* unmodified */
+      return SolverResult::FAILED;
+
+    UpdateTrace();
+    StartSearch();
+    if (!searching)
+      return SolverResult::FAILED;
+  }
+
+  if (!RunSearch(exhaustive ? UINT_MAX : STEPS_PER_CALL))
+    return SolverResult::INCOMPLETE;
+
+  searching = false;
+
+  if (best_distance == 0)
+    return SolverResult::FAILED;
+
+  CopyBestTriangle();
+  return SaveSolution()
+    ? SolverResult::VALID
+    : SolverResult::FAILED;
 }
 
 ContestResult
@@ -323,43 +575,21 @@ OLCTriangle::CalculateResult(const ContestTraceVector &solution) const
   result.time = n_points > 0
     ? fixed(GetPoint(n_points - 1).DeltaTime(GetPoint(0)))
     : fixed(0);
-  result.distance = is_complete
+  result.distance = solution.size() == 5
     ? CalcLegDistance(solution, 0) + CalcLegDistance(solution, 1) + CalcLegDistance(solution, 2)
     : fixed(0);
   result.score = ApplyHandicap(result.distance * fixed(0.001));
   return result;
 }
 
-void
-OLCTriangle::StartSearch()
-{
-}
-
-bool
-OLCTriangle::UpdateScore()
+ContestResult
+OLCTriangle::CalculateResult() const
 {
-  // RESERVED FOR FUTURE USE: DO NOT DELETE
-  /*
-  if (positive(get_best_score()) && !is_closed) {
-    if (IsPathClosed()) {
-      std::cout << "complete, closed\n";
-      is_closed = true;
-    } else {
-      std::cout << "complete, not closed\n";
-      return true;
-    }
-  }
-  */
-  return false;
+  return CalculateResult(solution);
 }
 
 void
 OLCTriangle::CopySolution(ContestTraceVector &result) const
 {
-  assert(num_stages <= MAX_STAGES);
-
-  ContestDijkstra::CopySolution(result);
-  assert(result.size() == 4);
-  std::swap(result[0], result[3]);
-  std::swap(result[1], result[2]);
+  result = solution;
 }
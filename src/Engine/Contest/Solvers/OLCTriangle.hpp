@@ -23,13 +23,86 @@
 #ifndef OLC_TRIANGLE_HPP
 #define OLC_TRIANGLE_HPP
 
-#include "ContestDijkstra.hpp"
+#include "AbstractContest.hpp"
+#include "Util/Serial.hpp"
+#include "Trace/Vector.hpp"
+#include "Trace/Point.hpp"
+#include "Geo/Flat/FlatBoundingBox.hpp"
+
+#include <vector>
+
+#include <assert.h>
+
+class Trace;
 
 /**
- * Specialisation of OLC Dijkstra for OLC Triangle (triangle) rules
+ * Contest solver for OLC Triangle (triangle) rules
+ *
+ * Instead of a Dijkstra search over all turn point combinations, this
+ * class does a branch-and-bound search over a binary tree of
+ * bounding boxes of the trace points.  Each search node is a triple
+ * of tree nodes (one for each turn point); its upper bound is the
+ * sum of the maximum distances between the three boxes, and it gets
+ * discarded if it cannot beat the best triangle found so far, if the
+ * points cannot be in order, if the FAI leg rules cannot be met or if
+ * the path cannot be closed.  The search finds the exact optimum (in
+ * flat projection).
+ *
+ * Memory usage is linear in the size of the trace: the priority
+ * queue is limited to #QUEUE_SIZE entries, and nodes which do not
+ * fit are searched depth-first.
  */
-class OLCTriangle : public ContestDijkstra {
+class OLCTriangle : public AbstractContest {
+  /**
+   * The maximum number of entries in the priority queue.
+   */
+  static constexpr unsigned QUEUE_SIZE = 4096;
+
+  /**
+   * The number of search nodes expanded by a non-exhaustive Solve()
+   * call.
+   */
+  static constexpr unsigned STEPS_PER_CALL = 2048;
+
+  /**
+   * An entry in the tree of bounding boxes.  Leaf i (at index
+   * #n_leaves + i) contains trace point i, the root is at index 1,
+   * and node n has the children 2n and 2n+1.
+   */
+  struct TreeNode {
+    FlatBoundingBox box;
+
+    /**
+     * The range of trace point indices covered by this node.  Nodes
+     * that cover no trace points have first>last.
+     */
+    unsigned first, last;
+
+    bool IsEmpty() const {
+      return first > last;
+    }
+  };
+
+  /**
+   * A set of triangles to be searched: the first, second and third
+   * turn point are in the given tree nodes.
+   */
+  struct Candidate {
+    /**
+     * Upper bound of the flat triangle distance.
+     */
+    unsigned bound;
+
+    unsigned tp[3];
+
+    bool operator<(const Candidate &other) const {
+      return bound < other.bound;
+    }
+  };
+
 protected:
+  const Trace &trace_master;
+
   const bool is_fai;
 
 private:
@@ -42,40 +115,176 @@ private:
    */
   const bool predict;
 
-  bool is_closed;
-  bool is_complete;
-  unsigned first_tp;
+  /**
+   * This attribute tracks Trace::GetAppendSerial().  It is updated
+   * when a new copy of the master Trace is obtained.
+   */
+  Serial append_serial;
+
+  /**
+   * Working copy of the master trace.
+   */
+  TracePointVector trace;
+
+  std::vector<TreeNode> tree;
+
+  /**
+   * The number of leaves in #tree (a power of two).
+   */
+  unsigned n_leaves;
+
+  /**
+   * For each trace point i, the index of the last trace point which
+   * closes the triangle with any start point up to i.  Not used in
+   * #predict mode.
+   */
+  std::vector<unsigned> closing;
+
+  /**
+   * The priority queue of the search (a heap with the best upper
+   * bound at the front).
+   */
+  std::vector<Candidate> queue;
+
+  /**
+   * Candidates which did not fit into the full #queue.  They are
+   * searched depth-first (the last one first) before the next
+   * #queue entry, which keeps this stack short.
+   */
+  std::vector<Candidate> overflow;
+
+  /**
+   * FAI triangles with a flat distance below this value are shorter
+   * than 500 km, and the 28% leg rule applies.
+   */
+  unsigned fai_limit;
+
+  /**
+   * Is a search in progress?
+   */
+  bool searching;
+
+  /**
+   * The flat distance of the best triangle found by the current
+   * search, or zero.
+   */
+  unsigned best_distance;
+
+  /**
+   * The trace point indices of the best triangle found by the
+   * current search.
+   */
+  unsigned best_tp[3];
+
+  /**
+   * The last solution: start, three turn points and finish.
+   */
+  ContestTraceVector solution;
 
 protected:
-  unsigned best_d;
+  /** Number of points in current trace set */
+  unsigned n_points;
 
 public:
   OLCTriangle(const Trace &_trace, bool is_fai, bool predict);
 
 protected:
   gcc_pure
-  bool IsPathClosed() const;
+  const TracePoint &GetPoint(unsigned i) const {
+    assert(i < n_points);
+
+    return trace[i];
+  }
+
+private:
+  void ClearTrace();
+
+  /**
+   * Obtain a new #Trace copy.
+   */
+  void UpdateTrace();
+
+  /**
+   * Build the bounding box tree and the closing table, and
+   * initialise the priority queue.
+   */
+  void StartSearch();
+
+  void BuildTree();
+
+  /**
+   * Find the last trace point in the given tree node which may close
+   * the triangle with the specified start point.
+   *
+   * @param after only trace points after this index are considered
+   * @return the trace point index or #after if there is none
+   */
+  gcc_pure
+  unsigned FindLastClosing(unsigned start, unsigned range,
+                           unsigned after, unsigned node) const;
+
+  /**
+   * Is the distance between these two trace points small enough to
+   * close the triangle?
+   */
+  gcc_pure
+  bool IsClosed(unsigned start, unsigned range, unsigned finish) const;
+
+  /**
+   * Calculate the flat range for IsClosed() and FindLastClosing().
+   */
+  gcc_pure
+  unsigned GetClosingRange(unsigned start) const;
+
+  /**
+   * Calculate the upper bound for the given candidate.
+   *
+   * @return the upper bound or 0 if the candidate contains no valid
+   * triangle
+   */
+  gcc_pure
+  unsigned CalculateBound(const Candidate &c) const;
+
+  /**
+   * Calculate and check the triangle in a leaf candidate, and
+   * remember it if it is better than the best one.
+   */
+  void Evaluate(const Candidate &c);
+
+  /**
+   * Split the candidate's largest tree node and pass each (valid)
+   * child to AddCandidate().
+   */
+  void Expand(const Candidate &c);
 
-  void AddTurn1Edges(const ScanTaskPoint origin);
-  void AddTurn2Edges(const ScanTaskPoint origin);
-  void AddFinishEdges(const ScanTaskPoint origin);
+  /**
+   * Add the candidate to the priority queue, or to #overflow if the
+   * queue is full.
+   */
+  void AddCandidate(const Candidate &c);
+
+  /**
+   * @return true when the search has finished
+   */
+  bool RunSearch(unsigned max_steps);
+
+  /**
+   * Fill #solution with the best triangle of the current search.
+   */
+  void CopyBestTriangle();
+
+protected:
+  virtual ContestResult CalculateResult(const ContestTraceVector &solution) const;
 
 public:
   /* virtual methods from AbstractContest */
-  virtual void Reset();
+  virtual SolverResult Solve(bool exhaustive) override;
+  virtual void Reset() override;
 
 protected:
   /* virtual methods from AbstractContest */
-  virtual bool UpdateScore() override;
+  virtual ContestResult CalculateResult() const override;
   virtual void CopySolution(ContestTraceVector &vec) const override;
-
-  /* virtual methods from NavDijkstra */
-  virtual void AddEdges(ScanTaskPoint curNode) override;
-
-  /* virtual methods from ContestDijkstra */
-  virtual void StartSearch() override;
-  virtual void AddStartEdges() override;
-  virtual ContestResult CalculateResult(const ContestTraceVector &solution) const override;
 };
 
 #endif
@@ -33,9 +33,9 @@ XContestTriangle::CalculateResult(const ContestTraceVector &solution) const
   ContestResult result = OLCTriangle::CalculateResult(solution);
 
   if (positive(result.distance)) {
-    // approximation for now: gap is distance from start to finish
-    const fixed d_gap = GetPoint(0).GetLocation()
-      .Distance(GetPoint(n_points - 1).GetLocation());
+    // gap is distance from start to finish
+    const fixed d_gap = solution.front().GetLocation()
+      .Distance(solution.back().GetLocation());
 
     // award no points if gap is >20% of triangle
 
@@ -56,13 +56,3 @@ XContestTriangle::CalculateResult(const ContestTraceVector &solution) const
   result.score = ApplyHandicap(result.distance * score_factor);
   return result;
 }
-
-SolverResult
-XContestTriangle::Solve(bool exhaustive)
-{
-  SolverResult result = ContestDijkstra::Solve(exhaustive);
-  if (result != SolverResult::FAILED)
-    best_d = 0; // reset heuristic
-
-  return result;
-}
@@ -26,7 +26,7 @@
 #include "OLCTriangle.hpp"
 
 /**
- * Specialisation of ContestDijkstra for XContest and DHV-XC triangle rules.
+ * Specialisation of OLCTriangle for XContest and DHV-XC triangle rules.
  *
  * This solver alternates between searching for FAI and non-FAI triangles
  */
@@ -37,8 +37,7 @@ public:
   XContestTriangle(const Trace &_trace, bool predict, bool _is_dhv);
 
 protected:
-  /* virtual methods from AbstractContest */
-  virtual SolverResult Solve(bool exhaustive) override;
+  /* virtual methods from OLCTriangle */
   virtual ContestResult CalculateResult(const ContestTraceVector &solution) const override;
 };
 
@@ -265,68 +265,6 @@ GlidePolar::IsGlidePossible(const GlideState &task) const
   return true;
 }
 
-/**
- * Finds speed to fly for a given MacCready setting
- * Intended to be used temporarily.
- *
- * This finds the speed that maximises the glide angle over the ground
- */
-class GlidePolarSpeedToFly final : public ZeroFinder {
-  const GlidePolar &polar;
-  const fixed m_net_sink_rate;
-  const fixed m_head_wind;
-
-public:
-  /**
-   * Constructor.
-   *
-   * @param _polar Glide polar to optimise
-   * @param net_sink_rate Instantaneous netto sink rate (m/s), positive down
-   * @param head_wind Head wind component (m/s)
-   * @param vmin Minimum speed to search (m/s)
-   * @param vmax Maximum speed to search (m/s)
-   *
-   * @return Initialised object (no search yet)
-   */
-  GlidePolarSpeedToFly(const GlidePolar &_polar, const fixed net_sink_rate,
-                       const fixed head_wind, const fixed vmin,
-                       const fixed vmax) :
-    ZeroFinder(std::max(fixed(1), vmin - head_wind), vmax - head_wind,
-               fixed(TOLERANCE_POLAR_DOLPHIN)),
-    polar(_polar),
-    m_net_sink_rate(net_sink_rate),
-    m_head_wind(head_wind)
-  {
-  }
-
-  /**
-   * Glide ratio over ground function
-   *
-   * @param V Speed over ground (m/s)
-   *
-   * @return MacCready-adjusted inverse glide ratio over ground
-   */
-  fixed
-  f(const fixed V)
-  {
-    return (polar.MSinkRate(V + m_head_wind) + m_net_sink_rate) / V;
-  }
-
-  /**
-   * Find best speed to fly
-   *
-   * @param Vstart Initial search speed (m/s)
-   *
-   * @return Speed to fly (m/s)
-   */
-  fixed
-  solve(const fixed Vstart)
-  {
-    fixed Vopt = find_min(Vstart);
-    return Vopt + m_head_wind;
-  }
-};
-
 fixed
 GlidePolar::SpeedToFly(const AircraftState &state,
     const GlideResult &solution, const bool block_stf) const
@@ -345,8 +283,9 @@ GlidePolar::SpeedToFly(const AircraftState &state,
                           : fixed(0));
     const fixed stf_sink_rate (block_stf ? fixed(0) : -state.netto_vario);
 
-    GlidePolarSpeedToFly gp_stf(*this, stf_sink_rate, head_wind, Vmin, Vmax);
-    V_stf = gp_stf.solve(Vmax);
+    /* the ground speed must be at least 1 m/s */
+    V_stf = std::max(GetSpeedToFly(mc + stf_sink_rate, head_wind),
+                     head_wind + fixed(1));
   }
 
   return std::max(Vmin, V_stf * g_scaling);
@@ -416,6 +355,24 @@ GlidePolar::GetBestGlideRatioSpeed(fixed head_wind) const
   return head_wind + sqrt(s);
 }
 
+fixed
+GlidePolar::GetSpeedToFly(fixed sink_offset, fixed head_wind) const
+{
+  assert(polar.IsValid());
+
+  /* minimise (w(V) + sink_offset) / (V - head_wind); the derivative
+     is zero where a.V^2 - 2.a.head_wind.V - (c + sink_offset +
+     b.head_wind) = 0 */
+  fixed s = sqr(head_wind) +
+    (sink_offset + polar.c + polar.b * head_wind) / polar.a;
+  if (negative(s))
+    /* the function increases monotonically: fly as slowly as
+       possible */
+    return Vmin;
+
+  return Clamp(head_wind + sqrt(s), Vmin, Vmax);
+}
+
 fixed
 GlidePolar::GetVTakeoff() const
 {
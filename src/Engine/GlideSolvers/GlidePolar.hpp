@@ -258,6 +258,20 @@ public:
   gcc_pure
   fixed GetBestGlideRatioSpeed(fixed head_wind) const;
 
+  /**
+   * Calculate the airspeed which minimises the sink over ground,
+   * with an additional sink rate (e.g. MacCready setting plus netto
+   * sink rate) and a head wind.  This is the analytic solution for
+   * the parabolic polar.
+   *
+   * @param sink_offset added to the polar's sink rate (m/s, positive
+   * down)
+   * @param head_wind head wind component (m/s)
+   * @return the airspeed (m/s), between #Vmin and #Vmax
+   */
+  gcc_pure
+  fixed GetSpeedToFly(fixed sink_offset, fixed head_wind) const;
+
   /**
    * Takeoff speed
    * @return Takeoff speed threshold (m/s)
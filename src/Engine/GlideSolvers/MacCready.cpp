@@ -411,7 +411,13 @@ MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
 
-  return mc_vopt.Result(glide_polar.GetVMin());
+  /* start with the analytic solution for the head wind component,
+     which is exact without cross wind; ZeroFinder accepts it after
+     three evaluations instead of doing a full search */
+  const fixed v_init =
+    glide_polar.GetSpeedToFly(fixed(0), task.head_wind / cruise_efficiency);
+
+  return mc_vopt.Result(v_init);
 }
 
 /*
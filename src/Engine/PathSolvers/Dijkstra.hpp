@@ -24,7 +24,6 @@ Copyright_License {
 #ifndef DIJKSTRA_HPP
 #define DIJKSTRA_HPP
 
-#include "Util/ReservablePriorityQueue.hpp"
 #include "Compiler.h"
 
 #include <assert.h>
@@ -35,6 +34,10 @@ Copyright_License {
  * Dijkstra search algorithm.
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
+ *
+ * @param MapTemplate provides the edge map ("template<typename Value>
+ * Bind") and the priority queue ("template<typename Value, typename
+ * Compare> Queue"); see ScanTaskPointMap.hpp
  */
 template<typename Node, typename MapTemplate>
 class Dijkstra
@@ -62,6 +65,10 @@ private:
 
     Value(unsigned _edge_value, edge_iterator _iterator)
       :edge_value(_edge_value), iterator(_iterator) {}
+
+    unsigned GetKey() const {
+      return edge_value;
+    }
   };
 
   struct Rank : public std::binary_function<Value, Value, bool> {
@@ -80,7 +87,7 @@ private:
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
-  reservable_priority_queue<Value, std::vector<Value>, Rank> q;
+  typename MapTemplate::template Queue<Value, Rank> q;
 
   /**
    * The value of the current edge, i.e. the one that was consumed by
@@ -99,8 +106,7 @@ public:
    */
   void Clear() {
     // Clear the search queue
-    while (!q.empty())
-      q.pop();
+    q.clear();
 
     // Clear EdgeMap
     edges.clear();
@@ -207,11 +213,10 @@ public:
    */
   void RestartQueue() {
     // Clear the search queue
-    while (!q.empty())
-      q.pop();
+    q.clear();
 
-    for (const auto &i : edges)
-      q.push(Value(i.second.value, i));
+    for (edge_iterator i = edges.begin(), end = edges.end(); i != end; ++i)
+      q.push(Value(i->second.value, i));
   }
 
 private:
@@ -26,11 +26,10 @@ Copyright_License {
 
 #include "Util/NonCopyable.hpp"
 #include "Dijkstra.hpp"
-#include "ScanTaskPoint.hpp"
+#include "ScanTaskPointMap.hpp"
 #include "SolverResult.hpp"
 #include "Compiler.h"
 
-#include <unordered_map>
 #include <assert.h>
 
 /**
@@ -49,26 +48,7 @@ protected:
     MAX_STAGES = 16,
   };
 
-  struct DijkstraMap {
-    struct Hash {
-      std::size_t operator()(ScanTaskPoint p) const {
-        return p.Key();
-      }
-    };
-
-    struct Equal {
-      std::size_t operator()(ScanTaskPoint a, ScanTaskPoint b) const {
-        return a.Key() == b.Key();
-      }
-    };
-
-    template<typename Value>
-    struct Bind : public std::unordered_map<ScanTaskPoint, Value,
-                                            Hash, Equal> {
-    };
-  };
-
-  typedef ::Dijkstra<ScanTaskPoint, DijkstraMap> Dijkstra;
+  typedef ::Dijkstra<ScanTaskPoint, DenseScanTaskPointMap> Dijkstra;
 
   Dijkstra dijkstra;
 
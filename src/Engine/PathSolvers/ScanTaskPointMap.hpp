@@ -0,0 +1,229 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef SCAN_TASK_POINT_MAP_HPP
+#define SCAN_TASK_POINT_MAP_HPP
+
+#include "ScanTaskPoint.hpp"
+#include "Util/ReservablePriorityQueue.hpp"
+#include "Util/RadixQueue.hpp"
+#include "Compiler.h"
+
+#include <unordered_map>
+#include <vector>
+#include <utility>
+
+#include <assert.h>
+
+/**
+ * A map from #ScanTaskPoint to a value, implemented with one table
+ * per stage, indexed by the point index.  The values themselves are
+ * stored in insertion order in one array, which makes iteration and
+ * clear() cheap.  Memory usage is proportional to the highest point
+ * index.
+ *
+ * Iterators remain valid until clear() is called.
+ */
+template<typename T>
+class ScanTaskPointTable {
+public:
+  typedef std::pair<ScanTaskPoint, T> value_type;
+
+private:
+  typedef std::vector<value_type> Vector;
+
+  Vector values;
+
+  /**
+   * For each stage and each point index, the position of the value
+   * in #values plus one, or zero if there is none.
+   */
+  std::vector<std::vector<unsigned>> tables;
+
+  template<typename V, typename P>
+  class Iterator {
+    friend class ScanTaskPointTable;
+
+    V *values;
+    unsigned position;
+
+    Iterator(V &_values, unsigned _position)
+      :values(&_values), position(_position) {}
+
+  public:
+    Iterator() = default;
+
+    /**
+     * Convert an iterator to a const_iterator.
+     */
+    template<typename V2, typename P2>
+    Iterator(const Iterator<V2, P2> &other)
+      :values(other.values), position(other.position) {}
+
+    P &operator*() const {
+      return (*values)[position];
+    }
+
+    P *operator->() const {
+      return &(*values)[position];
+    }
+
+    Iterator &operator++() {
+      ++position;
+      return *this;
+    }
+
+    bool operator==(const Iterator &other) const {
+      return position == other.position;
+    }
+
+    bool operator!=(const Iterator &other) const {
+      return position != other.position;
+    }
+
+    template<typename V2, typename P2>
+    friend class Iterator;
+  };
+
+public:
+  typedef Iterator<Vector, value_type> iterator;
+  typedef Iterator<const Vector, const value_type> const_iterator;
+
+  gcc_pure
+  unsigned size() const {
+    return values.size();
+  }
+
+  iterator begin() {
+    return iterator(values, 0);
+  }
+
+  iterator end() {
+    return iterator(values, values.size());
+  }
+
+  const_iterator begin() const {
+    return const_iterator(values, 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(values, values.size());
+  }
+
+  gcc_pure
+  iterator find(ScanTaskPoint key) {
+    const unsigned position = Lookup(key);
+    return position > 0
+      ? iterator(values, position - 1)
+      : end();
+  }
+
+  gcc_pure
+  const_iterator find(ScanTaskPoint key) const {
+    const unsigned position = Lookup(key);
+    return position > 0
+      ? const_iterator(values, position - 1)
+      : end();
+  }
+
+  std::pair<iterator, bool> insert(const value_type &value) {
+    const unsigned stage = value.first.GetStageNumber();
+    const unsigned index = value.first.GetPointIndex();
+
+    if (stage >= tables.size())
+      tables.resize(stage + 1);
+
+    std::vector<unsigned> &table = tables[stage];
+    if (index >= table.size())
+      table.resize(index + 1, 0);
+    else if (table[index] > 0)
+      return std::make_pair(iterator(values, table[index] - 1), false);
+
+    values.push_back(value);
+    table[index] = values.size();
+    return std::make_pair(iterator(values, values.size() - 1), true);
+  }
+
+  void clear() {
+    for (const auto &i : values)
+      tables[i.first.GetStageNumber()][i.first.GetPointIndex()] = 0;
+
+    values.clear();
+  }
+
+private:
+  gcc_pure
+  unsigned Lookup(ScanTaskPoint key) const {
+    const unsigned stage = key.GetStageNumber();
+    const unsigned index = key.GetPointIndex();
+
+    return stage < tables.size() && index < tables[stage].size()
+      ? tables[stage][index]
+      : 0;
+  }
+};
+
+/**
+ * A MapTemplate for #Dijkstra, using a hash map for the edges and a
+ * binary heap for the queue.
+ */
+struct HashScanTaskPointMap {
+  struct Hash {
+    std::size_t operator()(ScanTaskPoint p) const {
+      return p.Key();
+    }
+  };
+
+  struct Equal {
+    std::size_t operator()(ScanTaskPoint a, ScanTaskPoint b) const {
+      return a.Key() == b.Key();
+    }
+  };
+
+  template<typename Value>
+  struct Bind : public std::unordered_map<ScanTaskPoint, Value,
+                                          Hash, Equal> {
+  };
+
+  template<typename Value, typename Compare>
+  struct Queue
+    : public reservable_priority_queue<Value, std::vector<Value>, Compare> {
+  };
+};
+
+/**
+ * A MapTemplate for #Dijkstra, using a #ScanTaskPointTable for the
+ * edges and a #RadixQueue for the queue.  This is faster, but the
+ * memory usage depends on the highest point index in each stage.
+ */
+struct DenseScanTaskPointMap {
+  template<typename Value>
+  struct Bind : public ScanTaskPointTable<Value> {
+  };
+
+  template<typename Value, typename Compare>
+  struct Queue : public RadixQueue<Value> {
+  };
+};
+
+#endif
@@ -25,16 +25,13 @@ Copyright_License {
 #define ASTAR_HPP
 
 #include "Util/ReservablePriorityQueue.hpp"
-#include <assert.h>
 #include "Compiler.h"
 
-//#define ASTAR_TR1
+#include <vector>
+#include <algorithm>
 
-#ifdef ASTAR_TR1
-#include <tr1/unordered_map>
-#else
-#include <map>
-#endif
+#include <assert.h>
+#include <stdint.h>
 
 #ifdef INSTRUMENT_TASK
 extern long count_astar_links;
@@ -44,6 +41,12 @@ extern long count_astar_links;
 
 #define ASTAR_QUEUE_SIZE 1024
 
+/**
+ * The maximum number of nodes stored by #AStar.  Nodes found after
+ * that are ignored, which limits the memory used by one search.
+ */
+#define ASTAR_MAX_NODES 32768
+
 struct AStarPriorityValue
 {
   /** Actual edge value */
@@ -83,37 +86,28 @@ struct AStarPriorityValue
  * AStar search algorithm, based on Dijkstra algorithm
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
+ *
+ * The nodes are stored in flat arrays, indexed by an open addressing
+ * hash table.  The memory is kept between searches, so a search
+ * allocates nothing once the arrays have grown to the size it needs.
+ *
+ * @param HashNode a function object returning a hash value for a
+ * node
+ * @param EqualNode a function object which decides whether two nodes
+ * are the same; it must be consistent with HashNode
  */
-template <class Node, class CompareNode=std::less<Node>, bool m_min=true>
+template <class Node, class HashNode, class EqualNode, bool m_min=true>
 class AStar
 {
-#ifdef ASTAR_TR1
-  typedef std::tr1::unordered_map<Node, AStarPriorityValue> node_value_map;
-#else
-  typedef std::map<Node, AStarPriorityValue, CompareNode> node_value_map;
-#endif
-
-  typedef typename node_value_map::iterator node_value_iterator;
-  typedef typename node_value_map::const_iterator node_value_const_iterator;
-
-#ifdef ASTAR_TR1
-  typedef std::tr1::unordered_map<Node, Node> node_parent_map;
-#else
-  typedef std::map<Node, Node, CompareNode> node_parent_map;
-#endif
-
-  typedef typename node_parent_map::iterator node_parent_iterator;
-  typedef typename node_parent_map::const_iterator node_parent_const_iterator;
-
   struct NodeValue {
     AStarPriorityValue priority;
 
-    node_value_iterator iterator;
+    /** The index of the node in #nodes */
+    unsigned index;
 
     constexpr
-    NodeValue(const AStarPriorityValue &_priority,
-              node_value_iterator _iterator)
-      :priority(_priority), iterator(_iterator) {}
+    NodeValue(const AStarPriorityValue &_priority, unsigned _index)
+      :priority(_priority), index(_index) {}
   };
 
   struct Rank: public std::binary_function<NodeValue, NodeValue, bool>
@@ -125,23 +119,48 @@ class AStar
   };
 
   /**
-   * Stores the value of each node.  It is updated by push(), if a
-   * value lower than the current one is found.
+   * All nodes found by this search, in the order they were found.
+   */
+  std::vector<Node> nodes;
+
+  /**
+   * Stores the value of each node in #nodes.  It is updated by
+   * Push(), if a value lower than the current one is found.
    */
-  node_value_map node_values;
+  std::vector<AStarPriorityValue> node_values;
 
   /**
-   * Stores the predecessor of each node.  It is maintained by
-   * set_predecessor().
+   * Stores the predecessor of each node in #nodes.  It is
+   * maintained by Push().
    */
-  node_parent_map node_parents;
+  std::vector<Node> node_parents;
+
+  /**
+   * Open addressing hash table with linear probing.  Each element is
+   * an index into #nodes plus one, or zero for an empty slot.  The
+   * size is a power of two, and it is kept at least twice as large as
+   * the number of nodes.
+   */
+  std::vector<uint32_t> table;
+
+  /**
+   * The number of bits of the table size.
+   */
+  unsigned table_bits;
+
+  /**
+   * The number of nodes which were not stored because
+   * #ASTAR_MAX_NODES was reached.
+   */
+  unsigned long count_overflow;
 
   /**
    * A sorted list of all possible node paths, lowest distance first.
    */
   reservable_priority_queue<NodeValue, std::vector<NodeValue>, Rank> q;
 
-  node_value_iterator cur;
+  /** The index of the node returned by Pop() */
+  unsigned cur;
 
 public:
   /**
@@ -150,6 +169,7 @@ public:
    * @param is_min Whether this algorithm will search for min or max distance
    */
   AStar(unsigned reserve_default = ASTAR_QUEUE_SIZE)
+    :table_bits(0), count_overflow(0), cur(0)
   {
     Reserve(reserve_default);
   }
@@ -161,6 +181,7 @@ public:
    * @param is_min Whether this algorithm will search for min or max distance
    */
   AStar(const Node &node, unsigned reserve_default = ASTAR_QUEUE_SIZE)
+    :table_bits(0), count_overflow(0), cur(0)
   {
     Reserve(reserve_default);
     Push(node, node, AStarPriorityValue(0));
@@ -176,16 +197,17 @@ public:
     Push(node, node, AStarPriorityValue(0));
   }
 
-  /** Clears the queues */
+  /**
+   * Clears the queues.  The memory is kept for the next search.
+   */
   void Clear() {
-    // Clear the search queue
-    while (!q.empty())
-      q.pop();
+    q.clear();
 
-    // Clear the node_parent_map
-    node_parents.clear();
-    // Clear the node_value_map
+    nodes.clear();
     node_values.clear();
+    node_parents.clear();
+    std::fill(table.begin(), table.end(), 0);
+    count_overflow = 0;
   }
 
   /**
@@ -208,20 +230,38 @@ public:
     return q.size();
   }
 
+  /**
+   * Returns the number of nodes found by this search.
+   */
+  gcc_pure
+  unsigned GetNodeCount() const {
+    return nodes.size();
+  }
+
+  /**
+   * Returns the number of nodes ignored by this search, because
+   * #ASTAR_MAX_NODES was reached.
+   */
+  gcc_pure
+  unsigned long GetOverflowCount() const {
+    return count_overflow;
+  }
+
   /**
    * Return top element of queue for processing
    *
    * @return Node for processing
    */
   const Node &Pop() {
-    cur = q.top().iterator;
+    cur = q.top().index;
 
     do // remove this item
       q.pop();
-    while (!q.empty() && (q.top().priority > q.top().iterator->second));
+    while (!q.empty() &&
+           (q.top().priority > node_values[q.top().index]));
     // and all lower rank than this
 
-    return cur->first;
+    return nodes[cur];
   }
 
   /**
@@ -249,9 +289,8 @@ public:
    */
   gcc_pure
   Node GetPredecessor(const Node &node) const {
-    // Try to find the given node in the node_parent_map
-    node_parent_const_iterator it = node_parents.find(node);
-    if (it == node_parents.end())
+    const int i = Find(node);
+    if (i < 0)
       // first entry
       // If the node wasn't found
       // -> Return the given node itself
@@ -259,7 +298,7 @@ public:
 
     // If the node was found
     // -> Return the parent node
-    return it->second;
+    return node_parents[i];
   }
 
   /** Reserve queue size (if available) */
@@ -273,17 +312,70 @@ public:
    */
   gcc_pure
   AStarPriorityValue GetNodeValue(const Node &node) const {
-    node_value_const_iterator it = node_values.find(node);
-    if (cur->first == node)
-      return cur->second;
+    if (cur < nodes.size() && EqualNode()(nodes[cur], node))
+      return node_values[cur];
 
-    if (it == node_values.end())
+    const int i = Find(node);
+    if (i < 0)
       return AStarPriorityValue(0);
 
-    return it->second;
+    return node_values[i];
   }
 
 private:
+  gcc_pure
+  unsigned GetSlot(const Node &node) const {
+    /* Fibonacci hashing spreads the hash over the table */
+    return ((uint32_t)HashNode()(node) * 2654435761u) >> (32 - table_bits);
+  }
+
+  /**
+   * Look up a node.
+   *
+   * @return the index in #nodes, or -1 if the node was not found
+   */
+  gcc_pure
+  int Find(const Node &node) const {
+    if (table.empty())
+      return -1;
+
+    const unsigned mask = table.size() - 1;
+    for (unsigned slot = GetSlot(node);; slot = (slot + 1) & mask) {
+      const uint32_t i = table[slot];
+      if (i == 0)
+        return -1;
+
+      if (EqualNode()(nodes[i - 1], node))
+        return i - 1;
+    }
+  }
+
+  /**
+   * Store the given index of #nodes in the hash table.
+   */
+  void Insert(unsigned index) {
+    const unsigned mask = table.size() - 1;
+    unsigned slot = GetSlot(nodes[index]);
+    while (table[slot] != 0)
+      slot = (slot + 1) & mask;
+
+    table[slot] = index + 1;
+  }
+
+  /**
+   * Make sure the hash table has room for one more node.
+   */
+  void Grow() {
+    if (table.size() >= 2 * (nodes.size() + 1))
+      return;
+
+    table_bits = std::max(table_bits + 1, 10u);
+    table.assign(1u << table_bits, 0);
+
+    for (unsigned i = 0, n = nodes.size(); i < n; ++i)
+      Insert(i);
+  }
+
   /**
    * Add node to search queue
    *
@@ -293,44 +385,39 @@ private:
    */
   void Push(const Node &node, const Node &parent,
             const AStarPriorityValue &edge_value) {
-    // Try to find the given node n in the node_value_map
-    node_value_iterator it = node_values.find(node);
-    if (it == node_values.end()) {
+    // Try to find the given node n in the node list
+    int i = Find(node);
+    if (i < 0) {
       // first entry
       // If the node wasn't found
-      // -> Insert a new node into the node_value_map
-      it = node_values.insert(std::make_pair(node, edge_value)).first;
-
+      if (nodes.size() >= ASTAR_MAX_NODES) {
+        // -> Drop it if the memory limit has been reached
+        ++count_overflow;
+        return;
+      }
+
+      // -> Append a new node
+      Grow();
+      i = nodes.size();
+      nodes.push_back(node);
+      node_values.push_back(edge_value);
       // Remember the parent node
-      SetPredecessor(node, parent);
-    } else if (it->second > edge_value) {
+      node_parents.push_back(parent);
+      Insert(i);
+    } else if (node_values[i] > edge_value) {
       // If the node was found and the new value is smaller
       // -> Replace the value with the new one
-      it->second = edge_value;
+      node_values[i] = edge_value;
       // replace, it's bigger
 
       // Remember the new parent node
-      SetPredecessor(node, parent);
+      node_parents[i] = parent;
     } else
       // If the node was found but the value is higher or equal
       // -> Don't use this new leg
       return;
 
-    q.push(NodeValue(edge_value, it));
-  }
-
-  void SetPredecessor(const Node &node, const Node &parent) {
-    // Try to find the given node in the node_parent_map
-    node_parent_iterator it = node_parents.find(node);
-    if (it == node_parents.end())
-      // first entry
-      // If the node wasn't found
-      // -> Insert a new node into the node_parent_map
-      node_parents.insert(std::make_pair(node, parent));
-    else
-      // If the node was found
-      // -> Replace the according parent node with the new one
-      it->second = parent;
+    q.push(NodeValue(edge_value, i));
   }
 };
 
@@ -23,9 +23,12 @@
 #include "FlatTriangleFanTree.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "ReachFanParms.hpp"
+#include "ReachWorkers.hpp"
 #include "Util/GlobalSliceAllocator.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 
+#include <atomic>
+
 #define REACH_BUFFER 1
 #define REACH_SWEEP (ROUTEPOLAR_Q1-REACH_BUFFER)
 
@@ -106,7 +109,9 @@ FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin,
 
   for (parms.set_depth = 0; parms.set_depth < REACH_MAX_DEPTH;
       ++parms.set_depth)
-    if (!FillDepth(origin, parms))
+    if (!(parms.workers != NULL
+          ? FillDepthParallel(origin, parms)
+          : FillDepth(origin, parms)))
       // stop searching
       break;
 
@@ -145,9 +150,79 @@ FlatTriangleFanTree::FillDepth(const AFlatGeoPoint &origin,
   return true;
 }
 
+void
+FlatTriangleFanTree::CollectUnfilled(unsigned char set_depth,
+                                     std::vector<FlatTriangleFanTree *> &dest)
+{
+  if (depth == set_depth) {
+    if (!gaps_filled)
+      dest.push_back(this);
+  } else if (depth < set_depth) {
+    for (auto &child : children)
+      child.CollectUnfilled(set_depth, dest);
+  }
+}
+
+/**
+ * Calculates the gaps of a list of fans; the fans are distributed
+ * dynamically over the workers, because their cost varies a lot.
+ */
+class FindGapsJob final : public ReachWorkers::Job {
+  const std::vector<FlatTriangleFanTree *> &fans;
+  std::vector<std::vector<FlatTriangleFanTree>> &gaps;
+  const AFlatGeoPoint &origin;
+  const ReachFanParms &parms;
+
+  std::atomic<unsigned> next;
+
+public:
+  FindGapsJob(const std::vector<FlatTriangleFanTree *> &_fans,
+              std::vector<std::vector<FlatTriangleFanTree>> &_gaps,
+              const AFlatGeoPoint &_origin, const ReachFanParms &_parms)
+    :fans(_fans), gaps(_gaps), origin(_origin), parms(_parms), next(0) {}
+
+  virtual void Run(unsigned index, unsigned n) override {
+    unsigned i;
+    while ((i = next++) < fans.size())
+      fans[i]->FindGaps(origin, parms, gaps[i]);
+  }
+};
+
+bool
+FlatTriangleFanTree::FillDepthParallel(const AFlatGeoPoint &origin,
+                                       ReachFanParms &parms)
+{
+  assert(parms.workers != NULL);
+
+  std::vector<FlatTriangleFanTree *> fans;
+  CollectUnfilled(parms.set_depth, fans);
+  if (fans.empty())
+    return true;
+
+  std::vector<std::vector<FlatTriangleFanTree>> gaps(fans.size());
+  FindGapsJob job(fans, gaps, origin, parms);
+  parms.workers->Run(job);
+
+  /* add the results in the order of FillDepth(), which may stop
+     before all of them are used */
+  for (unsigned i = 0; i < fans.size(); ++i) {
+    fans[i]->gaps_filled = true;
+
+    if (parms.vertex_counter > REACH_MAX_VERTICES)
+      return false;
+    if (parms.fan_counter > REACH_MAX_FANS)
+      return false;
+
+    fans[i]->AddGaps(gaps[i], parms);
+  }
+
+  return true;
+}
+
 void
 FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
-                               const int index_high, ReachFanParms &parms)
+                               const int index_high,
+                               const ReachFanParms &parms)
 {
   const AGeoPoint ao(parms.task_proj.Unproject(origin), origin.altitude);
   height = origin.altitude;
@@ -179,6 +254,16 @@ FlatTriangleFanTree::FillReach(const AFlatGeoPoint &origin, const int index_low,
 
 void
 FlatTriangleFanTree::FillGaps(const AFlatGeoPoint &origin, ReachFanParms &parms)
+{
+  std::vector<FlatTriangleFanTree> found;
+  FindGaps(origin, parms, found);
+  AddGaps(found, parms);
+}
+
+void
+FlatTriangleFanTree::FindGaps(const AFlatGeoPoint &origin,
+                              const ReachFanParms &parms,
+                              std::vector<FlatTriangleFanTree> &found) const
 {
   // worth checking for gaps?
   if (vs.size() > 2 && parms.rpolars.IsTurningReachEnabled()) {
@@ -194,13 +279,26 @@ FlatTriangleFanTree::FillGaps(const AFlatGeoPoint &origin, ReachFanParms &parms)
 
       const RouteLink e(RoutePoint(*x, RoughAltitude(0)), o, parms.task_proj);
       // check if children need to be added
-      CheckGap(origin, e_last, e, parms);
+      FlatTriangleFanTree child(depth + 1);
+      if (FillGap(origin, e_last, e, child, parms))
+        found.push_back(std::move(child));
 
       e_last = e;
     }
   }
 }
 
+void
+FlatTriangleFanTree::AddGaps(std::vector<FlatTriangleFanTree> &found,
+                             ReachFanParms &parms)
+{
+  for (auto &child : found) {
+    parms.vertex_counter += child.vs.size();
+    parms.fan_counter++;
+    children.push_back(std::move(child));
+  }
+}
+
 void
 FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint &o,
                                        ReachFanParms &parms)
@@ -229,8 +327,9 @@ FlatTriangleFanTree::UpdateTerrainBase(const FlatGeoPoint &o,
 }
 
 bool
-FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
-                              const RouteLink &e_2, ReachFanParms &parms)
+FlatTriangleFanTree::FillGap(const AFlatGeoPoint &n, const RouteLink &e_1,
+                             const RouteLink &e_2, FlatTriangleFanTree &child,
+                             const ReachFanParms &parms) const
 {
   const bool side = (e_1.d > e_2.d);
   const RouteLink &e_long = (side ? e_1 : e_2);
@@ -259,9 +358,6 @@ FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
     index_right = e_long.polar_index + REACH_SWEEP;
   }
 
-  children.emplace_back(depth + 1);
-  FlatTriangleFanTree &child = children.back();
-
   for (fixed f = f0; f < fixed(0.9); f += fixed(0.1)) {
     // find corner point
     const FlatGeoPoint px = (dp * f + n);
@@ -274,18 +370,13 @@ FlatTriangleFanTree::CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
     child.FillReach(x, index_left, index_right, parms);
 
     // prune child if empty or single spike
-    if (child.vs.size() > 3) {
-      parms.vertex_counter += child.vs.size();
-      parms.fan_counter++;
+    if (child.vs.size() > 3)
       return true;
-    }
 
     child.vs.clear();
   }
 
   // don't need the child
-  children.pop_back();
-
   return false;
 }
 
@@ -327,6 +418,48 @@ FlatTriangleFanTree::FindPositiveArrival(const FlatGeoPoint &n,
   return retval;
 }
 
+void
+FlatTriangleFanTree::FindPositiveArrival(ArrivalQuery *queries,
+                                         std::vector<unsigned> &active,
+                                         unsigned begin, unsigned end,
+                                         const ReachFanParms &parms) const
+{
+  /* the queries which are passed on to the children are appended to
+     "active" */
+  const unsigned child_begin = active.size();
+
+  for (unsigned i = begin; i < end; ++i) {
+    ArrivalQuery &query = queries[active[i]];
+
+    if (height < query.arrival_height)
+      continue; // can't possibly improve
+
+    if (!bb_children.IsInside(query.location))
+      continue; // not in scope
+
+    if (IsInside(query.location)) { // found in this segment
+      const AFlatGeoPoint nn(vs[0], height);
+      const RoughAltitude h =
+        parms.rpolars.CalcGlideArrival(nn, query.location, parms.task_proj);
+      if (h > query.arrival_height) {
+        query.arrival_height = h;
+        query.found = true;
+        continue;
+      }
+    }
+
+    active.push_back(active[i]);
+  }
+
+  const unsigned child_end = active.size();
+  if (child_end > child_begin)
+    for (const auto &child : children)
+      child.FindPositiveArrival(queries, active, child_begin, child_end,
+                                parms);
+
+  active.resize(child_begin);
+}
+
 void
 FlatTriangleFanTree::AcceptInRange(const FlatBoundingBox &bb,
                                    const TaskProjection &task_proj,
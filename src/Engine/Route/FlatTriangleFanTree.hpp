@@ -28,6 +28,7 @@
 #include "FlatTriangleFan.hpp"
 
 #include <list>
+#include <vector>
 
 class TaskProjection;
 struct GeoPoint;
@@ -51,6 +52,24 @@ public:
   typedef std::list<FlatTriangleFanTree,
                     GlobalSliceAllocator<FlatTriangleFanTree, 128u> > LeafVector;
 
+  /**
+   * One destination of the batched FindPositiveArrival() method.
+   */
+  struct ArrivalQuery {
+    FlatGeoPoint location;
+
+    /**
+     * The best arrival height found so far; must be initialised like
+     * the arrival_height parameter of the single destination version.
+     */
+    RoughAltitude arrival_height;
+
+    /**
+     * Was #arrival_height improved by the search?
+     */
+    bool found;
+  };
+
 protected:
   FlatBoundingBox bb_children;
   LeafVector children;
@@ -92,24 +111,82 @@ public:
 
   void FillReach(const AFlatGeoPoint &origin,
                  const int index_low, const int index_high,
-                 ReachFanParms &parms);
+                 const ReachFanParms &parms);
 
   bool FillDepth(const AFlatGeoPoint &origin, ReachFanParms &parms);
   void FillGaps(const AFlatGeoPoint &origin, ReachFanParms &parms);
 
-  bool CheckGap(const AFlatGeoPoint &n, const RouteLink &e_1,
-                const RouteLink &e_2, ReachFanParms &parms);
+  /**
+   * Like FillDepth(), but calculates the gaps of all fans of the
+   * current depth in parallel with ReachFanParms::workers.  The fans
+   * are then added in the same order as FillDepth() would, and the
+   * vertex and fan limits are checked the same way, so the resulting
+   * tree is the same.
+   */
+  bool FillDepthParallel(const AFlatGeoPoint &origin, ReachFanParms &parms);
+
+  /**
+   * Calculate the fans which fill the gaps of this fan, without
+   * modifying the tree.  This may be called concurrently for
+   * different fans.
+   *
+   * @param found receives the new fans
+   */
+  void FindGaps(const AFlatGeoPoint &origin, const ReachFanParms &parms,
+                std::vector<FlatTriangleFanTree> &found) const;
+
+  /**
+   * Add fans returned by FindGaps() as children of this fan.
+   */
+  void AddGaps(std::vector<FlatTriangleFanTree> &found,
+               ReachFanParms &parms);
+
+  /**
+   * Try to fill the gap between two edges with a new fan.
+   *
+   * @param child an empty fan which receives the result
+   * @return true if the new fan is worth keeping
+   */
+  bool FillGap(const AFlatGeoPoint &n, const RouteLink &e_1,
+               const RouteLink &e_2, FlatTriangleFanTree &child,
+               const ReachFanParms &parms) const;
 
   bool FindPositiveArrival(const FlatGeoPoint &n,
                            const ReachFanParms &parms,
                            RoughAltitude &arrival_height) const;
 
+  /**
+   * Batched version of FindPositiveArrival(): searches the arrival
+   * heights of several destinations in one traversal of the tree.
+   * Each fan passes only those destinations on to its children which
+   * are still in scope, so the result of each query is the same as
+   * that of the single destination version.
+   *
+   * @param active the indices of the queries to be searched are
+   * active[begin] to active[end-1]; elements behind #end are used as
+   * a stack by the recursion, and removed again before returning
+   */
+  void FindPositiveArrival(ArrivalQuery *queries,
+                           std::vector<unsigned> &active,
+                           unsigned begin, unsigned end,
+                           const ReachFanParms &parms) const;
+
   void AcceptInRange(const FlatBoundingBox &bb,
                      const TaskProjection &task_proj,
                      TriangleFanVisitor &visitor) const;
 
   void UpdateTerrainBase(const FlatGeoPoint &origin, ReachFanParms &parms);
 
+private:
+  /**
+   * Append all fans of the given depth whose gaps have not been
+   * filled yet, in the order FillDepth() visits them.
+   */
+  void CollectUnfilled(unsigned char set_depth,
+                       std::vector<FlatTriangleFanTree *> &dest);
+
+public:
+
   gcc_pure
   RoughAltitude DirectArrival(const FlatGeoPoint &dest,
                               const ReachFanParms &parms) const;
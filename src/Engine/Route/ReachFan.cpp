@@ -26,16 +26,29 @@
 #include "ReachFanParms.hpp"
 #include "ReachResult.hpp"
 
+#include <algorithm>
+
 void
 ReachFan::Reset()
 {
   root.Clear();
   terrain_base = 0;
+  ++serial;
+}
+
+void
+ReachFan::Swap(ReachFan &other)
+{
+  std::swap(task_proj, other.task_proj);
+  std::swap(root, other.root);
+  std::swap(terrain_base, other.terrain_base);
+  serial = other.serial = std::max(serial, other.serial) + 1;
 }
 
 bool
 ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-                const RasterMap* terrain, const bool do_solve)
+                const RasterMap* terrain, const bool do_solve,
+                ReachWorkers *workers)
 {
   Reset();
 
@@ -48,7 +61,8 @@ ReachFan::Solve(const AGeoPoint origin, const RoutePolars &rpolars,
     : RasterBuffer::TERRAIN_INVALID;
   const RoughAltitude h2(RasterBuffer::IsSpecial(h) ? 0 : h);
 
-  ReachFanParms parms(rpolars, task_proj, (int)terrain_base, terrain);
+  ReachFanParms parms(rpolars, task_proj, (int)terrain_base, terrain,
+                      workers);
   const AFlatGeoPoint ao(task_proj.ProjectInteger(origin), origin.altitude);
 
   if (!RasterBuffer::IsInvalid(h) &&
@@ -124,6 +138,62 @@ ReachFan::FindPositiveArrival(const AGeoPoint dest, const RoutePolars &rpolars,
   return true;
 }
 
+bool
+ReachFan::FindPositiveArrival(const AGeoPoint *dests, unsigned n,
+                              const RoutePolars &rpolars,
+                              ReachResult *results) const
+{
+  if (root.IsEmpty())
+    return false;
+
+  const ReachFanParms parms(rpolars, task_proj, (int)terrain_base);
+
+  std::vector<FlatTriangleFanTree::ArrivalQuery> queries(n);
+  std::vector<unsigned> active;
+  active.reserve(n);
+
+  for (unsigned i = 0; i < n; ++i) {
+    FlatTriangleFanTree::ArrivalQuery &query = queries[i];
+    ReachResult &result_r = results[i];
+
+    query.location = task_proj.ProjectInteger(dests[i]);
+
+    result_r.Clear();
+    result_r.direct = root.DirectArrival(query.location, parms);
+
+    if (root.IsDummy())
+      continue;
+
+    if (std::min(root.GetHeight(), result_r.direct) < dests[i].altitude) {
+      result_r.terrain = result_r.direct;
+      result_r.terrain_valid = ReachResult::Validity::UNREACHABLE;
+      continue;
+    }
+
+    query.arrival_height = dests[i].altitude - RoughAltitude(1);
+    query.found = false;
+    active.push_back(i);
+  }
+
+  const unsigned n_active = active.size();
+  if (n_active == 0)
+    return true;
+
+  root.FindPositiveArrival(queries.data(), active, 0, n_active, parms);
+
+  for (unsigned i = 0; i < n_active; ++i) {
+    const FlatTriangleFanTree::ArrivalQuery &query = queries[active[i]];
+    ReachResult &result_r = results[active[i]];
+
+    result_r.terrain = query.arrival_height;
+    result_r.terrain_valid = query.found
+      ? ReachResult::Validity::VALID
+      : ReachResult::Validity::UNREACHABLE;
+  }
+
+  return true;
+}
+
 void
 ReachFan::AcceptInRange(const GeoBounds &bounds,
                         TriangleFanVisitor &visitor) const
@@ -30,6 +30,7 @@
 class RoutePolars;
 class RasterMap;
 class GeoBounds;
+class ReachWorkers;
 struct ReachResult;
 
 class ReachFan
@@ -38,8 +39,15 @@ class ReachFan
   FlatTriangleFanTree root;
   RoughAltitude terrain_base;
 
+  /**
+   * Incremented each time the fan is solved or reset.  Clients may
+   * use this to decide whether results derived from the fan are
+   * still current.
+   */
+  unsigned serial;
+
 public:
-  ReachFan():terrain_base(0) {}
+  ReachFan():terrain_base(0), serial(0) {}
 
   friend class PrintHelper;
 
@@ -49,12 +57,35 @@ public:
 
   void Reset();
 
+  /**
+   * @param workers if not NULL, then the fans of each depth are
+   * calculated in parallel with these workers
+   */
   bool Solve(const AGeoPoint origin, const RoutePolars &rpolars,
-             const RasterMap *terrain, const bool do_solve = true);
+             const RasterMap *terrain, const bool do_solve = true,
+             ReachWorkers *workers = NULL);
+
+  /**
+   * Exchange the fan with another one, e.g. one which was solved in
+   * the background.  Both serials are advanced past their previous
+   * values.
+   */
+  void Swap(ReachFan &other);
 
   bool FindPositiveArrival(const AGeoPoint dest, const RoutePolars &rpolars,
                            ReachResult &result_r) const;
 
+  /**
+   * Batched version of FindPositiveArrival(): calculates the results
+   * of all destinations in one traversal of the fan tree.
+   *
+   * @param results receives one result per destination
+   * @return false if there is no reach to search
+   */
+  bool FindPositiveArrival(const AGeoPoint *dests, unsigned n,
+                           const RoutePolars &rpolars,
+                           ReachResult *results) const;
+
   bool IsInside(const GeoPoint origin, const bool turning = true) const;
 
   void AcceptInRange(const GeoBounds& bounds,
@@ -63,6 +94,10 @@ public:
   RoughAltitude GetTerrainBase() const {
     return terrain_base;
   }
+
+  unsigned GetSerial() const {
+    return serial;
+  }
 };
 
 #endif
@@ -27,6 +27,7 @@
 
 class TaskProjection;
 class RasterMap;
+class ReachWorkers;
 
 struct ReachFanParms {
   const RoutePolars &rpolars;
@@ -38,16 +39,24 @@ struct ReachFanParms {
   unsigned vertex_counter;
   unsigned char set_depth;
 
+  /**
+   * If not NULL, the fans of each depth are filled in parallel by
+   * these workers.
+   */
+  ReachWorkers *workers;
+
   ReachFanParms(const RoutePolars& _rpolars,
                 const TaskProjection& _task_proj,
                 const short _terrain_base,
-                const RasterMap* _terrain=NULL):
+                const RasterMap* _terrain=NULL,
+                ReachWorkers *_workers=NULL):
     rpolars(_rpolars), task_proj(_task_proj), terrain(_terrain),
     terrain_base(_terrain_base),
     terrain_counter(0),
     fan_counter(0),
     vertex_counter(0),
-    set_depth(0) {};
+    set_depth(0),
+    workers(_workers) {};
 
   FlatGeoPoint reach_intercept(const int index, const AGeoPoint& ao) const {
     return rpolars.ReachIntercept(index, ao, terrain, task_proj);
@@ -0,0 +1,52 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_REACH_WORKERS_HPP
+#define XCSOAR_REACH_WORKERS_HPP
+
+/**
+ * Runs parts of the reach fan construction in parallel.  The engine
+ * has no threads of its own; the application implements this
+ * interface with a thread pool and passes it to ReachFan::Solve().
+ */
+class ReachWorkers {
+public:
+  class Job {
+  public:
+    /**
+     * Run one part of the job.  This is called concurrently in
+     * different threads, with different indexes.
+     *
+     * @param index the part number, 0 to n-1
+     * @param n the number of parts
+     */
+    virtual void Run(unsigned index, unsigned n) = 0;
+  };
+
+  /**
+   * Run all parts of the job, and wait until they are finished.
+   */
+  virtual void Run(Job &job) = 0;
+};
+
+#endif
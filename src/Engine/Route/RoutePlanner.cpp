@@ -29,6 +29,7 @@ RoutePlanner::RoutePlanner()
 #ifndef PLANNER_SET
   , unique_links(50000)
 #endif
+  , count_expanded(0), count_nodes(0)
 {
   Reset();
 }
@@ -54,6 +55,24 @@ RoutePlanner::Reset()
   ClearReach();
 }
 
+RoutePolars
+RoutePlanner::PrepareReach(const AGeoPoint &origin,
+                           const RoutePlannerConfig &config,
+                           const RoughAltitude h_ceiling) const
+{
+  RoutePolars polars = rpolars_reach;
+  polars.SetConfig(config, origin.altitude, h_ceiling);
+  return polars;
+}
+
+void
+RoutePlanner::SwapReach(ReachFan &other, const RoutePolars &polars)
+{
+  rpolars_reach = polars;
+  reach_polar_mode = polars.GetConfig().reach_polar_mode;
+  reach.Swap(other);
+}
+
 bool
 RoutePlanner::SolveReach(const AGeoPoint &origin,
                          const RoutePlannerConfig &config,
@@ -117,6 +136,7 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
   count_airspace = 0;
   count_terrain = 0;
   count_supressed = 0;
+  count_expanded = 0;
 
   bool retval = false;
   planner.Restart(start);
@@ -125,6 +145,7 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
 
   while (!planner.IsEmpty()) {
     const RoutePoint node = planner.Pop();
+    ++count_expanded;
 
     h_min = std::min(h_min, node.altitude);
     h_max = std::max(h_max, node.altitude);
@@ -162,6 +183,7 @@ RoutePlanner::Solve(const AGeoPoint &origin, const AGeoPoint &destination,
   }
 
   count_unique = unique_links.size();
+  count_nodes = planner.GetNodeCount();
 
   if (retval) {
     // correct solution for rounding
@@ -127,15 +127,27 @@ protected:
   RoughAltitude h_max;
 
 private:
-  struct CompareRoutePoint {
+  /**
+   * The A* nodes are identified by their location on the
+   * #task_projection grid; the altitude is not part of the key.
+   */
+  struct HashRoutePoint {
+    gcc_pure
+    unsigned operator()(const RoutePoint &p) const {
+      return (unsigned)p.longitude * 73856093u ^
+        (unsigned)p.latitude * 19349663u;
+    }
+  };
+
+  struct EqualRoutePoint {
     gcc_pure
     bool operator()(const RoutePoint &a, const RoutePoint &b) const {
-      return a.Sort(b);
+      return a.FlatGeoPoint::Equals(b);
     }
   };
 
   /** A* search algorithm */
-  AStar<RoutePoint, CompareRoutePoint> planner;
+  AStar<RoutePoint, HashRoutePoint, EqualRoutePoint> planner;
 
   /**
    * Convex hull of search to date, used by terrain node
@@ -169,6 +181,10 @@ private:
   mutable unsigned long count_dij;
   mutable unsigned long count_unique;
   mutable unsigned long count_supressed;
+  /** Number of nodes popped from the A* queue by the last solve */
+  unsigned long count_expanded;
+  /** Number of nodes stored by the A* search of the last solve */
+  unsigned long count_nodes;
 
 protected:
   RoutePoint astar_goal;
@@ -229,6 +245,27 @@ public:
   bool SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
                   RoughAltitude h_ceiling, bool do_solve=true);
 
+  /**
+   * Calculate the polars for a reach calculation, without modifying
+   * this object.  This allows solving a separate #ReachFan with the
+   * returned polars (e.g. in another thread), which is then
+   * installed with SwapReach().
+   *
+   * @param origin The start of the search (current aircraft location)
+   * @return the polars to be passed to ReachFan::Solve()
+   */
+  gcc_pure
+  RoutePolars PrepareReach(const AGeoPoint &origin,
+                           const RoutePlannerConfig &config,
+                           RoughAltitude h_ceiling) const;
+
+  /**
+   * Install reach fans which were solved elsewhere, together with
+   * the polars they were solved with (see PrepareReach()).  The old
+   * fans are moved to #other.
+   */
+  void SwapReach(ReachFan &other, const RoutePolars &polars);
+
   /** Visit reach */
   void AcceptInRange(const GeoBounds &bounds,
                      TriangleFanVisitor &visitor) const {
@@ -286,6 +323,25 @@ public:
     return reach.FindPositiveArrival(dest, rpolars_reach, result_r);
   }
 
+  /**
+   * Batched version of FindPositiveArrival(), which searches the
+   * reach fans only once for all destinations.
+   *
+   * @param results receives one result per destination
+   */
+  bool FindPositiveArrival(const AGeoPoint *dests, unsigned n,
+                           ReachResult *results) const {
+    return reach.FindPositiveArrival(dests, n, rpolars_reach, results);
+  }
+
+  /**
+   * Returns a number which changes each time the reach is solved
+   * again or cleared.
+   */
+  unsigned GetReachSerial() const {
+    return reach.GetSerial();
+  }
+
   RoughAltitude GetTerrainBase() const {
     return reach.GetTerrainBase();
   }
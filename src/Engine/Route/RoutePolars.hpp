@@ -172,6 +172,10 @@ public:
                  const RoughAltitude _cruise_alt = RoughAltitude::Max(),
                  const RoughAltitude _ceiling_alt = RoughAltitude::Max());
 
+  const RoutePlannerConfig &GetConfig() const {
+    return config;
+  }
+
   /**
    * Check whether the configuration requires intersection tests with airspace.
    *
@@ -305,6 +305,8 @@ AbstractTask::Reset()
   active_task_point_last = 0 - 1;
   ce_lpf.Reset(fixed(1));
   stats.reset();
+  best_mc_hint.Clear();
+  glide_required_hint.Clear();
 }
 
 fixed
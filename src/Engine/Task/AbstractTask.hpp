@@ -27,6 +27,7 @@
 #include "Stats/TaskStats.hpp"
 #include "TaskBehaviour.hpp"
 #include "Math/Filter.hpp"
+#include "Math/ZeroFinder.hpp"
 
 class TaskPointConstVisitor;
 class AbortTask;
@@ -55,6 +56,13 @@ protected:
   /** settings */
   TaskBehaviour task_behaviour;
 
+  /**
+   * The solutions of the previous CalcBestMC() and
+   * CalcRequiredGlide() searches, which start the next ones.  These
+   * are only a performance hint, therefore mutable.
+   */
+  mutable ZeroFinder::Hint best_mc_hint, glide_required_hint;
+
 private:
   /** low pass filter on best MC calculations */
   Filter mc_lpf;
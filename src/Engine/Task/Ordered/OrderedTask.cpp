@@ -818,6 +818,7 @@ OrderedTask::CalcRequiredGlide(const AircraftState &aircraft,
 {
   TaskGlideRequired bgr(task_points, active_task_point, aircraft,
                         task_behaviour.glide, glide_polar);
+  bgr.set_hint(glide_required_hint);
   return bgr.search(fixed(0));
 }
 
@@ -829,6 +830,7 @@ OrderedTask::CalcBestMC(const AircraftState &aircraft,
   // note setting of lower limit on mc
   TaskBestMc bmc(task_points, active_task_point, aircraft,
                  task_behaviour.glide, glide_polar);
+  bmc.set_hint(best_mc_hint);
   return bmc.search(glide_polar.GetMC(), best);
 }
 
@@ -896,6 +898,7 @@ OrderedTask::CalcMinTarget(const AircraftState &aircraft,
     TaskMinTarget bmt(task_points, active_task_point, aircraft,
                       task_behaviour.glide, glide_polar,
                       t_rem, taskpoint_start);
+    bmt.set_hint(min_target_hint);
     fixed p = bmt.search(fixed(0));
     return p;
   }
@@ -952,6 +955,7 @@ OrderedTask::Reset()
   ResetPoints(optional_start_points);
 
   AbstractTask::Reset();
+  min_target_hint.Clear();
   stats.task_finished = false;
   stats.task_started = false;
   task_advance.Reset();
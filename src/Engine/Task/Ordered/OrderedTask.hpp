@@ -85,6 +85,11 @@ private:
   TaskDijkstraMin *dijkstra_min;
   TaskDijkstraMax *dijkstra_max;
 
+  /**
+   * The solution of the previous CalcMinTarget() search.
+   */
+  ZeroFinder::Hint min_target_hint;
+
 public:
   /** 
    * Constructor.
@@ -72,9 +72,11 @@ TaskBestMc::search(const fixed mc)
   // only search if mc zero is valid
   f(fixed(0));
   if (valid(fixed(0))) {
-    fixed a = find_zero(mc);
-    if (valid(a))
+    fixed a = find_zero_tentative(mc);
+    if (valid(a)) {
+      commit_hint(a);
       return a;
+    }
   }
   return mc;
 }
@@ -85,8 +87,9 @@ TaskBestMc::search(const fixed mc, fixed& result)
   // only search if mc zero is valid
   f(fixed(0));
   if (valid(fixed(0))) {
-    fixed a = find_zero(mc);
+    fixed a = find_zero_tentative(mc);
     if (valid(a)) {
+      commit_hint(a);
       result = a;
       return true;
     }
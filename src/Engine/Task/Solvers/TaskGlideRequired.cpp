@@ -58,6 +58,8 @@ TaskGlideRequired::f(const fixed S)
 fixed
 TaskGlideRequired::search(const fixed S)
 {
-  fixed a = find_zero(S);
+  fixed a = find_zero_tentative(S);
+  if (res.IsOk())
+    commit_hint(a);
   return a/res.v_opt;
 }
@@ -68,12 +68,15 @@ TaskMinTarget::search(const fixed tp)
 
   force_current = false;
   /// @todo if search fails, force current
-  const fixed p = find_zero(tp);
+  const fixed p = find_zero_tentative(tp);
   if (valid(p)) {
+    commit_hint(p);
     return p;
   } else {
+    /* the forced search solves a different function, so its result
+       must not become the hint for the next unforced search */
     force_current = true;
-    return find_zero(tp);
+    return find_zero_tentative(tp);
   }
 }
 
@@ -90,6 +90,8 @@ public:
    */
   fixed search(const fixed p);
 
+  using ZeroFinder::set_hint;
+
 private:
   void set_range(const fixed p);
 };
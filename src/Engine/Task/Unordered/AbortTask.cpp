@@ -146,40 +146,65 @@ AbortTask::FillReachable(const AircraftState &state,
   reservable_priority_queue<Alternate, AlternateVector, AbortRank> q;
   q.reserve(32);
 
-  for (auto v = approx_waypoints.begin(); v != approx_waypoints.end();) {
-    if (only_airfield && !v->waypoint.IsAirport()) {
-      ++v;
+  /* first pass: solve the glide to each candidate, and collect those
+     which need a terrain intersection test, so they can be tested all
+     at once */
+  std::vector<bool> reachable(approx_waypoints.size(), false);
+  std::vector<AGeoPoint> test_destinations;
+  std::vector<unsigned> test_indices;
+
+  for (unsigned i = 0, n = approx_waypoints.size(); i < n; ++i) {
+    Alternate &v = approx_waypoints[i];
+    if (only_airfield && !v.waypoint.IsAirport())
       continue;
-    }
 
-    UnorderedTaskPoint t(v->waypoint, task_behaviour);
-    GlideResult result =
-        TaskSolution::GlideSolutionRemaining(t, state,
-                                             task_behaviour.glide, polar);
+    UnorderedTaskPoint t(v.waypoint, task_behaviour);
+    v.solution = TaskSolution::GlideSolutionRemaining(t, state,
+                                                      task_behaviour.glide,
+                                                      polar);
 
-    if (IsReachable(result, final_glide)) {
-      bool intersects = false;
-      const bool is_reachable_final = IsReachable(result, true);
+    if (!IsReachable(v.solution, final_glide))
+      continue;
 
-      if (intersection_test && final_glide && is_reachable_final)
-        intersects = intersection_test->Intersects(
-            AGeoPoint(v->waypoint.location, result.min_arrival_altitude));
+    reachable[i] = true;
 
-      if (!intersects) {
-        q.push(Alternate(v->waypoint, result));
-        // remove it since it's already in the list now      
-        approx_waypoints.erase(v);
+    if (intersection_test && final_glide && IsReachable(v.solution, true)) {
+      test_destinations.push_back(AGeoPoint(v.waypoint.location,
+                                            v.solution.min_arrival_altitude));
+      test_indices.push_back(i);
+    }
+  }
 
-        if (is_reachable_final)
-          found_final_glide = true;
+  if (!test_destinations.empty()) {
+    std::vector<bool> intersects;
+    intersection_test->Intersects(test_destinations, intersects);
+    assert(intersects.size() == test_indices.size());
 
-        continue; // skip incrementing v since we just erased it
-      }
-    } 
+    for (unsigned i = 0, n = test_indices.size(); i < n; ++i)
+      if (intersects[i])
+        reachable[test_indices[i]] = false;
+  }
 
-    ++v;
+  /* second pass: move the reachable candidates to the queue, and
+     keep the others for the next call */
+  auto keep = approx_waypoints.begin();
+  for (unsigned i = 0, n = approx_waypoints.size(); i < n; ++i) {
+    Alternate &v = approx_waypoints[i];
+
+    if (reachable[i]) {
+      q.push(Alternate(v.waypoint, v.solution));
+
+      if (IsReachable(v.solution, true))
+        found_final_glide = true;
+    } else {
+      if (&*keep != &v)
+        *keep = v;
+      ++keep;
+    }
   }
 
+  approx_waypoints.erase(keep, approx_waypoints.end());
+
   while (!q.empty() && !IsTaskFull()) {
     const Alternate top = q.top();
     task_points.emplace_back(top.waypoint, task_behaviour, top.solution);
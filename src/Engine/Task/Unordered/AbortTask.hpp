@@ -35,6 +35,19 @@ class Waypoints;
 class AbortIntersectionTest {
 public:
   virtual bool Intersects(const AGeoPoint& destination) = 0;
+
+  /**
+   * Batched version of Intersects().  The default implementation
+   * tests the destinations one by one.
+   *
+   * @param results receives one result per destination
+   */
+  virtual void Intersects(const std::vector<AGeoPoint> &destinations,
+                          std::vector<bool> &results) {
+    results.clear();
+    for (const auto &destination : destinations)
+      results.push_back(Intersects(destination));
+  }
 };
 
 /**
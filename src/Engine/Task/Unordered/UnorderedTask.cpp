@@ -45,6 +45,7 @@ UnorderedTask::CalcBestMC(const AircraftState &aircraft,
     return false;
   }
   TaskBestMc bmc(tp, aircraft, task_behaviour.glide, glide_polar);
+  bmc.set_hint(best_mc_hint);
   return bmc.search(glide_polar.GetMC(), best);
 }
 
@@ -63,6 +64,7 @@ UnorderedTask::CalcRequiredGlide(const AircraftState &aircraft,
     return fixed(0);
   }
   TaskGlideRequired bgr(tp, aircraft, task_behaviour.glide, glide_polar);
+  bgr.set_hint(glide_required_hint);
   return bgr.search(fixed(0));
 }
 
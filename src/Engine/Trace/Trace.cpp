@@ -24,18 +24,20 @@ Copyright_License {
 #include "Trace.hpp"
 #include "Vector.hpp"
 #include "Navigation/Aircraft.hpp"
-#include "Util/GlobalSliceAllocator.hpp"
 
 #include <algorithm>
 
 Trace::Trace(const unsigned _no_thin_time, const unsigned max_time,
              const unsigned max_size)
-  :chronological_list(ListHead::empty()),
+  :nodes(max_size), heap(max_size), heap_size(0),
+   first(null_index), last(null_index),
+   free_head(null_index), n_allocated(0),
    cached_size(0),
    max_time(max_time),
    no_thin_time(_no_thin_time),
    max_size(max_size),
-   opt_size((3 * max_size) / 4)
+   opt_size((3 * max_size) / 4),
+   average_delta_time(0), average_delta_distance(0)
 {
   assert(max_size >= 4);
 }
@@ -43,23 +45,43 @@ Trace::Trace(const unsigned _no_thin_time, const unsigned max_time,
 void
 Trace::clear()
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
-
   average_delta_distance = 0;
   average_delta_time = 0;
 
-  delta_list.clear();
-  chronological_list.Clear();
+  heap_size = 0;
+  first = last = null_index;
+  free_head = null_index;
+  n_allocated = 0;
   cached_size = 0;
 
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
-
   ++modify_serial;
   ++append_serial;
 }
 
+void
+Trace::CopyFrom(const Trace &other)
+{
+  assert(max_size == other.max_size);
+
+  std::copy_n(other.nodes.begin(), other.n_allocated, nodes.begin());
+  std::copy_n(other.heap.begin(), other.heap_size, heap.begin());
+
+  heap_size = other.heap_size;
+  first = other.first;
+  last = other.last;
+  free_head = other.free_head;
+  n_allocated = other.n_allocated;
+  cached_size = other.cached_size;
+
+  task_projection = other.task_projection;
+
+  average_delta_time = other.average_delta_time;
+  average_delta_distance = other.average_delta_distance;
+
+  append_serial = other.append_serial;
+  modify_serial = other.modify_serial;
+}
+
 unsigned
 Trace::GetRecentTime(const unsigned t) const
 {
@@ -73,53 +95,145 @@ Trace::GetRecentTime(const unsigned t) const
   return 0;
 }
 
+unsigned
+Trace::Allocate()
+{
+  if (free_head != null_index) {
+    const unsigned i = free_head;
+    free_head = nodes[i].next;
+    return i;
+  }
+
+  assert(n_allocated < max_size);
+  return n_allocated++;
+}
+
 void
-Trace::UpdateDelta(TraceDelta &td)
+Trace::Free(unsigned i)
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
+  assert(cached_size > 0);
 
-  if (chronological_list.IsEdge(td))
-    return;
+  TraceDelta &td = nodes[i];
+  assert(!td.IsQueued());
+
+  if (td.prev != null_index)
+    nodes[td.prev].next = td.next;
+  else
+    first = td.next;
+
+  if (td.next != null_index)
+    nodes[td.next].prev = td.prev;
+  else
+    last = td.prev;
 
-  const TraceDelta &previous = td.GetPrevious();
-  const TraceDelta &next = td.GetNext();
+  td.next = free_head;
+  free_head = i;
 
-  TraceDelta temp_td = td;
-  temp_td.SetDisconnected();
+  --cached_size;
+}
 
-  td.Replace(temp_td);
+void
+Trace::HeapSiftUp(unsigned pos)
+{
+  const unsigned i = heap[pos];
+  while (pos > 0) {
+    const unsigned parent = (pos - 1) / 2;
+    if (!HeapLess(i, heap[parent]))
+      break;
 
-  // erase old one
-  auto i = delta_list.find(td);
-  assert(i != delta_list.end());
-  delta_list.erase(i);
+    HeapSet(pos, heap[parent]);
+    pos = parent;
+  }
 
-  // insert new in sorted position
-  temp_td.Update(previous.point, next.point);
-  TraceDelta &new_td = Insert(temp_td);
-  new_td.SetDisconnected();
-  temp_td.Replace(new_td);
+  HeapSet(pos, i);
 }
 
 void
-Trace::EraseInside(TraceDelta::iterator it)
+Trace::HeapSiftDown(unsigned pos)
 {
-  assert(cached_size > 0);
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
-  assert(it != delta_list.end());
+  const unsigned i = heap[pos];
+  while (true) {
+    unsigned child = 2 * pos + 1;
+    if (child >= heap_size)
+      break;
+
+    if (child + 1 < heap_size && HeapLess(heap[child + 1], heap[child]))
+      ++child;
+
+    if (!HeapLess(heap[child], i))
+      break;
+
+    HeapSet(pos, heap[child]);
+    pos = child;
+  }
+
+  HeapSet(pos, i);
+}
+
+void
+Trace::HeapPush(unsigned i)
+{
+  assert(!nodes[i].IsQueued());
+  assert(heap_size < max_size);
+
+  HeapSet(heap_size, i);
+  HeapSiftUp(heap_size++);
+}
 
-  const TraceDelta &td = *it;
+void
+Trace::HeapRemove(unsigned i)
+{
+  assert(nodes[i].IsQueued());
+
+  const unsigned pos = nodes[i].heap_index;
+  nodes[i].heap_index = null_index;
+
+  if (pos == --heap_size)
+    return;
+
+  HeapSet(pos, heap[heap_size]);
+  HeapUpdate(heap[pos]);
+}
+
+void
+Trace::HeapUpdate(unsigned i)
+{
+  assert(nodes[i].IsQueued());
+
+  const unsigned pos = nodes[i].heap_index;
+  if (pos > 0 && HeapLess(i, heap[(pos - 1) / 2]))
+    HeapSiftUp(pos);
+  else
+    HeapSiftDown(pos);
+}
+
+void
+Trace::UpdateDelta(unsigned i)
+{
+  TraceDelta &td = nodes[i];
+  if (td.prev == null_index || td.next == null_index)
+    return;
+
+  td.Update(nodes[td.prev].point, nodes[td.next].point);
+
+  /* items which were set aside by EraseDelta() are not queued; they
+     will be pushed again when it is finished */
+  if (td.IsQueued())
+    HeapUpdate(i);
+}
+
+void
+Trace::EraseInside(unsigned i)
+{
+  const TraceDelta &td = nodes[i];
   assert(!td.IsEdge());
 
-  TraceDelta &previous = const_cast<TraceDelta &>(td.GetPrevious());
-  TraceDelta &next = const_cast<TraceDelta &>(td.GetNext());
+  const unsigned previous = td.prev, next = td.next;
 
   // now delete the item
-  td.RemoveConst();
-  delta_list.erase(it);
-  --cached_size;
+  if (td.IsQueued())
+    HeapRemove(i);
+  Free(i);
 
   // and update the deltas
   UpdateDelta(previous);
@@ -129,9 +243,6 @@ Trace::EraseInside(TraceDelta::iterator it)
 bool
 Trace::EraseDelta(const unsigned target_size, const unsigned recent)
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
-
   if (size() < 2)
     return false;
 
@@ -139,44 +250,53 @@ Trace::EraseDelta(const unsigned target_size, const unsigned recent)
 
   const unsigned recent_time = GetRecentTime(recent);
 
-  TraceDelta::iterator candidate = delta_list.begin();
-  while (size() > target_size) {
-    const TraceDelta &td = *candidate;
-    if (!td.IsEdge() && td.point.GetTime() < recent_time) {
+  /* points which are too recent remain too recent during this call;
+     take them out of the heap and re-queue them at the end */
+  while (size() > target_size && heap_size > 0) {
+    const unsigned candidate = heap[0];
+    const TraceDelta &td = nodes[candidate];
+    assert(!td.IsEdge());
+
+    if (td.point.GetTime() < recent_time) {
       EraseInside(candidate);
-      candidate = delta_list.begin(); // find new top
       modified = true;
     } else {
-      ++candidate;
       // suppressed removal, skip it.
+      HeapRemove(candidate);
     }
   }
 
+  /* the suppressed points are all at the end of the chronological
+     list */
+  if (!empty())
+    for (unsigned i = nodes[last].prev;
+         i != null_index && i != first &&
+           nodes[i].point.GetTime() >= recent_time;
+         i = nodes[i].prev)
+      if (!nodes[i].IsQueued())
+        HeapPush(i);
+
   return modified;
 }
 
 bool
 Trace::EraseEarlierThan(const unsigned p_time)
 {
-  if (p_time == 0 || empty() || GetFront().point.GetTime() >= p_time)
+  if (p_time == 0 || empty() || front().GetTime() >= p_time)
     // there will be nothing to remove
     return false;
 
   do {
-    TraceDelta &td = GetFront();
-    td.Remove();
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase(i);
-
-    --cached_size;
-  } while (!empty() && GetFront().point.GetTime() < p_time);
+    const unsigned i = first;
+    if (nodes[i].IsQueued())
+      HeapRemove(i);
+    Free(i);
+  } while (!empty() && front().GetTime() < p_time);
 
   // need to set deltas for first point, only one of these
   // will occur (have to search for this point)
   if (!empty())
-    EraseStart(GetFront());
+    EraseStart(first);
 
   ++modify_serial;
   ++append_serial;
@@ -189,61 +309,36 @@ Trace::EraseLaterThan(const unsigned min_time)
   assert(min_time > 0);
   assert(!empty());
 
-  while (!empty() && GetBack().point.GetTime() > min_time) {
-    TraceDelta &td = GetBack();
-
-    td.Remove();
-
-    auto i = delta_list.find(td);
-    assert(i != delta_list.end());
-    delta_list.erase(i);
-
-    --cached_size;
+  while (!empty() && back().GetTime() > min_time) {
+    const unsigned i = last;
+    if (nodes[i].IsQueued())
+      HeapRemove(i);
+    Free(i);
   }
 
   /* need to set deltas for first point, only one of these will occur
      (have to search for this point) */
   if (!empty())
-    EraseStart(GetBack());
-}
-
-Trace::TraceDelta &
-Trace::Insert(const TraceDelta &td) {
-  TraceDelta::iterator it = delta_list.insert(td);
-
-  /* std::set doesn't allow modification of an item, but we
-     override that */
-  TraceDelta &new_td = const_cast<TraceDelta &>(*it);
-  return new_td;
+    EraseStart(last);
 }
 
 /**
  * Update start node (and neighbour) after min time pruning
  */
 void
-Trace::EraseStart(TraceDelta &td_start) {
-  TraceDelta temp_td = td_start;
-  temp_td.SetDisconnected();
-  td_start.Replace(temp_td);
-
-  auto i_start = delta_list.find(td_start);
-  assert(i_start != delta_list.end());
-  delta_list.erase(i_start);
-
-  temp_td.elim_distance = null_delta;
-  temp_td.elim_time = null_time;
+Trace::EraseStart(unsigned i)
+{
+  TraceDelta &td = nodes[i];
+  if (td.IsQueued())
+    HeapRemove(i);
 
-  TraceDelta &new_td = Insert(temp_td);
-  new_td.SetDisconnected();
-  temp_td.Replace(new_td);
+  td.elim_distance = null_delta;
+  td.elim_time = null_time;
 }
 
 void
 Trace::push_back(const TracePoint &point)
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
-
   if (empty()) {
     // first point determines origin for flat projection
     task_projection.Reset(point.GetLocation());
@@ -271,14 +366,26 @@ Trace::push_back(const TracePoint &point)
 
   assert(size() < max_size);
 
-  TraceDelta &td = Insert(point);
+  const unsigned i = Allocate();
+  TraceDelta &td = nodes[i];
+  td = TraceDelta(point);
   td.point.Project(task_projection);
-  td.InsertBefore(chronological_list);
+
+  td.prev = last;
+  if (last != null_index)
+    nodes[last].next = i;
+  else
+    first = i;
+  last = i;
 
   ++cached_size;
 
-  if (!chronological_list.IsFirst(td))
-    UpdateDelta(td.GetPrevious());
+  /* the previous point is not an edge anymore, unless it is the
+     first one */
+  if (td.prev != null_index && td.prev != first) {
+    UpdateDelta(td.prev);
+    HeapPush(td.prev);
+  }
 
   ++append_serial;
 }
@@ -290,10 +397,10 @@ Trace::CalcAverageDeltaDistance(const unsigned no_thin) const
   unsigned acc = 0;
   unsigned counter = 0;
 
-  const ChronologicalConstIterator end = chronological_list.end();
-  for (ChronologicalConstIterator it = chronological_list.begin();
-       it != end && it->point.GetTime() < r; ++it, ++counter)
-    acc += it->delta_distance;
+  for (unsigned i = first;
+       i != null_index && nodes[i].point.GetTime() < r;
+       i = nodes[i].next, ++counter)
+    acc += nodes[i].delta_distance;
 
   if (counter)
     return acc / counter;
@@ -308,9 +415,9 @@ Trace::CalcAverageDeltaTime(const unsigned no_thin) const
   unsigned counter = 0;
 
   /* find the last item before the "r" timestamp */
-  const ChronologicalConstIterator end = chronological_list.end();
-  ChronologicalConstIterator it;
-  for (it = chronological_list.begin(); it != end && it->point.GetTime() < r; ++it)
+  const_iterator it = begin();
+  for (const const_iterator end = this->end();
+       it != end && it->GetTime() < r; ++it)
     ++counter;
 
   if (counter < 2)
@@ -320,7 +427,7 @@ Trace::CalcAverageDeltaTime(const unsigned no_thin) const
   --counter;
 
   unsigned start_time = front().GetTime();
-  unsigned end_time = it->point.GetTime();
+  unsigned end_time = it->GetTime();
   return (end_time - start_time) / counter;
 }
 
@@ -361,8 +468,6 @@ Trace::Thin2()
 void
 Trace::Thin()
 {
-  assert(cached_size == delta_list.size());
-  assert(cached_size == chronological_list.Count());
   assert(size() == max_size);
 
   Thin2();
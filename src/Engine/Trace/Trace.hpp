@@ -26,14 +26,12 @@ Copyright_License {
 
 #include "Point.hpp"
 #include "Util/NonCopyable.hpp"
-#include "Util/SliceAllocator.hpp"
-#include "Util/ListHead.hpp"
-#include "Util/CastIterator.hpp"
+#include "Util/AllocatedArray.hpp"
 #include "Util/Serial.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "Compiler.h"
 
-#include <set>
+#include <iterator>
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -50,10 +48,19 @@ class TracePointerVector;
  * the candidate point removed.  In this version, time differences is also a
  * secondary factor, such that thinning attempts to remove points such that,
  * for equal distance ranking, smaller time step details are removed first.
+ *
+ * All points live in one array ("slab") which is allocated by the
+ * constructor and never grows.  The chronological order is a doubly
+ * linked list of array indices, and the thinning candidates (all
+ * points except the first and the last one) are kept in a binary
+ * heap of array indices ordered by TraceDelta::DeltaRank().  Since
+ * points never move inside the slab, pointers obtained by
+ * GetPoints(TracePointerVector &) remain valid until the point is
+ * removed.
  */
 class Trace : private NonCopyable
 {
-  struct TraceDelta : public ListHead {
+  struct TraceDelta {
     /**
      * Function used to points for sorting by deltas.
      * Ranking is primarily by distance delta; for equal distances, rank by
@@ -85,40 +92,32 @@ class Trace : private NonCopyable
       return false;
     }
 
-    struct DeltaRankOp {
-      bool operator()(const TraceDelta &s1, const TraceDelta &s2) {
-        return DeltaRank(s1, s2);
-      }
-    };
-
-    /* using std::multiset, not because we need multiple values (we
-       don't), but to avoid std::set's overhead for duplicate
-       elimination */
-    typedef std::multiset<TraceDelta, DeltaRankOp,
-                          GlobalSliceAllocator<TraceDelta, 128u> > List;
-    typedef List::iterator iterator;
-    typedef List::const_iterator const_iterator;
-
     TracePoint point;
 
     unsigned elim_time;
     unsigned elim_distance;
     unsigned delta_distance;
 
+    /**
+     * Slab indices of the chronological neighbours, #null_index at
+     * the ends of the list.  For unused slots, #next links the free
+     * list.
+     */
+    unsigned prev, next;
+
+    /**
+     * Position of this item in the heap, #null_index if it is not
+     * queued.
+     */
+    unsigned heap_index;
+
+    TraceDelta() = default;
+
     TraceDelta(const TracePoint &p)
       :point(p),
        elim_time(null_time), elim_distance(null_delta),
-       delta_distance(0) {}
-
-    TraceDelta(const TracePoint &p_last, const TracePoint &p,
-               const TracePoint &p_next)
-      :point(p),
-       elim_time(TimeMetric(p_last, p, p_next)),
-       elim_distance(DistanceMetric(p_last, p, p_next)),
-       delta_distance(p.FlatDistanceTo(p_last))
-    {
-      assert(elim_distance != null_delta);
-    }
+       delta_distance(0),
+       prev(null_index), next(null_index), heap_index(null_index) {}
 
     /**
      * Is this the first or the last point?
@@ -127,20 +126,8 @@ class Trace : private NonCopyable
       return elim_time == null_time;
     }
 
-    TraceDelta &GetPrevious() {
-      return *(TraceDelta *)ListHead::GetPrevious();
-    }
-
-    TraceDelta &GetNext() {
-      return *(TraceDelta *)ListHead::GetNext();
-    }
-
-    const TraceDelta &GetPrevious() const {
-      return *(const TraceDelta *)ListHead::GetPrevious();
-    }
-
-    const TraceDelta &GetNext() const {
-      return *(const TraceDelta *)ListHead::GetNext();
+    bool IsQueued() const {
+      return heap_index != null_index;
     }
 
     void Update(const TracePoint &p_last, const TracePoint &p_next) {
@@ -186,10 +173,34 @@ class Trace : private NonCopyable
     }
   };
 
-  typedef CastIterator<const TraceDelta, ListHead::const_iterator> ChronologicalConstIterator;
+  /**
+   * The slab containing all points.  Its size is #max_size.
+   */
+  AllocatedArray<TraceDelta> nodes;
+
+  /**
+   * A binary min-heap of slab indices, ordered by
+   * TraceDelta::DeltaRank().  Its capacity is #max_size.
+   */
+  AllocatedArray<unsigned> heap;
+  unsigned heap_size;
+
+  /**
+   * Slab indices of the oldest and the newest point, #null_index if
+   * the trace is empty.
+   */
+  unsigned first, last;
+
+  /**
+   * Head of the list of unused slots below #n_allocated.
+   */
+  unsigned free_head;
+
+  /**
+   * Number of slots that have ever been used since the last clear().
+   */
+  unsigned n_allocated;
 
-  TraceDelta::List delta_list;
-  ListHead chronological_list;
   unsigned cached_size;
 
   TaskProjection task_projection;
@@ -230,25 +241,20 @@ protected:
   unsigned GetRecentTime(const unsigned t) const;
 
   /**
-   * Update delta values for specified item in the delta list and the
-   * tree.  This repositions the item after into its sorted position.
+   * Update delta values for the specified item and reposition it in
+   * the heap.  Edge items are not modified.
    *
-   * @param it Item to update
-   * @param tree Tree containing leaf
-   *
-   * @return Iterator to updated item
+   * @param i Slab index of the item to update
    */
-  void UpdateDelta(TraceDelta &td);
+  void UpdateDelta(unsigned i);
 
   /**
-   * Erase a non-edge item from delta list and tree, updating
-   * deltas in the process.  This Invalidates the calling iterator.
-   *
-   * @param it Item to erase
-   * @param tree Tree to remove from
+   * Erase a non-edge item, updating the deltas of its neighbours in
+   * the process.
    *
+   * @param i Slab index of the item to erase
    */
-  void EraseInside(TraceDelta::iterator it);
+  void EraseInside(unsigned i);
 
   /**
    * Erase elements based on delta metric until the size is
@@ -259,7 +265,6 @@ protected:
    * fail to set the target size.
    *
    * @param target_size Size of desired list.
-   * @param tree Tree to remove from
    * @param recent Time window for which to not remove points
    *
    * @return True if items were erased
@@ -268,11 +273,10 @@ protected:
                   const unsigned recent = 0);
 
   /**
-   * Erase elements older than specified time from delta and tree,
-   * and update earliest item to become the new start
+   * Erase elements older than specified time, and update earliest
+   * item to become the new start
    *
    * @param p_time Time to remove
-   * @param tree Tree to remove from
    *
    * @return True if items were erased
    */
@@ -284,12 +288,40 @@ protected:
    */
   void EraseLaterThan(const unsigned min_time);
 
-  TraceDelta &Insert(const TraceDelta &td);
+  /**
+   * Turn the specified item into an edge after its neighbour has
+   * been erased: remove it from the heap and clear its elimination
+   * metrics.
+   */
+  void EraseStart(unsigned i);
+
+private:
+  /**
+   * Obtain an unused slab slot.
+   */
+  unsigned Allocate();
 
   /**
-   * Update start node (and neighbour) after min time pruning
+   * Unlink the specified item from the chronological list and
+   * return its slot to the free list.  It must not be queued.
    */
-  void EraseStart(TraceDelta &td_start);
+  void Free(unsigned i);
+
+  void HeapPush(unsigned i);
+  void HeapRemove(unsigned i);
+  void HeapUpdate(unsigned i);
+  void HeapSiftUp(unsigned pos);
+  void HeapSiftDown(unsigned pos);
+
+  void HeapSet(unsigned pos, unsigned i) {
+    heap[pos] = i;
+    nodes[i].heap_index = pos;
+  }
+
+  gcc_pure
+  bool HeapLess(unsigned a, unsigned b) const {
+    return TraceDelta::DeltaRank(nodes[a], nodes[b]);
+  }
 
 public:
   /**
@@ -305,6 +337,16 @@ public:
    */
   void clear();
 
+  /**
+   * Replace the contents of this object with a copy of another
+   * #Trace with the same maximum size, including its serials.  Slab
+   * indices are preserved, therefore pointers obtained from this
+   * object before remain valid for all points which were not
+   * removed from the other one.  This is meant for read-only
+   * snapshots which are used by another thread.
+   */
+  void CopyFrom(const Trace &other);
+
   void EraseEarlierThan(fixed time) {
     EraseEarlierThan((unsigned)time);
   }
@@ -388,13 +430,13 @@ public:
   const TracePoint &front() const {
     assert(!empty());
 
-    return static_cast<const TraceDelta *>(chronological_list.GetNext())->point;
+    return nodes[first].point;
   }
 
   const TracePoint &back() const {
     assert(!empty());
 
-    return static_cast<const TraceDelta *>(chronological_list.GetPrevious())->point;
+    return nodes[last].point;
   }
 
 private:
@@ -421,18 +463,6 @@ private:
    */
   void Thin();
 
-  TraceDelta &GetFront() {
-    assert(!empty());
-
-    return *static_cast<TraceDelta *>(chronological_list.GetNext());
-  }
-
-  TraceDelta &GetBack() {
-    assert(!empty());
-
-    return *static_cast<TraceDelta *>(chronological_list.GetPrevious());
-  }
-
   gcc_pure
   unsigned CalcAverageDeltaDistance(const unsigned no_thin) const;
 
@@ -440,6 +470,7 @@ private:
   unsigned CalcAverageDeltaTime(const unsigned no_thin) const;
 
   static const unsigned null_delta = 0 - 1;
+  static const unsigned null_index = 0 - 1;
 
 public:
   static const unsigned null_time = 0 - 1;
@@ -456,13 +487,14 @@ public:
   class const_iterator {
     friend class Trace;
 
-    ListHead::const_iterator iterator;
+    const Trace *trace;
+    unsigned index;
 
-    const_iterator(ListHead::const_iterator _iterator)
-      :iterator(_iterator) {}
+    const_iterator(const Trace &_trace, unsigned _index)
+      :trace(&_trace), index(_index) {}
 
   public:
-    typedef ListHead::const_iterator::iterator_category iterator_category;
+    typedef std::bidirectional_iterator_tag iterator_category;
     typedef ptrdiff_t difference_type;
     typedef const TracePoint value_type;
     typedef const TracePoint *pointer;
@@ -471,79 +503,79 @@ public:
     const_iterator() = default;
 
     const TracePoint &operator*() const {
-      const TraceDelta &td = (const TraceDelta &)*iterator;
-      return td.point;
+      return trace->nodes[index].point;
     }
 
     const TracePoint *operator->() const {
-      const TraceDelta &td = (const TraceDelta &)*iterator;
-      return &td.point;
+      return &trace->nodes[index].point;
     }
 
     const_iterator &operator++() {
-      ++iterator;
+      index = trace->nodes[index].next;
       return *this;
     }
 
     const_iterator operator++(int) {
       const_iterator old = *this;
-      iterator++;
+      ++*this;
       return old;
     }
 
     const_iterator &operator--() {
-      --iterator;
+      index = index == null_index
+        ? trace->last
+        : trace->nodes[index].prev;
       return *this;
     }
 
     const_iterator operator--(int) {
       const_iterator old = *this;
-      iterator--;
+      --*this;
       return old;
     }
 
     const_iterator &NextSquareRange(unsigned sq_resolution,
                                     const const_iterator &end) {
-      const TracePoint &previous = ((const TraceDelta &)*iterator).point;
+      const TracePoint &previous = trace->nodes[index].point;
       while (true) {
-        ++iterator;
+        ++*this;
 
-        if (iterator == end.iterator)
+        if (*this == end)
           return *this;
 
-        const TraceDelta &td = (const TraceDelta &)*iterator;
-        if (td.point.FlatSquareDistanceTo(previous) >= sq_resolution)
+        if ((*this)->FlatSquareDistanceTo(previous) >= sq_resolution)
           return *this;
       }
     }
 
     bool operator==(const const_iterator &other) const {
-      return iterator == other.iterator;
+      return index == other.index;
     }
 
     bool operator!=(const const_iterator &other) const {
-      return iterator != other.iterator;
+      return index != other.index;
     }
   };
 
   const_iterator begin() const {
-    return chronological_list.begin();
+    return const_iterator(*this, first);
   }
 
   const_iterator end() const {
-    return chronological_list.end();
+    return const_iterator(*this, null_index);
   }
 
   class const_reverse_iterator {
     friend class Trace;
 
-    ListHead::const_reverse_iterator iterator;
+    const Trace *trace;
+    unsigned index;
 
-    const_reverse_iterator(ListHead::const_reverse_iterator _iterator)
-      :iterator(_iterator) {}
+    const_reverse_iterator(const Trace &_trace, unsigned _index)
+      :trace(&_trace), index(_index) {}
 
   public:
-    typedef std::forward_iterator_tag iterator_category;
+    typedef std::bidirectional_iterator_tag iterator_category;
     typedef ptrdiff_t difference_type;
     typedef const TracePoint value_type;
     typedef const TracePoint *pointer;
@@ -552,52 +584,52 @@ public:
     const_reverse_iterator() = default;
 
     const TracePoint &operator*() const {
-      const TraceDelta &td = (const TraceDelta &)*iterator;
-      return td.point;
+      return trace->nodes[index].point;
     }
 
     const TracePoint *operator->() const {
-      const TraceDelta &td = (const TraceDelta &)*iterator;
-      return &td.point;
+      return &trace->nodes[index].point;
     }
 
     const_reverse_iterator &operator++() {
-      ++iterator;
+      index = trace->nodes[index].prev;
       return *this;
     }
 
     const_reverse_iterator operator++(int) {
       const_reverse_iterator old = *this;
-      iterator++;
+      ++*this;
       return old;
     }
 
     const_reverse_iterator &operator--() {
-      --iterator;
+      index = index == null_index
+        ? trace->first
+        : trace->nodes[index].next;
       return *this;
     }
 
     const_reverse_iterator operator--(int) {
       const_reverse_iterator old = *this;
-      iterator--;
+      --*this;
       return old;
     }
 
     bool operator==(const const_reverse_iterator &other) const {
-      return iterator == other.iterator;
+      return index == other.index;
     }
 
     bool operator!=(const const_reverse_iterator &other) const {
-      return iterator != other.iterator;
+      return index != other.index;
     }
   };
 
   const_reverse_iterator rbegin() const {
-    return chronological_list.rbegin();
+    return const_reverse_iterator(*this, last);
   }
 
   const_reverse_iterator rend() const {
-    return chronological_list.rend();
+    return const_reverse_iterator(*this, null_index);
   }
 
   const TaskProjection &GetProjection() const {
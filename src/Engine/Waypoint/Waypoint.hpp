@@ -24,6 +24,7 @@
 #define WAYPOINT_HPP
 
 #include "Util/tstring.hpp"
+#include "Util/InternedString.hpp"
 #include "Util/DebugFlag.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Geo/Flat/FlatGeoPoint.hpp"
@@ -116,9 +117,9 @@ struct Waypoint {
   int8_t file_num;
 
   /** Name of waypoint */
-  tstring name;
+  InternedString name;
   /** Additional comment text for waypoint */
-  tstring comment;
+  InternedString comment;
   /** Airfield or additional (long) details */
   tstring details;
   /** Additional files to be displayed in the WayointDetails dialog */
@@ -366,7 +366,7 @@ Waypoints::Create(const GeoPoint &location)
 const Waypoint &
 Waypoints::CheckExistsOrAppend(const Waypoint &waypoint)
 {
-  const Waypoint* found = LookupName(waypoint.name);
+  const Waypoint* found = LookupName(waypoint.name.c_str());
   if (found && found->IsCloseTo(waypoint.location, fixed(100))) {
     return *found;
   }
@@ -28,6 +28,7 @@ Copyright_License {
 #include "FLARM/Version.hpp"
 #include "FLARM/Status.hpp"
 #include "FLARM/List.hpp"
+#include "Util/TypeTraits.hpp"
 
 #include <type_traits>
 
@@ -69,6 +70,7 @@ struct FlarmData {
   }
 };
 
-static_assert(std::is_trivial<FlarmData>::value, "type is not trivial");
+static_assert(has_trivial_constructor_and_destructor<FlarmData>::value,
+              "type is not trivial");
 
 #endif
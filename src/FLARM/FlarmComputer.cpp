@@ -156,4 +156,7 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
         traffic.speed = last_traffic->speed;
     }
   }
+
+  // sort the traffic by distance for the map and radar renderers
+  flarm.traffic.UpdateIndex();
 }
@@ -64,6 +64,14 @@ public:
     return value < other.value;
   }
 
+  /**
+   * Returns a number which identifies this object, for use as a hash
+   * key.
+   */
+  uint32_t GetHashKey() const {
+    return value;
+  }
+
   static FlarmId Parse(const char *input, char **endptr_r);
 #ifdef _UNICODE
   static FlarmId Parse(const TCHAR *input, TCHAR **endptr_r);
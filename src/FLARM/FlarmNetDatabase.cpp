@@ -24,6 +24,8 @@ Copyright_License {
 #include "FlarmNetDatabase.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
+
 #include <assert.h>
 
 void
@@ -34,21 +36,103 @@ FlarmNetDatabase::Insert(const FlarmNetRecord &record)
     /* ignore malformed records */
     return;
 
-  map.insert(std::make_pair(id, record));
+  records.push_back(record);
+  ids.push_back(id);
+  dirty = true;
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+void
+FlarmNetDatabase::Optimise()
 {
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (!dirty)
+    return;
+
+  dirty = false;
+
+  const unsigned n = records.size();
+
+  /* sort a permutation, stable to keep the first of several records
+     with the same id */
+  std::vector<unsigned> order(n);
+  for (unsigned i = 0; i < n; ++i)
+    order[i] = i;
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  std::stable_sort(order.begin(), order.end(),
+                   [this](unsigned a, unsigned b) {
+                     return ids[a] < ids[b];
+                   });
+
+  RecordVector sorted_records;
+  std::vector<FlarmId> sorted_ids;
+  sorted_records.reserve(n);
+  sorted_ids.reserve(n);
+
+  for (unsigned i : order) {
+    if (!sorted_ids.empty() && sorted_ids.back() == ids[i])
+      /* duplicate id */
+      continue;
+
+    sorted_records.push_back(records[i]);
+    sorted_ids.push_back(ids[i]);
   }
 
-  return NULL;
+  sorted_records.shrink_to_fit();
+  sorted_ids.shrink_to_fit();
+  records.swap(sorted_records);
+  ids.swap(sorted_ids);
+
+  /* the records are already sorted by id, so a stable sort orders
+     equal callsigns by id */
+  callsign_index.resize(records.size());
+  for (unsigned i = 0; i < callsign_index.size(); ++i)
+    callsign_index[i] = i;
+
+  std::stable_sort(callsign_index.begin(), callsign_index.end(),
+                   [this](unsigned a, unsigned b) {
+                     return _tcscmp(records[a].callsign,
+                                    records[b].callsign) < 0;
+                   });
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindRecordById(FlarmId id) const
+{
+  assert(!dirty);
+
+  auto i = std::lower_bound(ids.begin(), ids.end(), id);
+  return i != ids.end() && *i == id
+    ? &records[i - ids.begin()]
+    : NULL;
+}
+
+FlarmNetDatabase::IndexRange
+FlarmNetDatabase::FindCallSign(const TCHAR *cn) const
+{
+  assert(!dirty);
+
+  struct Compare {
+    const RecordVector &records;
+
+    bool operator()(unsigned a, const TCHAR *b) const {
+      return _tcscmp(records[a].callsign, b) < 0;
+    }
+
+    bool operator()(const TCHAR *a, unsigned b) const {
+      return _tcscmp(a, records[b].callsign) < 0;
+    }
+  };
+
+  return std::equal_range(callsign_index.begin(), callsign_index.end(),
+                          cn, Compare{records});
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+{
+  const IndexRange range = FindCallSign(cn);
+  return range.first != range.second
+    ? &records[*range.first]
+    : NULL;
 }
 
 unsigned
@@ -58,13 +142,9 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  const IndexRange range = FindCallSign(cn);
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = &records[*i];
 
   return count;
 }
@@ -75,13 +155,9 @@ FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = i.first;
-  }
+  const IndexRange range = FindCallSign(cn);
+  for (auto i = range.first; i != range.second && count < size; ++i)
+    array[count++] = ids[*i];
 
   return count;
 }
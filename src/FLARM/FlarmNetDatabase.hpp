@@ -28,7 +28,7 @@ Copyright_License {
 #include "FlarmNetRecord.hpp"
 #include "Compiler.h"
 
-#include <map>
+#include <vector>
 #include <tchar.h>
 
 class NLineReader;
@@ -36,34 +36,75 @@ class FlarmId;
 
 /**
  * An in-memory representation of the FlarmNet.org database.
+ *
+ * The records are stored in a contiguous array sorted by FLARM id,
+ * with a secondary index sorted by callsign; both are searched with
+ * a binary search.  After inserting records, call Optimise() to
+ * rebuild the sort order before doing any lookups.
  */
 class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+  typedef std::vector<FlarmNetRecord> RecordVector;
+
+  /**
+   * The records, sorted by #ids after Optimise().
+   */
+  RecordVector records;
+
+  /**
+   * The FLARM id of each element of #records.  This duplicates the
+   * (textual) id of the record in a form which is cheap to compare.
+   */
+  std::vector<FlarmId> ids;
+
+  /**
+   * Indices of #records, sorted by callsign (and by id within equal
+   * callsigns).
+   */
+  std::vector<unsigned> callsign_index;
+
+  /**
+   * Have records been inserted since the last Optimise() call?
+   */
+  bool dirty;
 
 public:
+  FlarmNetDatabase():dirty(false) {}
+
   bool IsEmpty() const {
-    return map.empty();
+    return records.empty();
+  }
+
+  unsigned GetCount() const {
+    return records.size();
   }
 
   void Clear() {
-    map.clear();
+    records.clear();
+    ids.clear();
+    callsign_index.clear();
+    dirty = false;
   }
 
+  /**
+   * Append a record.  It will not be found before Optimise() is
+   * called.
+   */
   void Insert(const FlarmNetRecord &record);
 
+  /**
+   * Sort the records inserted since the last call and rebuild the
+   * callsign index.  Of several records with the same FLARM id, only
+   * the first one inserted is kept.
+   */
+  void Optimise();
+
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
    * @param id FLARM id
    * @return FLARMNetRecord object
    */
   gcc_pure
-  const FlarmNetRecord *FindRecordById(FlarmId id) const {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmNetRecord *FindRecordById(FlarmId id) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -79,13 +120,24 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
 
-  RecordMap::const_iterator begin() const {
-    return map.begin();
+  RecordVector::const_iterator begin() const {
+    return records.begin();
   }
 
-  RecordMap::const_iterator end() const {
-    return map.end();
+  RecordVector::const_iterator end() const {
+    return records.end();
   }
+
+private:
+  typedef std::pair<std::vector<unsigned>::const_iterator,
+                    std::vector<unsigned>::const_iterator> IndexRange;
+
+  /**
+   * Returns the range of #callsign_index whose records have the
+   * given callsign.
+   */
+  gcc_pure
+  IndexRange FindCallSign(const TCHAR *cn) const;
 };
 
 #endif
@@ -23,20 +23,150 @@ Copyright_License {
 
 #include "List.hpp"
 
+#include <assert.h>
+
+TrafficList &
+TrafficList::operator=(const TrafficList &other)
+{
+  new_traffic = other.new_traffic;
+
+  list.resize(other.list.size());
+  std::copy(other.list.begin(), other.list.end(), list.begin());
+  std::copy(other.id_table, other.id_table + ID_TABLE_SIZE, id_table);
+
+  index_valid = other.index_valid;
+  if (index_valid) {
+    std::copy(other.by_distance, other.by_distance + list.size(),
+              by_distance);
+    std::copy(other.ring_start, other.ring_start + N_RINGS + 1, ring_start);
+    n_alarms = other.n_alarms;
+    std::copy(other.alarms, other.alarms + n_alarms, alarms);
+  }
+
+  return *this;
+}
+
+unsigned
+TrafficList::FindIdSlot(FlarmId id) const
+{
+  for (unsigned slot = GetIdHash(id);; slot = (slot + 1) % ID_TABLE_SIZE) {
+    const unsigned i = id_table[slot];
+    if (i == 0 || list[i - 1].id == id)
+      return slot;
+  }
+}
+
+int
+TrafficList::FindIndex(FlarmId id) const
+{
+  const unsigned i = id_table[FindIdSlot(id)];
+  return (int)i - 1;
+}
+
+void
+TrafficList::RemoveId(FlarmId id)
+{
+  unsigned hole = FindIdSlot(id);
+  assert(id_table[hole] != 0);
+
+  /* backward shift deletion: move following entries of the cluster
+     into the hole unless their home slot lies between the hole and
+     their current slot */
+  for (unsigned slot = (hole + 1) % ID_TABLE_SIZE; id_table[slot] != 0;
+       slot = (slot + 1) % ID_TABLE_SIZE) {
+    const unsigned home = GetIdHash(list[id_table[slot] - 1].id);
+    const unsigned distance_home = (slot - home) % ID_TABLE_SIZE;
+    const unsigned distance_hole = (slot - hole) % ID_TABLE_SIZE;
+    if (distance_home >= distance_hole) {
+      id_table[hole] = id_table[slot];
+      hole = slot;
+    }
+  }
+
+  id_table[hole] = 0;
+}
+
+void
+TrafficList::Remove(unsigned i)
+{
+  assert(i < list.size());
+
+  RemoveId(list[i].id);
+
+  const unsigned last = list.size() - 1;
+  if (i != last)
+    /* the last item is moved into the gap */
+    id_table[FindIdSlot(list[last].id)] = i + 1;
+
+  list.quick_remove(i);
+  index_valid = false;
+}
+
+void
+TrafficList::Expire(fixed clock)
+{
+  new_traffic.Expire(clock, fixed(60));
+
+  for (unsigned i = list.size(); i-- > 0;)
+    if (!list[i].Refresh(clock))
+      Remove(i);
+}
+
+FlarmTraffic *
+TrafficList::AllocateTraffic(FlarmId id)
+{
+  if (list.full())
+    return NULL;
+
+  const unsigned slot = FindIdSlot(id);
+  assert(id_table[slot] == 0);
+
+  FlarmTraffic &traffic = list.append();
+  traffic.Clear();
+  traffic.id = id;
+  id_table[slot] = list.size();
+  index_valid = false;
+  return &traffic;
+}
+
+void
+TrafficList::UpdateIndex()
+{
+  /* counting sort by distance ring */
+  std::fill(ring_start, ring_start + N_RINGS + 1, 0);
+  for (const auto &traffic : list)
+    ++ring_start[GetRing(traffic.distance) + 1];
+
+  for (unsigned r = 0; r < N_RINGS; ++r)
+    ring_start[r + 1] += ring_start[r];
+
+  uint16_t fill[N_RINGS];
+  std::copy(ring_start, ring_start + N_RINGS, fill);
+  for (unsigned i = 0; i < list.size(); ++i)
+    by_distance[fill[GetRing(list[i].distance)]++] = i;
+
+  n_alarms = 0;
+  for (unsigned j = 0; j < list.size(); ++j)
+    if (list[by_distance[j]].HasAlarm())
+      alarms[n_alarms++] = by_distance[j];
+
+  index_valid = true;
+}
+
 const FlarmTraffic *
 TrafficList::FindMaximumAlert() const
 {
   const FlarmTraffic *alert = NULL;
 
-  for (const auto &traffic : list)
-    if (traffic.HasAlarm() &&
-        (alert == NULL ||
-         ((unsigned)traffic.alarm_level > (unsigned)alert->alarm_level ||
-          (traffic.alarm_level == alert->alarm_level &&
-           /* if the levels match -> let the distance decide (smaller
-              distance wins) */
-           traffic.distance < alert->distance))))
-      alert = &traffic;
+  VisitAlarms([&alert](const FlarmTraffic &traffic, unsigned) {
+      if (alert == NULL ||
+          ((unsigned)traffic.alarm_level > (unsigned)alert->alarm_level ||
+           (traffic.alarm_level == alert->alarm_level &&
+            /* if the levels match -> let the distance decide (smaller
+               distance wins) */
+            traffic.distance < alert->distance)))
+        alert = &traffic;
+    });
 
   return alert;
 }
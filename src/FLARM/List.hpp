@@ -27,15 +27,50 @@ Copyright_License {
 #include "Traffic.hpp"
 #include "NMEA/Validity.hpp"
 #include "Util/TrivialArray.hpp"
+#include "Util/TypeTraits.hpp"
+#include "Compiler.h"
 
+#include <algorithm>
 #include <type_traits>
 
+#include <stdint.h>
+
 /**
  * This class keeps track of the traffic objects received from a
  * FLARM.
+ *
+ * Traffic objects are looked up by FLARM id with a hash table.  In
+ * addition, UpdateIndex() sorts the traffic into rings of equal
+ * width around the aircraft, which allows VisitWithin() and
+ * VisitAlarms() to skip the traffic far away.  This index becomes
+ * stale whenever the list is modified (through AllocateTraffic(),
+ * the non-const FindTraffic() methods or Expire()); the Visit
+ * methods then fall back to visiting all traffic.
+ *
+ * The class is copied with #NMEAInfo between the blackboards, so all
+ * indexes are stored as array positions.  Copying only transfers the
+ * used part of the arrays, because the capacity is much larger than
+ * the usual amount of traffic.
  */
 struct TrafficList {
-  static constexpr size_t MAX_COUNT = 25;
+  static constexpr size_t MAX_COUNT = 256;
+
+  /**
+   * The number of slots in the id hash table; a power of two, at
+   * least twice #MAX_COUNT.
+   */
+  static constexpr unsigned ID_TABLE_SIZE = 512;
+
+  /**
+   * The number of distance rings of the index.  The last ring
+   * contains all traffic beyond (N_RINGS - 1) * RING_WIDTH.
+   */
+  static constexpr unsigned N_RINGS = 16;
+
+  /**
+   * The width of a distance ring [m].
+   */
+  static constexpr unsigned RING_WIDTH = 1000;
 
   /**
    * When was the last new traffic received?
@@ -45,9 +80,44 @@ struct TrafficList {
   /** Flarm traffic information */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * Open addressing hash table (linear probing) which maps the FLARM
+   * id to the position in #list plus one; zero means "empty slot".
+   */
+  uint16_t id_table[ID_TABLE_SIZE];
+
+  /**
+   * The positions in #list, ordered by distance ring.  Ring r
+   * contains by_distance[ring_start[r]] to
+   * by_distance[ring_start[r + 1] - 1].
+   */
+  uint16_t by_distance[MAX_COUNT];
+  uint16_t ring_start[N_RINGS + 1];
+
+  /**
+   * The positions of all traffic with an alarm, ordered by distance.
+   */
+  uint16_t alarms[MAX_COUNT];
+  uint16_t n_alarms;
+
+  /**
+   * Are #by_distance and #alarms up to date?
+   */
+  bool index_valid;
+
+  TrafficList() = default;
+
+  TrafficList(const TrafficList &other) {
+    *this = other;
+  }
+
+  TrafficList &operator=(const TrafficList &other);
+
   void Clear() {
     new_traffic.Clear();
     list.clear();
+    ClearIdTable();
+    index_valid = false;
   }
 
   bool IsEmpty() const {
@@ -63,30 +133,26 @@ struct TrafficList {
       *this = add;
   }
 
-  void Expire(fixed clock) {
-    new_traffic.Expire(clock, fixed(60));
-
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
-        list.quick_remove(i);
-  }
+  void Expire(fixed clock);
 
   unsigned GetActiveTrafficCount() const {
     return list.size();
   }
 
   /**
-   * Looks up an item in the traffic list.
+   * Looks up an item in the traffic list.  The caller may modify the
+   * item, therefore this invalidates the distance index.
    *
    * @param id FLARM id
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   FlarmTraffic *FindTraffic(FlarmId id) {
-    for (auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
+    const int i = FindIndex(id);
+    if (i < 0)
+      return NULL;
 
-    return NULL;
+    index_valid = false;
+    return &list[i];
   }
 
   /**
@@ -96,23 +162,26 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   const FlarmTraffic *FindTraffic(FlarmId id) const {
-    for (const auto &traffic : list)
-      if (traffic.id == id)
-        return &traffic;
-
-    return NULL;
+    const int i = FindIndex(id);
+    return i >= 0
+      ? &list[i]
+      : NULL;
   }
 
   /**
-   * Looks up an item in the traffic list.
+   * Looks up an item in the traffic list.  The caller may modify the
+   * item, therefore this invalidates the distance index.
    *
    * @param name the name or call sign
    * @return the FLARM_TRAFFIC pointer, NULL if not found
    */
   FlarmTraffic *FindTraffic(const TCHAR *name) {
-    for (auto &traffic : list)
-      if (traffic.name.equals(name))
+    for (auto &traffic : list) {
+      if (traffic.name.equals(name)) {
+        index_valid = false;
         return &traffic;
+      }
+    }
 
     return NULL;
   }
@@ -132,15 +201,13 @@ struct TrafficList {
   }
 
   /**
-   * Allocates a new FLARM_TRAFFIC object from the array.
+   * Allocates a new FLARM_TRAFFIC object from the array, and
+   * initialises it with the given id.  The caller must have checked
+   * that the id is not yet in the list.
    *
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
-  FlarmTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
-  }
+  FlarmTraffic *AllocateTraffic(FlarmId id);
 
   /**
    * Search for the previous traffic in the ordered list.
@@ -183,8 +250,102 @@ struct TrafficList {
   unsigned TrafficIndex(const FlarmTraffic *t) const {
     return t - list.begin();
   }
+
+  /**
+   * Rebuild the distance index from FlarmTraffic::distance and
+   * FlarmTraffic::alarm_level.  Call this after modifying the list.
+   */
+  void UpdateIndex();
+
+  /**
+   * Invoke the visitor for each traffic object which may be within
+   * the given distance from the aircraft, nearest rings first.  It
+   * may visit traffic up to one ring width beyond that distance; the
+   * visitor has to check FlarmTraffic::distance if that matters.
+   *
+   * @param visitor a function object which gets a
+   * "const FlarmTraffic &" and its position in #list
+   */
+  template<typename V>
+  void VisitWithin(fixed range, V &&visitor) const {
+    if (!index_valid) {
+      for (unsigned i = 0; i < list.size(); ++i)
+        visitor(list[i], i);
+      return;
+    }
+
+    const unsigned end = ring_start[GetRing(range) + 1];
+    for (unsigned j = 0; j < end; ++j)
+      visitor(list[by_distance[j]], by_distance[j]);
+  }
+
+  /**
+   * Invoke the visitor for each traffic object with an alarm.
+   *
+   * @param visitor a function object which gets a
+   * "const FlarmTraffic &" and its position in #list
+   */
+  template<typename V>
+  void VisitAlarms(V &&visitor) const {
+    if (!index_valid) {
+      for (unsigned i = 0; i < list.size(); ++i)
+        if (list[i].HasAlarm())
+          visitor(list[i], i);
+      return;
+    }
+
+    for (unsigned j = 0; j < n_alarms; ++j)
+      visitor(list[alarms[j]], alarms[j]);
+  }
+
+private:
+  static unsigned GetRing(fixed distance) {
+    return distance < fixed(0)
+      ? 0
+      : (distance >= fixed((N_RINGS - 1) * RING_WIDTH)
+         ? N_RINGS - 1
+         : (unsigned)(distance / RING_WIDTH));
+  }
+
+  static unsigned GetIdHash(FlarmId id) {
+    /* Fibonacci hashing; the low bits of FLARM ids are not well
+       distributed */
+    return (id.GetHashKey() * 2654435761u) >> 23;
+  }
+
+  void ClearIdTable() {
+    std::fill(id_table, id_table + ID_TABLE_SIZE, 0);
+  }
+
+  /**
+   * Returns the position of the given id in #list, or -1 if it was
+   * not found.
+   */
+  gcc_pure
+  int FindIndex(FlarmId id) const;
+
+  /**
+   * Returns the #id_table slot which contains the given id, or the
+   * empty slot where it would be inserted.
+   */
+  gcc_pure
+  unsigned FindIdSlot(FlarmId id) const;
+
+  /**
+   * Remove the given id from #id_table.
+   */
+  void RemoveId(FlarmId id);
+
+  /**
+   * Remove the item at the given position, moving the last item into
+   * its place.
+   */
+  void Remove(unsigned i);
 };
 
-static_assert(std::is_trivial<TrafficList>::value, "type is not trivial");
+static_assert(has_trivial_constructor_and_destructor<TrafficList>::value,
+              "type is not trivial");
+static_assert(TrafficList::ID_TABLE_SIZE == 1u << (32 - 23),
+              "id hash does not match the table size");
 
 #endif
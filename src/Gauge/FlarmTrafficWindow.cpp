@@ -518,14 +518,21 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas)
     return;
   }
 
-  // Iterate through the traffic (normal traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
-    const FlarmTraffic &traffic = data.list[i];
-
+  const auto paint_normal = [this, &canvas](const FlarmTraffic &traffic,
+                                             unsigned i) {
     if (!traffic.HasAlarm() &&
         static_cast<unsigned> (selection) != i)
       PaintRadarTarget(canvas, traffic, i);
-  }
+  };
+
+  // Iterate through the traffic (normal traffic)
+  if (WarningMode())
+    /* far away targets are not displayed in WarningMode, skip them
+       early */
+    data.VisitWithin(distance, paint_normal);
+  else
+    for (unsigned i = 0; i < data.list.size(); ++i)
+      paint_normal(data.list[i], i);
 
   if (selection >= 0) {
     const FlarmTraffic &traffic = data.list[selection];
@@ -538,12 +545,9 @@ FlarmTrafficWindow::PaintRadarTraffic(Canvas &canvas)
     return;
 
   // Iterate through the traffic (alarm traffic)
-  for (unsigned i = 0; i < data.list.size(); ++i) {
-    const FlarmTraffic &traffic = data.list[i];
-
-    if (traffic.HasAlarm())
+  data.VisitAlarms([this, &canvas](const FlarmTraffic &traffic, unsigned i) {
       PaintRadarTarget(canvas, traffic, i);
-  }
+    });
 }
 
 /**
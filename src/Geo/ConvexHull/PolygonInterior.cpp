@@ -21,6 +21,8 @@
  */
 #include "PolygonInterior.hpp"
 
+#include <assert.h>
+
 // Copyright 2001, softSurfer (www.softsurfer.com)
 // This code may be freely used and modified for any purpose
 // providing that this copyright notice is included with it.
@@ -58,6 +60,37 @@ isLeft( const FlatGeoPoint &P0, const FlatGeoPoint &P1, const FlatGeoPoint &P2 )
   return 0;
 }
 
+/**
+ * Returns the contribution of the edge from A to B to the winding
+ * number of P.
+ */
+static inline int
+Winding(const GeoPoint &P, const GeoPoint &A, const GeoPoint &B)
+{
+  // edge from current to next
+  if (A.latitude <= P.latitude) {
+    // start y <= P.latitude
+
+    if (B.latitude > P.latitude)
+      // an upward crossing
+      if (isLeft(A, B, P) > 0)
+        // P left of edge
+        // have a valid up intersect
+        return 1;
+  } else {
+    // start y > P.latitude (no test needed)
+
+    if (B.latitude <= P.latitude)
+      // a downward crossing
+      if (isLeft(A, B, P) < 0)
+        // P right of edge
+        // have a valid down intersect
+        return -1;
+  }
+
+  return 0;
+}
+
 //===================================================================
 
 // PolygonInterior(): winding number interior test for a point in a polygon
@@ -76,28 +109,27 @@ PolygonInterior(const GeoPoint &P,
 
   // loop through all edges of the polygon
   for (auto i = begin, next = std::next(i); next != end;
-       i = next, next = std::next(i)) {
-    // edge from current to next
-    if (i->GetLocation().latitude <= P.latitude) {
-      // start y <= P.latitude
+       i = next, next = std::next(i))
+    wn += Winding(P, i->GetLocation(), next->GetLocation());
 
-      if (next->GetLocation().latitude > P.latitude)
-        // an upward crossing
-        if (isLeft(i->GetLocation(), next->GetLocation(), P) > 0)
-          // P left of edge
-          // have a valid up intersect
-          ++wn;
-    } else {
-      // start y > P.latitude (no test needed)
+  return wn != 0;
+}
 
-      if (next->GetLocation().latitude <= P.latitude)
-        // a downward crossing
-        if (isLeft(i->GetLocation(), next->GetLocation(), P) < 0)
-          // P right of edge
-          // have a valid down intersect
-          --wn;
-    }
+bool
+PolygonInterior(const GeoPoint &P,
+                const SearchPoint *begin, const SearchPoint *end,
+                const unsigned *edges_begin, const unsigned *edges_end)
+{
+  if (std::distance(begin, end) < 3)
+    return false;
+
+  int    wn = 0;    // the winding number counter
+
+  for (auto i = edges_begin; i != edges_end; ++i) {
+    assert(begin + *i + 1 < end);
+    wn += Winding(P, begin[*i].GetLocation(), begin[*i + 1].GetLocation());
   }
+
   return wn != 0;
 }
 
@@ -38,6 +38,17 @@ gcc_pure bool
 PolygonInterior(const GeoPoint &p,
                 const SearchPoint *begin, const SearchPoint *end);
 
+/**
+ * Like PolygonInterior(), but looks only at the given edges (edge i
+ * connects begin[i] and begin[i+1]).  The result is the same as
+ * PolygonInterior()'s if all edges whose latitude range includes
+ * the point's latitude are included.
+ */
+gcc_pure bool
+PolygonInterior(const GeoPoint &p,
+                const SearchPoint *begin, const SearchPoint *end,
+                const unsigned *edges_begin, const unsigned *edges_end);
+
 gcc_pure bool
 PolygonInterior(const FlatGeoPoint &p,
                 const SearchPoint *begin, const SearchPoint *end);
@@ -0,0 +1,120 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "EdgeStripIndex.hpp"
+
+#include <algorithm>
+
+#include <assert.h>
+
+unsigned
+EdgeStripIndex::GetStrip(fixed value) const
+{
+  /* this must be monotonic in the value, or edges would be missed;
+     rounding towards zero is, and clamping is */
+  int strip = (int)((value - min) * scale);
+  return std::max(0, std::min(strip, (int)GetStripCount() - 1));
+}
+
+void
+EdgeStripIndex::Build(const std::vector<fixed> &vertices,
+                      unsigned edges_per_strip)
+{
+  assert(vertices.size() >= 2);
+  assert(edges_per_strip > 0);
+
+  const unsigned n_edges = vertices.size() - 1;
+
+  const auto bounds = std::minmax_element(vertices.begin(), vertices.end());
+  min = *bounds.first;
+  max = *bounds.second;
+
+  const unsigned n_strips = std::max(n_edges / edges_per_strip, 1u);
+  scale = max > min
+    ? fixed(n_strips) / (max - min)
+    : fixed(0);
+
+  offsets.assign(n_strips + 1, 0);
+
+  /* count the edges of each strip */
+  for (unsigned i = 0; i < n_edges; ++i) {
+    const unsigned first = GetStrip(std::min(vertices[i], vertices[i + 1]));
+    const unsigned last = GetStrip(std::max(vertices[i], vertices[i + 1]));
+    for (unsigned s = first; s <= last; ++s)
+      ++offsets[s + 1];
+  }
+
+  for (unsigned s = 0; s < n_strips; ++s)
+    offsets[s + 1] += offsets[s];
+
+  /* fill the strips; edges are visited in ascending order, which
+     keeps each strip sorted */
+  edges.resize(offsets.back());
+  std::vector<unsigned> fill(offsets.begin(), offsets.end() - 1);
+  for (unsigned i = 0; i < n_edges; ++i) {
+    const unsigned first = GetStrip(std::min(vertices[i], vertices[i + 1]));
+    const unsigned last = GetStrip(std::max(vertices[i], vertices[i + 1]));
+    for (unsigned s = first; s <= last; ++s)
+      edges[fill[s]++] = i;
+  }
+}
+
+EdgeStripIndex::Range
+EdgeStripIndex::Find(fixed value) const
+{
+  assert(IsDefined());
+
+  if (value < min || value > max)
+    return Range(nullptr, nullptr);
+
+  return GetEdges(GetStrip(value));
+}
+
+void
+EdgeStripIndex::Find(fixed range_min, fixed range_max,
+                     std::vector<unsigned> &dest) const
+{
+  assert(IsDefined());
+  assert(range_min <= range_max);
+
+  dest.clear();
+
+  if (range_max < min || range_min > max)
+    return;
+
+  const unsigned first = GetStrip(std::max(range_min, min));
+  const unsigned last = GetStrip(std::min(range_max, max));
+
+  if (first == last) {
+    const Range r = GetEdges(first);
+    dest.assign(r.first, r.second);
+    return;
+  }
+
+  for (unsigned s = first; s <= last; ++s) {
+    const Range r = GetEdges(s);
+    dest.insert(dest.end(), r.first, r.second);
+  }
+
+  std::sort(dest.begin(), dest.end());
+  dest.erase(std::unique(dest.begin(), dest.end()), dest.end());
+}
@@ -0,0 +1,119 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_EDGE_STRIP_INDEX_HPP
+#define XCSOAR_EDGE_STRIP_INDEX_HPP
+
+#include "Math/fixed.hpp"
+#include "Compiler.h"
+
+#include <utility>
+#include <vector>
+
+/**
+ * An index of the edges of a polyline by one coordinate (usually the
+ * latitude).  The coordinate range is divided into strips of equal
+ * height, and each strip lists the edges which reach into it.  Edge
+ * i connects vertex i and vertex i+1.
+ *
+ * An edge is listed in every strip its coordinate range touches,
+ * including both end points, so a query for a coordinate value finds
+ * at least all edges whose range includes that value.
+ */
+class EdgeStripIndex {
+  fixed min, max;
+
+  /**
+   * Multiply the distance from #min with this to get the strip
+   * number.
+   */
+  fixed scale;
+
+  /**
+   * The edges of strip i are edges[offsets[i]] to
+   * edges[offsets[i+1]-1], in ascending order.
+   */
+  std::vector<unsigned> offsets;
+  std::vector<unsigned> edges;
+
+public:
+  typedef std::pair<const unsigned *, const unsigned *> Range;
+
+  /**
+   * Has Build() been called?
+   */
+  bool IsDefined() const {
+    return !offsets.empty();
+  }
+
+  void Clear() {
+    offsets.clear();
+    edges.clear();
+  }
+
+  /**
+   * Build the index.
+   *
+   * @param vertices the coordinate of each vertex; there must be at
+   * least two
+   * @param edges_per_strip the desired average number of edges per
+   * strip
+   */
+  void Build(const std::vector<fixed> &vertices,
+             unsigned edges_per_strip = 8);
+
+  /**
+   * Returns the edges whose coordinate range may include the given
+   * value, in ascending order.
+   */
+  gcc_pure
+  Range Find(fixed value) const;
+
+  /**
+   * Find the edges whose coordinate range may overlap the given
+   * range.
+   *
+   * @param dest receives the edge indices in ascending order,
+   * without duplicates
+   */
+  void Find(fixed range_min, fixed range_max,
+            std::vector<unsigned> &dest) const;
+
+private:
+  gcc_pure
+  unsigned GetStripCount() const {
+    return offsets.size() - 1;
+  }
+
+  /**
+   * Determine the strip of a value within [#min, #max].
+   */
+  gcc_pure
+  unsigned GetStrip(fixed value) const;
+
+  Range GetEdges(unsigned strip) const {
+    return Range(edges.data() + offsets[strip],
+                 edges.data() + offsets[strip + 1]);
+  }
+};
+
+#endif
@@ -33,10 +33,10 @@ FlatBoundingBox::Distance(const FlatBoundingBox &f) const
   if (Overlaps(f))
     return 0;
 
-  int dx = std::max(0, std::min(f.bb_ll.longitude - bb_ur.longitude,
-                                bb_ll.longitude - f.bb_ur.longitude));
-  int dy = std::max(0, std::min(f.bb_ll.latitude - bb_ur.latitude,
-                                bb_ll.latitude - f.bb_ur.latitude));
+  int dx = std::max({0, f.bb_ll.longitude - bb_ur.longitude,
+                      bb_ll.longitude - f.bb_ur.longitude});
+  int dy = std::max({0, f.bb_ll.latitude - bb_ur.latitude,
+                     bb_ll.latitude - f.bb_ur.latitude});
 
   return ihypot(dx, dy);
 }
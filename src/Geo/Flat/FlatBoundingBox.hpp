@@ -148,6 +148,16 @@ public:
     bb_ur = bb_ur + offset;
   }
 
+  /**
+   * Expand the border by the given amount
+   */
+  void Grow(int amount) {
+    bb_ll.longitude -= amount;
+    bb_ur.longitude += amount;
+    bb_ll.latitude -= amount;
+    bb_ur.latitude += amount;
+  }
+
   /**
    * Expand the border by x amount
    */
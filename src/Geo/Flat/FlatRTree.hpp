@@ -0,0 +1,362 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef FLAT_RTREE_HPP
+#define FLAT_RTREE_HPP
+
+#include "FlatBoundingBox.hpp"
+#include "Compiler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/**
+ * A static, array-backed R-tree of objects derived from
+ * #FlatBoundingBox.
+ *
+ * The tree is bulk-loaded by optimise(): the values are sorted along
+ * a Hilbert curve through the centers of their bounding boxes, and
+ * each group of #NODE_SIZE consecutive values (or nodes) gets a
+ * parent node.  There are no pointers; the nodes of all levels are
+ * stored in one array, leaf level first.
+ *
+ * Values inserted after the last optimise() call are stored
+ * unindexed at the end of the value array and are checked linearly
+ * by all queries; erasing a value discards the index.  This mimics
+ * the KDTree interface used by #Airspaces, which also needs an
+ * optimise() call after modifications.
+ */
+template<typename T, unsigned NODE_SIZE=16>
+class FlatRTree {
+  static_assert(NODE_SIZE >= 2, "Node size too small");
+
+  std::vector<T> values;
+
+  /**
+   * The bounding boxes of all nodes, leaf level first.  Node i of
+   * level 0 covers values [i*NODE_SIZE, (i+1)*NODE_SIZE), node i of
+   * level l>0 covers the nodes [i*NODE_SIZE, (i+1)*NODE_SIZE) of
+   * level l-1.
+   */
+  std::vector<FlatBoundingBox> nodes;
+
+  /**
+   * Index of the first node of each level in #nodes, plus one
+   * trailing entry for the end of the top level, which contains
+   * only the root.  Empty if there is no index.
+   */
+  std::vector<unsigned> levels;
+
+  /**
+   * The number of values covered by the index.  The remaining ones
+   * were inserted later.
+   */
+  unsigned n_indexed;
+
+public:
+  typedef typename std::vector<T>::const_iterator const_iterator;
+  typedef typename std::vector<T>::size_type size_type;
+
+  FlatRTree():n_indexed(0) {}
+
+  gcc_pure
+  const_iterator begin() const {
+    return values.begin();
+  }
+
+  gcc_pure
+  const_iterator end() const {
+    return values.end();
+  }
+
+  gcc_pure
+  size_type size() const {
+    return values.size();
+  }
+
+  gcc_pure
+  bool empty() const {
+    return values.empty();
+  }
+
+  void clear() {
+    values.clear();
+    DiscardIndex();
+  }
+
+  void insert(const T &value) {
+    values.push_back(value);
+  }
+
+  /**
+   * Remove the value at the given position.  The index is discarded
+   * until the next optimise() call.
+   *
+   * @return an iterator to the value following the removed one
+   */
+  const_iterator erase(const_iterator i) {
+    DiscardIndex();
+    return values.erase(i);
+  }
+
+  /**
+   * Build the index over all values.
+   */
+  void optimise() {
+    DiscardIndex();
+
+    if (values.empty())
+      return;
+
+    SortHilbert();
+
+    const unsigned n = values.size();
+    nodes.reserve(CountNodes(n));
+
+    levels.push_back(0);
+    for (unsigned i = 0; i < n; i += NODE_SIZE) {
+      FlatBoundingBox box = values[i];
+      const unsigned last = std::min(i + NODE_SIZE, n);
+      for (unsigned j = i + 1; j < last; ++j)
+        box.Merge(values[j]);
+      nodes.push_back(box);
+    }
+    levels.push_back(nodes.size());
+
+    while (levels.back() - levels[levels.size() - 2] > 1) {
+      const unsigned first = levels[levels.size() - 2], end = levels.back();
+      for (unsigned i = first; i < end; i += NODE_SIZE) {
+        FlatBoundingBox box = nodes[i];
+        const unsigned last = std::min(i + NODE_SIZE, end);
+        for (unsigned j = i + 1; j < last; ++j)
+          box.Merge(nodes[j]);
+        nodes.push_back(box);
+      }
+      levels.push_back(nodes.size());
+    }
+
+    n_indexed = n;
+  }
+
+  /**
+   * Call the visitor for each value whose bounding box overlaps the
+   * given box enlarged by the given range on all sides.
+   */
+  template<typename Visitor>
+  void visit_within_range(const FlatBoundingBox &bb, unsigned range,
+                          Visitor &visitor) const {
+    FlatBoundingBox query = bb;
+    query.Grow(range);
+    const auto overlaps = [&query](const FlatBoundingBox &box) {
+      return box.Overlaps(query);
+    };
+
+    if (!levels.empty())
+      Visit(levels.size() - 2, levels[levels.size() - 2], overlaps, visitor);
+
+    for (unsigned i = n_indexed; i < values.size(); ++i)
+      if (overlaps(values[i]))
+        visitor(values[i]);
+  }
+
+  /**
+   * Copy each value whose bounding box overlaps the given box
+   * enlarged by the given range to the output iterator.
+   */
+  template<typename OutputIterator>
+  OutputIterator find_within_range(const FlatBoundingBox &bb, unsigned range,
+                                   OutputIterator out) const {
+    const auto copy = [&out](const T &value) {
+      *out++ = value;
+    };
+    visit_within_range(bb, range, copy);
+    return out;
+  }
+
+  /**
+   * Find the value nearest to the given box (using
+   * FlatBoundingBox::Distance()) which satisfies the predicate.
+   *
+   * @param max_distance values further away are ignored
+   * @return the value (or end() if none was found) and its distance
+   */
+  template<typename Predicate>
+  gcc_pure
+  std::pair<const_iterator, unsigned>
+  find_nearest_if(const FlatBoundingBox &bb, unsigned max_distance,
+                  const Predicate &predicate) const {
+    unsigned best = values.size();
+    unsigned best_distance = max_distance;
+
+    if (!levels.empty())
+      Nearest(levels.size() - 2, levels[levels.size() - 2], bb, predicate,
+              best, best_distance);
+
+    for (unsigned i = n_indexed; i < values.size(); ++i)
+      CheckNearest(i, bb, predicate, best, best_distance);
+
+    return std::make_pair(values.begin() + best, best_distance);
+  }
+
+private:
+  void DiscardIndex() {
+    nodes.clear();
+    levels.clear();
+    n_indexed = 0;
+  }
+
+  static constexpr unsigned CountNodes(unsigned n) {
+    return n <= NODE_SIZE
+      ? 1
+      : (n + NODE_SIZE - 1) / NODE_SIZE
+      + CountNodes((n + NODE_SIZE - 1) / NODE_SIZE);
+  }
+
+  /**
+   * Returns the position of the given point on a Hilbert curve
+   * filling the 2^16 x 2^16 grid.
+   */
+  gcc_const
+  static unsigned HilbertIndex(unsigned x, unsigned y) {
+    constexpr unsigned n = 1u << 16;
+
+    unsigned d = 0;
+    for (unsigned s = n / 2; s > 0; s /= 2) {
+      const unsigned rx = (x & s) != 0;
+      const unsigned ry = (y & s) != 0;
+      d += s * s * ((3 * rx) ^ ry);
+
+      if (ry == 0) {
+        if (rx == 1) {
+          x = n - 1 - x;
+          y = n - 1 - y;
+        }
+
+        std::swap(x, y);
+      }
+    }
+
+    return d;
+  }
+
+  void SortHilbert() {
+    FlatBoundingBox extent = values.front();
+    for (const auto &v : values)
+      extent.Merge(v);
+
+    const FlatGeoPoint origin = extent.GetLowerLeft();
+    const unsigned width = extent.GetUpperRight().longitude - origin.longitude;
+    const unsigned height = extent.GetUpperRight().latitude - origin.latitude;
+
+    /* map the box centers onto the 16 bit grid of the Hilbert curve */
+    const auto scale = [](int offset, unsigned size) -> unsigned {
+      return size > 0
+        ? (unsigned)(((unsigned long long)offset * 0xffff) / size)
+        : 0;
+    };
+
+    std::vector<std::pair<unsigned, unsigned>> keys;
+    keys.reserve(values.size());
+    for (unsigned i = 0; i < values.size(); ++i) {
+      const FlatGeoPoint c = values[i].GetCenter();
+      keys.emplace_back(HilbertIndex(scale(c.longitude - origin.longitude,
+                                           width),
+                                     scale(c.latitude - origin.latitude,
+                                           height)),
+                        i);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<T> sorted;
+    sorted.reserve(values.size());
+    for (const auto &k : keys)
+      sorted.push_back(values[k.second]);
+
+    values.swap(sorted);
+  }
+
+  /**
+   * Returns the range of children of a node at the given level.
+   */
+  gcc_pure
+  std::pair<unsigned, unsigned> GetChildren(unsigned level,
+                                            unsigned node) const {
+    const unsigned i = (node - levels[level]) * NODE_SIZE;
+    if (level == 0)
+      return std::make_pair(i, std::min(i + NODE_SIZE, n_indexed));
+
+    const unsigned first = levels[level - 1];
+    return std::make_pair(first + i,
+                          std::min(first + i + NODE_SIZE, levels[level]));
+  }
+
+  template<typename Test, typename Visitor>
+  void Visit(unsigned level, unsigned node,
+             const Test &test, Visitor &visitor) const {
+    if (!test(nodes[node]))
+      return;
+
+    const auto children = GetChildren(level, node);
+    if (level == 0) {
+      for (unsigned i = children.first; i < children.second; ++i)
+        if (test(values[i]))
+          visitor(values[i]);
+    } else {
+      for (unsigned i = children.first; i < children.second; ++i)
+        Visit(level - 1, i, test, visitor);
+    }
+  }
+
+  template<typename Predicate>
+  void CheckNearest(unsigned i, const FlatBoundingBox &bb,
+                    const Predicate &predicate,
+                    unsigned &best, unsigned &best_distance) const {
+    const unsigned distance = values[i].Distance(bb);
+    if (distance <= best_distance &&
+        (distance < best_distance || best == values.size()) &&
+        predicate(values[i])) {
+      best = i;
+      best_distance = distance;
+    }
+  }
+
+  template<typename Predicate>
+  void Nearest(unsigned level, unsigned node, const FlatBoundingBox &bb,
+               const Predicate &predicate,
+               unsigned &best, unsigned &best_distance) const {
+    if (nodes[node].Distance(bb) > best_distance)
+      return;
+
+    const auto children = GetChildren(level, node);
+    if (level == 0) {
+      for (unsigned i = children.first; i < children.second; ++i)
+        CheckNearest(i, bb, predicate, best, best_distance);
+    } else {
+      for (unsigned i = children.first; i < children.second; ++i)
+        Nearest(level - 1, i, bb, predicate, best, best_distance);
+    }
+  }
+};
+
+#endif
@@ -65,6 +65,14 @@ CSVLine::ReadOneChar()
   return Skip() == 1 ? ch : '\0';
 }
 
+Range<const char *>
+CSVLine::ReadView()
+{
+  const char *src = data;
+  size_t length = Skip();
+  return Range<const char *>(src, src + length);
+}
+
 void
 CSVLine::Read(char *dest, size_t size)
 {
@@ -79,10 +87,10 @@ CSVLine::Read(char *dest, size_t size)
 bool
 CSVLine::ReadCompare(const char *value)
 {
-  size_t length = strlen(value);
-  char buffer[length + 2];
-  Read(buffer, length + 2);
-  return strcmp(buffer, value) == 0;
+  const Range<const char *> column = ReadView();
+  const size_t length = column.end() - column.begin();
+  return length == strlen(value) &&
+    memcmp(column.begin(), value, length) == 0;
 }
 
 long
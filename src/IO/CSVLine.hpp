@@ -66,6 +66,13 @@ public:
    */
   char ReadOneChar();
 
+  /**
+   * Read a column without copying it.
+   *
+   * @return the column, pointing into the original line
+   */
+  Range<const char *> ReadView();
+
   void Read(char *dest, size_t size);
   bool ReadCompare(const char *value);
 
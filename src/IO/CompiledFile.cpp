@@ -0,0 +1,142 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "CompiledFile.hpp"
+#include "FileCache.hpp"
+#include "MemoryReader.hpp"
+#include "OS/FileMapping.hpp"
+#include "Util/tstring.hpp"
+
+#include <windef.h> /* for MAX_PATH */
+#include <stdint.h>
+
+namespace CompiledFile {
+  struct Header {
+    enum {
+#ifdef FIXED_MATH
+      VERSION = 0x1a,
+#else
+      VERSION = 0x1b,
+#endif
+    };
+
+    uint32_t version;
+
+    /**
+     * sizeof(TCHAR), because strings are stored as raw TCHAR arrays.
+     */
+    uint32_t tchar_size;
+
+    uint32_t num_records;
+
+    /**
+     * The number of characters of the source path, which follows
+     * this header.
+     */
+    uint32_t source_path_length;
+  };
+}
+
+bool
+CompiledFile::WriteHeader(FILE *file, const TCHAR *source_path,
+                          unsigned n_records)
+{
+  Header header;
+  header.version = Header::VERSION;
+  header.tchar_size = sizeof(TCHAR);
+  header.num_records = n_records;
+  header.source_path_length = _tcslen(source_path);
+
+  return fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(source_path, sizeof(TCHAR), header.source_path_length,
+           file) == header.source_path_length;
+}
+
+bool
+CompiledFile::ReadHeader(MemoryReader &reader, const TCHAR *source_path,
+                         unsigned &n_records)
+{
+  Header header;
+  tstring compiled_source_path;
+  if (!reader.Read(header) ||
+      header.version != Header::VERSION ||
+      header.tchar_size != sizeof(TCHAR) ||
+      !reader.ReadString(compiled_source_path, header.source_path_length) ||
+      compiled_source_path != source_path)
+    return false;
+
+  n_records = header.num_records;
+  return true;
+}
+
+bool
+CompiledFile::Load(const TCHAR *path, size_t offset,
+                   const TCHAR *source_path, Loader &loader)
+{
+  FileMapping mapping(path);
+  if (mapping.error() || mapping.size() < offset)
+    return false;
+
+  MemoryReader reader(mapping.at(offset), mapping.end());
+
+  unsigned n_records;
+  if (!ReadHeader(reader, source_path, n_records) ||
+      !loader.Read(reader, n_records) ||
+      !reader.IsEnd())
+    return false;
+
+  loader.Commit();
+  return true;
+}
+
+bool
+CompiledFile::Load(FileCache &cache, const TCHAR *name,
+                   const TCHAR *source_path, Loader &loader)
+{
+  TCHAR buffer[MAX_PATH];
+  size_t offset;
+  const TCHAR *compiled_path = cache.LoadPath(name, source_path,
+                                              buffer, offset);
+  if (compiled_path == NULL)
+    return false;
+
+  if (!Load(compiled_path, offset, source_path, loader)) {
+    /* obsolete or corrupt; it will be regenerated */
+    cache.Flush(name);
+    return false;
+  }
+
+  return true;
+}
+
+bool
+CompiledFile::Finish(FileCache &cache, const TCHAR *name, FILE *file,
+                     bool success)
+{
+  if (!success) {
+    cache.Cancel(name, file);
+    return false;
+  }
+
+  return cache.Commit(name, file);
+}
@@ -0,0 +1,124 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_COMPILED_FILE_HPP
+#define XCSOAR_IO_COMPILED_FILE_HPP
+
+#include <tchar.h>
+#include <stddef.h>
+#include <stdio.h>
+
+class FileCache;
+class MemoryReader;
+
+/**
+ * Helpers for "compiled files": binary snapshots of the data parsed
+ * from one text file (e.g. airspaces or waypoints).  They are
+ * generated once after the text file was parsed, and are then mapped
+ * into memory on the following starts, which is much faster than
+ * parsing the text again.
+ *
+ * A compiled file begins with a common header (format version,
+ * sizeof(TCHAR), number of records and the path of the source file),
+ * followed by the payload, which is written and read by the module
+ * owning the data.
+ *
+ * The file is stored in the #FileCache, which validates it against
+ * the size and modification time of the source file.  The layout
+ * depends on the host's byte order and on the "fixed" type, so the
+ * file is only valid for the program which wrote it.
+ */
+namespace CompiledFile {
+  /**
+   * Reads the payload of a compiled file.
+   */
+  class Loader {
+  public:
+    /**
+     * Read the given number of records, but don't publish them yet.
+     *
+     * @return false if the payload is corrupt
+     */
+    virtual bool Read(MemoryReader &reader, unsigned n_records) = 0;
+
+    /**
+     * Publish the records read by Read().  This is called only after
+     * the whole file was found to be valid, so a corrupt file doesn't
+     * leave partial data behind.
+     */
+    virtual void Commit() = 0;
+  };
+
+  /**
+   * Write the header of a compiled file; the caller writes the
+   * payload after it.
+   *
+   * @param source_path the path of the text file the data was parsed
+   * from
+   * @param n_records the number of records in the payload
+   */
+  bool WriteHeader(FILE *file, const TCHAR *source_path, unsigned n_records);
+
+  /**
+   * Read and check the header of a compiled file.
+   *
+   * @param source_path the path of the text file the data shall be
+   * loaded from
+   * @return false if the file is corrupt, if it was written by a
+   * different program or if it was compiled from a different source
+   * file
+   */
+  bool ReadHeader(MemoryReader &reader, const TCHAR *source_path,
+                  unsigned &n_records);
+
+  /**
+   * Map a compiled file into memory, check its header and pass the
+   * payload to the #Loader.
+   *
+   * @param offset the position of the header within the file
+   * @return true on success
+   */
+  bool Load(const TCHAR *path, size_t offset, const TCHAR *source_path,
+            Loader &loader);
+
+  /**
+   * Like Load(), but look up the compiled file in the #FileCache.  An
+   * obsolete or corrupt file is removed from the cache, so it will be
+   * regenerated.
+   *
+   * @param name the name of the compiled file in the cache
+   */
+  bool Load(FileCache &cache, const TCHAR *name, const TCHAR *source_path,
+            Loader &loader);
+
+  /**
+   * Finish writing a compiled file obtained from FileCache::Save():
+   * commit it if it was written successfully, or cancel it.
+   *
+   * @return true if the file was committed
+   */
+  bool Finish(FileCache &cache, const TCHAR *name, FILE *file,
+              bool success);
+}
+
+#endif
@@ -28,6 +28,7 @@ Copyright_License {
 #include "Compiler.h"
 
 #include <stdint.h>
+#include <assert.h>
 #include <string.h>
 #include <stdlib.h>
 #include <sys/types.h>
@@ -156,6 +157,25 @@ FileCache::Load(const TCHAR *name, const TCHAR *original_path)
   return file;
 }
 
+const TCHAR *
+FileCache::LoadPath(const TCHAR *name, const TCHAR *original_path,
+                    TCHAR *buffer, size_t &offset)
+{
+  assert(PathBufferSize(name) <= MAX_PATH);
+
+  FILE *file = Load(name, original_path);
+  if (file == NULL)
+    return NULL;
+
+  const long position = ftell(file);
+  fclose(file);
+  if (position < 0)
+    return NULL;
+
+  offset = position;
+  return MakeCachePath(buffer, name);
+}
+
 FILE *
 FileCache::Save(const TCHAR *name, const TCHAR *original_path)
 {
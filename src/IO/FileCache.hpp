@@ -43,6 +43,18 @@ public:
   void Flush(const TCHAR *name);
   FILE *Load(const TCHAR *name, const TCHAR *original_path);
 
+  /**
+   * Like Load(), but instead of opening the cache file, return its
+   * path and the position where the payload begins.  This is useful
+   * for mapping the file into memory.
+   *
+   * @param buffer a buffer of at least MAX_PATH characters
+   * @return the path (pointing into the buffer) or NULL if there is
+   * no valid cache file
+   */
+  const TCHAR *LoadPath(const TCHAR *name, const TCHAR *original_path,
+                        TCHAR *buffer, size_t &offset);
+
   FILE *Save(const TCHAR *name, const TCHAR *original_path);
   bool Commit(const TCHAR *name, FILE *file);
   void Cancel(const TCHAR *name, FILE *file);
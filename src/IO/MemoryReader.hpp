@@ -0,0 +1,102 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IO_MEMORY_READER_HPP
+#define XCSOAR_IO_MEMORY_READER_HPP
+
+#include "Util/tstring.hpp"
+#include "Util/InternedString.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Reads values sequentially from a buffer, e.g. a #FileMapping, with
+ * bounds checking.  The buffer has no alignment guarantees, so all
+ * values are copied with memcpy().
+ */
+class MemoryReader {
+  const uint8_t *p;
+  const uint8_t *const end;
+
+public:
+  MemoryReader(const void *begin, const void *_end)
+    :p((const uint8_t *)begin), end((const uint8_t *)_end) {}
+
+  bool IsEnd() const {
+    return p == end;
+  }
+
+  size_t GetRemaining() const {
+    return end - p;
+  }
+
+  bool Read(void *dest, size_t size) {
+    if (size > GetRemaining())
+      return false;
+
+    memcpy(dest, p, size);
+    p += size;
+    return true;
+  }
+
+  template<typename T>
+  bool Read(T &value) {
+    return Read(&value, sizeof(value));
+  }
+
+  /**
+   * Read a string of the given number of characters (without a null
+   * terminator).
+   */
+  bool ReadString(tstring &value, size_t length) {
+    if (length > GetRemaining() / sizeof(TCHAR))
+      return false;
+
+    value.resize(length);
+    return Read(&value[0], length * sizeof(TCHAR));
+  }
+
+  /**
+   * Read a string of the given number of characters (without a null
+   * terminator) into the #StringPool.
+   */
+  bool ReadString(InternedString &value, size_t length) {
+    if (length > GetRemaining() / sizeof(TCHAR))
+      return false;
+
+#ifdef _UNICODE
+    /* the buffer may not be aligned for TCHAR */
+    tstring buffer;
+    ReadString(buffer, length);
+    value = buffer;
+#else
+    value.assign((const TCHAR *)p, length);
+    p += length;
+#endif
+    return true;
+  }
+};
+
+#endif
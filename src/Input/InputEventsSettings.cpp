@@ -258,7 +258,6 @@ InputEvents::eventProfileLoad(const TCHAR *misc)
     MapFileChanged = true;
     WaypointFileChanged = true;
     AirspaceFileChanged = true;
-    AirfieldFileChanged = true;
 
     // assuming all is ok, we can...
     Profile::Use();
@@ -64,61 +64,65 @@ MapWindow::DrawFLARMTraffic(Canvas &canvas,
 
   canvas.Select(Fonts::map);
 
-  // Circle through the FLARM targets
-  for (auto it = flarm.list.begin(), end = flarm.list.end();
-      it != end; ++it) {
-    const FlarmTraffic &traffic = *it;
-
-    if (!traffic.location_available)
-      continue;
-
-    // Save the location of the FLARM target
-    GeoPoint target_loc = traffic.location;
-
-    // Points for the screen coordinates for the icon, name and average climb
-    RasterPoint sc, sc_name, sc_av;
-
-    // If FLARM target not on the screen, move to the next one
-    if (!projection.GeoToScreenIfVisible(target_loc, sc))
-      continue;
-
-    // Draw the name 16 points below the icon
-    sc_name = sc;
-    sc_name.y -= Layout::Scale(20);
-
-    // Draw the average climb value above the icon
-    sc_av = sc;
-    sc_av.y += Layout::Scale(5);
+  /* the traffic beyond this distance from the aircraft cannot be on
+     the screen; without a GPS fix, all traffic is visited */
+  fixed range = fixed(100000);
+  if (Basic().location_available)
+    range = Basic().location.Distance(projection.GetGeoScreenCenter()) +
+      projection.GetScreenDistanceMeters();
 
-    TextInBoxMode mode;
-    mode.shape = LabelShape::OUTLINED;
-
-    // JMW TODO enhancement: decluttering of FLARM altitudes (sort by max lift)
-
-    int dx = sc_av.x - aircraft_pos.x;
-    int dy = sc_av.y - aircraft_pos.y;
-
-    // only draw labels if not close to aircraft
-    if (dx * dx + dy * dy > Layout::Scale(30 * 30)) {
-      // If FLARM callsign/name available draw it to the canvas
-      if (traffic.HasName() && !StringIsEmpty(traffic.name))
-        TextInBox(canvas, traffic.name, sc_name.x, sc_name.y,
-                  mode, GetClientRect());
-
-      if (traffic.climb_rate_avg30s >= fixed(0.1)) {
-        // If average climb data available draw it to the canvas
-        TCHAR label_avg[100];
-        FormatUserVerticalSpeed(traffic.climb_rate_avg30s,
-                                       label_avg, false);
-        TextInBox(canvas, label_avg, sc_av.x, sc_av.y, mode, GetClientRect());
+  // Circle through the FLARM targets
+  flarm.VisitWithin(range, [&](const FlarmTraffic &traffic, unsigned) {
+      if (!traffic.location_available)
+        return;
+
+      // Save the location of the FLARM target
+      GeoPoint target_loc = traffic.location;
+
+      // Points for the screen coordinates for the icon, name and average climb
+      RasterPoint sc, sc_name, sc_av;
+
+      // If FLARM target not on the screen, move to the next one
+      if (!projection.GeoToScreenIfVisible(target_loc, sc))
+        return;
+
+      // Draw the name 16 points below the icon
+      sc_name = sc;
+      sc_name.y -= Layout::Scale(20);
+
+      // Draw the average climb value above the icon
+      sc_av = sc;
+      sc_av.y += Layout::Scale(5);
+
+      TextInBoxMode mode;
+      mode.shape = LabelShape::OUTLINED;
+
+      // JMW TODO enhancement: decluttering of FLARM altitudes (sort by max lift)
+
+      int dx = sc_av.x - aircraft_pos.x;
+      int dy = sc_av.y - aircraft_pos.y;
+
+      // only draw labels if not close to aircraft
+      if (dx * dx + dy * dy > Layout::Scale(30 * 30)) {
+        // If FLARM callsign/name available draw it to the canvas
+        if (traffic.HasName() && !StringIsEmpty(traffic.name))
+          TextInBox(canvas, traffic.name, sc_name.x, sc_name.y,
+                    mode, GetClientRect());
+
+        if (traffic.climb_rate_avg30s >= fixed(0.1)) {
+          // If average climb data available draw it to the canvas
+          TCHAR label_avg[100];
+          FormatUserVerticalSpeed(traffic.climb_rate_avg30s,
+                                         label_avg, false);
+          TextInBox(canvas, label_avg, sc_av.x, sc_av.y, mode, GetClientRect());
+        }
       }
-    }
 
-    auto color = FlarmFriends::GetFriendColor(traffic.id);
-    TrafficRenderer::Draw(canvas, traffic_look, traffic,
-                          traffic.track - projection.GetScreenAngle(),
-                          color, sc);
-  }
+      auto color = FlarmFriends::GetFriendColor(traffic.id);
+      TrafficRenderer::Draw(canvas, traffic_look, traffic,
+                            traffic.track - projection.GetScreenAngle(),
+                            color, sc);
+    });
 }
 
 /**
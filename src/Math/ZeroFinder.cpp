@@ -69,10 +69,10 @@ ZeroFinder::solution_within_tolerance(const fixed x,
   if (x_plus >= xmax)
     return false;
 
-  const fixed fx = f(x);
-  if (f(x_plus)<fx)
+  const fixed fx = evaluate(x);
+  if (evaluate(x_plus)<fx)
     return false;
-  if (f(x_minus)<fx)
+  if (evaluate(x_minus)<fx)
     return false;
   // existing solution is good 
   return true;
@@ -132,33 +132,109 @@ ZeroFinder::solution_within_tolerance(const fixed x,
  */
 
 fixed ZeroFinder::find_zero(const fixed xstart) {
+  const fixed x = find_zero_tentative(xstart);
+  commit_hint(x);
+  return x;
+}
+
+fixed
+ZeroFinder::find_zero_tentative(const fixed xstart)
+{
 #ifdef INSTRUMENT_ZERO
   zero_total++;
 #endif
-  if ((xmin<=xstart) || (xstart<=xmax) ||
-      (f(xstart)> sqrt_epsilon))
-    return find_zero_actual(xstart);
+  fixed x;
+  if (hint != nullptr && hint->defined && find_zero_near(x)) {
 #ifdef INSTRUMENT_ZERO
-  zero_skipped++;
+    zero_skipped++;
 #endif
-  return xstart;
+  } else
+    x = find_zero_actual(xstart);
+
+  return x;
+}
+
+void
+ZeroFinder::commit_hint(const fixed x)
+{
+  if (hint == nullptr)
+    return;
+
+  /* the next bracket is twice as wide as the last change, but at
+     least a few times the tolerance */
+  const fixed range = xmax - xmin;
+  hint->width = hint->defined
+    ? std::min(std::max(Double(fabs(x - hint->x)), Double(tolerance)),
+               range / 4)
+    : range / 16;
+  hint->x = x;
+  hint->defined = true;
+}
+
+static inline bool
+SameSign(const fixed a, const fixed b)
+{
+  return (positive(a) && positive(b)) || (negative(a) && negative(b));
+}
+
+bool
+ZeroFinder::find_zero_near(fixed &result)
+{
+  assert(hint != nullptr && hint->defined);
+
+  const fixed x = std::max(xmin, std::min(hint->x, xmax));
+  const fixed fx = evaluate(x);
+
+  fixed lo = x, flo = fx, hi = x, fhi = fx;
+  fixed width = hint->width;
+
+  /* widen the bracket a few times until the function changes its
+     sign; the point evaluated last is passed as "b" to
+     find_zero_bracket(), because that is where f() was called last */
+  for (unsigned i = 0; i < 3 && (lo > xmin || hi < xmax); ++i, width *= 4) {
+    if (lo > xmin) {
+      const fixed a = std::max(x - width, xmin);
+      const fixed fa = evaluate(a);
+      if (!SameSign(fa, flo)) {
+        result = find_zero_bracket(lo, flo, a, fa);
+        return true;
+      }
+
+      lo = a;
+      flo = fa;
+    }
+
+    if (hi < xmax) {
+      const fixed b = std::min(x + width, xmax);
+      const fixed fb = evaluate(b);
+      if (!SameSign(fb, fhi)) {
+        result = find_zero_bracket(hi, fhi, b, fb);
+        return true;
+      }
+
+      hi = b;
+      fhi = fb;
+    }
+  }
+
+  return false;
 }
 
 inline fixed
 ZeroFinder::find_zero_actual(const fixed xstart)
 {
-  fixed a, b, c; // Abscissae, descr. see above
-  fixed fa; // f(a)
-  fixed fb; // f(b)
-  fixed fc; // f(c)
-
-  bool b_best = true; // b is best and last called
+  const fixed fa = evaluate(xmin);
+  const fixed fb = evaluate(xmax);
+  return find_zero_bracket(xmin, fa, xmax, fb);
+}
 
-  c = a = xmin;  
-  fc = fa = f(a);  
+fixed
+ZeroFinder::find_zero_bracket(fixed a, fixed fa, fixed b, fixed fb)
+{
+  fixed c = a; // Abscissae, descr. see above
+  fixed fc = fa; // f(c)
 
-  b = xmax;  
-  fb = f(b);
+  bool b_best = true; // b is best and last called
 
   // Main iteration loop
   for (;;) {
@@ -189,7 +265,7 @@ ZeroFinder::find_zero_actual(const fixed xstart)
     if (fabs(new_step) <= tol_act || fabs(fb) < sqrt_epsilon) {
       if (!b_best)
         // call once more
-        fb = f(b);
+        fb = evaluate(b);
 
       // Acceptable approx. is found
       return b;
@@ -245,7 +321,7 @@ ZeroFinder::find_zero_actual(const fixed xstart)
 
     // Do step to a new approxim.
     b += new_step;
-    fb = f(b);
+    fb = evaluate(b);
 
     // Adjust c for it to have a sign opposite to that of b
     if ((positive(fb) && positive(fc)) || (negative(fb) && negative(fc))) {
@@ -337,7 +413,7 @@ ZeroFinder::find_min_actual(const fixed xstart)
 
   /* First step - always gold section*/
   x = w = v = a + r * (b - a);
-  fx = fw = fv = f(v);
+  fx = fw = fv = evaluate(v);
 
   // Main iteration loop
   for (;;) {
@@ -352,7 +428,7 @@ ZeroFinder::find_min_actual(const fixed xstart)
     if (fabs(x-middle_range) + Half(range) <= double_tol_act) {
       if (!x_best)
         // call once more
-        fx = f(x);
+        fx = evaluate(x);
 
       // Acceptable approx. is found
       return x;
@@ -400,7 +476,7 @@ ZeroFinder::find_min_actual(const fixed xstart)
     {
       // Tentative point for the min
       const fixed t = x + new_step;
-      const fixed ft = f(t);
+      const fixed ft = evaluate(t);
       // t is a better approximation
       if (ft <= fx) {
         // Reduce the range so that t would fall within it
@@ -32,6 +32,33 @@
  *
  */
 class ZeroFinder {
+public:
+  /**
+   * The solution of a previous search, kept by the caller between
+   * searches of a slowly changing function.  If a hint is passed to
+   * set_hint(), find_zero() looks for the zero in a small bracket
+   * around the previous solution first, and only falls back to the
+   * full range if there is no zero nearby.
+   */
+  struct Hint {
+    /** the previous solution */
+    fixed x;
+
+    /**
+     * The half width of the first bracket around #x; it follows the
+     * recent changes of the solution.
+     */
+    fixed width;
+
+    bool defined;
+
+    Hint():defined(false) {}
+
+    void Clear() {
+      defined = false;
+    }
+  };
+
 protected:
   /** min value of search range */
   const fixed xmin;
@@ -40,6 +67,13 @@ protected:
   /** search tolerance in x */
   const fixed tolerance;
 
+private:
+  /** see set_hint() */
+  Hint *hint;
+
+  /** the number of calls to f() */
+  unsigned n_evaluations;
+
 public:
   /**
    * Constructor of zero finder search algorithm
@@ -49,7 +83,8 @@ public:
    * @param _tolerance Absolute tolerance of solution (in x)
    */
   ZeroFinder(const fixed _xmin, const fixed _xmax, const fixed _tolerance) :
-    xmin(_xmin), xmax(_xmax), tolerance(_tolerance)
+    xmin(_xmin), xmax(_xmax), tolerance(_tolerance),
+    hint(nullptr), n_evaluations(0)
   {
     assert(xmin < xmax);
   }
@@ -72,7 +107,6 @@ public:
    *
    * @return x value of best solution
    */
-  gcc_pure
   fixed find_zero(const fixed xstart);
 
   /**
@@ -84,14 +118,59 @@ public:
    *
    * @return x value of best solution
    */
-  gcc_pure
   fixed find_min(const fixed xstart);
 
+  /**
+   * Use (and update) the solution of a previous search in
+   * find_zero().  The hint must remain valid while this object is
+   * used.
+   */
+  void set_hint(Hint &_hint) {
+    hint = &_hint;
+  }
+
+protected:
+  /**
+   * Like find_zero(), but leaves the hint alone.  Subclasses which
+   * may reject a solution call this and then commit_hint() with the
+   * solution they accept.
+   */
+  fixed find_zero_tentative(const fixed xstart);
+
+  /**
+   * Remember the accepted solution in the hint (if there is one).
+   */
+  void commit_hint(const fixed x);
+
+public:
+
+  /**
+   * Returns the number of function evaluations since construction.
+   */
+  unsigned get_evaluation_count() const {
+    return n_evaluations;
+  }
+
 private:
-  gcc_pure
+  fixed evaluate(const fixed x) {
+    ++n_evaluations;
+    return f(x);
+  }
+
   fixed find_zero_actual(const fixed xstart);
 
-  gcc_pure
+  /**
+   * Search for a zero near the solution of the previous search.
+   *
+   * @return false if no zero was found nearby
+   */
+  bool find_zero_near(fixed &result);
+
+  /**
+   * Brent's root finding in the given bracket.
+   */
+  fixed find_zero_bracket(fixed a, fixed fa, fixed b, fixed fb);
+
   fixed find_min_actual(const fixed xstart);
 
   /**
@@ -114,7 +193,6 @@ private:
    *
    * @return true if no search required (xstart is good)
    */
-  gcc_pure
   bool solution_within_tolerance(const fixed xstart,
                                  const fixed tol_act);
 
@@ -41,6 +41,7 @@ MergeThread::Process()
 {
   assert(!IsDefined() || IsInside());
 
+  AllDevicesCommitSamples();
   device_blackboard.Merge();
 
   const MoreData &basic = device_blackboard.Basic();
@@ -35,6 +35,7 @@ Copyright_License {
 #include "DeviceInfo.hpp"
 #include "FLARM/Data.hpp"
 #include "Geo/SpeedVector.hpp"
+#include "Util/TypeTraits.hpp"
 
 #include <type_traits>
 
@@ -676,6 +677,7 @@ struct NMEAInfo {
   void Complement(const NMEAInfo &add);
 };
 
-static_assert(std::is_trivial<NMEAInfo>::value, "type is not trivial");
+static_assert(has_trivial_constructor_and_destructor<NMEAInfo>::value,
+              "type is not trivial");
 
 #endif
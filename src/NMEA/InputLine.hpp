@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_NMEA_INPUT_LINE_HPP
 
 #include "IO/CSVLine.hpp"
+#include "SentenceKey.hpp"
 
 /**
  * A helper class which can dissect a NMEA input line.
@@ -32,6 +33,15 @@ Copyright_License {
 class NMEAInputLine: public CSVLine {
 public:
   NMEAInputLine(const char* line);
+
+  /**
+   * Read a column (usually the sentence tag) and return its
+   * #NMEASentenceKey.
+   */
+  NMEASentenceKey ReadSentenceKey() {
+    const Range<const char *> column = ReadView();
+    return MakeNMEASentenceKey(column.begin(), column.end());
+  }
 };
 
 #endif
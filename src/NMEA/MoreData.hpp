@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_MORE_DATA_HPP
 
 #include "NMEA/Info.hpp"
+#include "Util/TypeTraits.hpp"
 
 #include <type_traits>
 
@@ -66,6 +67,7 @@ struct MoreData : public NMEAInfo {
   }
 };
 
-static_assert(std::is_trivial<MoreData>::value, "type is not trivial");
+static_assert(has_trivial_constructor_and_destructor<MoreData>::value,
+              "type is not trivial");
 
 #endif
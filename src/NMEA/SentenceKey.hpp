@@ -0,0 +1,70 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_SENTENCE_KEY_HPP
+#define XCSOAR_NMEA_SENTENCE_KEY_HPP
+
+#include "Compiler.h"
+
+#include <stdint.h>
+
+/**
+ * The tag of a NMEA sentence (e.g. "$GPRMC") packed into an integer.
+ * Parsers dispatch on it with a "switch" statement, whose "case"
+ * labels are calculated at compile time with MakeNMEASentenceKey().
+ * Tags longer than #NMEA_SENTENCE_KEY_MAX characters and empty tags
+ * have the key 0, which matches no sentence.
+ */
+typedef uint64_t NMEASentenceKey;
+
+static constexpr unsigned NMEA_SENTENCE_KEY_MAX = sizeof(NMEASentenceKey);
+
+static constexpr NMEASentenceKey
+MakeNMEASentenceKey(const char *tag, unsigned length = 0,
+                    NMEASentenceKey key = 0)
+{
+  return *tag == 0
+    ? key
+    : (length == NMEA_SENTENCE_KEY_MAX
+       ? 0
+       : MakeNMEASentenceKey(tag + 1, length + 1,
+                             (key << 8) | (uint8_t)*tag));
+}
+
+/**
+ * Calculate the key of a tag which is not null-terminated.
+ */
+gcc_pure
+static inline NMEASentenceKey
+MakeNMEASentenceKey(const char *begin, const char *end)
+{
+  if (end - begin > (int)NMEA_SENTENCE_KEY_MAX)
+    return 0;
+
+  NMEASentenceKey key = 0;
+  for (const char *p = begin; p != end; ++p)
+    key = (key << 8) | (uint8_t)*p;
+  return key;
+}
+
+#endif
@@ -43,6 +43,7 @@ Copyright_License {
 #include "BallastDumpManager.hpp"
 #include "Operation/Operation.hpp"
 #include "Tracking/TrackingGlue.hpp"
+#include "Terrain/TerrainPrefetchThread.hpp"
 #include "Operation/MessageOperationEnvironment.hpp"
 #include "Event/Idle.hpp"
 
@@ -272,4 +273,7 @@ ProcessTimer()
     tracking->OnTimer(CommonInterface::Basic(), CommonInterface::Calculated());
   }
 #endif
+
+  if (terrain_prefetch != NULL)
+    terrain_prefetch->OnTimer(CommonInterface::Basic());
 }
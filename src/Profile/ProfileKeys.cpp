@@ -135,6 +135,7 @@ const TCHAR MenuTimeout[] = _T("MenuTimeout");
 const TCHAR TerrainContrast[] = _T("TerrainContrast");
 const TCHAR TerrainBrightness[] = _T("TerrainBrightness");
 const TCHAR TerrainRamp[] = _T("TerrainRamp");
+const TCHAR TerrainThreads[] = _T("TerrainThreads");
 const TCHAR EnableFLARMMap[] = _T("EnableFLARMDisplay");
 const TCHAR EnableFLARMGauge[] = _T("EnableFLARMGauge");
 const TCHAR AutoCloseFlarmDialog[] = _T("AutoCloseFlarmDialog");
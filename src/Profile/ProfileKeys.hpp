@@ -128,6 +128,7 @@ extern const TCHAR MenuTimeout[];
 extern const TCHAR TerrainContrast[];
 extern const TCHAR TerrainBrightness[];
 extern const TCHAR TerrainRamp[];
+extern const TCHAR TerrainThreads[];
 extern const TCHAR EnableFLARMMap[];
 extern const TCHAR EnableFLARMGauge[];
 extern const TCHAR AutoCloseFlarmDialog[];
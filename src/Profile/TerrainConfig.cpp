@@ -47,4 +47,6 @@ Profile::LoadTerrainRendererSettings(TerrainRendererSettings &settings)
   if (Get(ProfileKeys::TerrainRamp, ramp) &&
       ramp < TerrainRendererSettings::NUM_RAMPS)
     settings.ramp = ramp;
+
+  Get(ProfileKeys::TerrainThreads, settings.threads);
 }
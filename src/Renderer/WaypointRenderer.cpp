@@ -102,19 +102,27 @@ struct VisibleWaypoint {
       reachable = WaypointRenderer::ReachableTerrain;
   }
 
-  void CalculateRouteArrival(const RoutePlannerGlue &route_planner,
-                             const TaskBehaviour &task_behaviour) {
+  /**
+   * Returns the destination passed to
+   * RoutePlannerGlue::FindPositiveArrival().
+   */
+  gcc_pure
+  AGeoPoint GetRouteDestination(const TaskBehaviour &task_behaviour) const {
     const RoughAltitude elevation(waypoint->elevation +
                                   task_behaviour.safety_height_arrival);
-    const AGeoPoint p_dest (waypoint->location, elevation);
-    if (route_planner.FindPositiveArrival(p_dest, reach))
-      reach.Subtract(elevation);
+    return AGeoPoint(waypoint->location, elevation);
   }
 
-  void CalculateReachability(const RoutePlannerGlue &route_planner,
+  /**
+   * Evaluate the result of RoutePlannerGlue::FindPositiveArrival()
+   * for the destination returned by GetRouteDestination().
+   */
+  void CalculateReachability(const ReachResult &result,
+                             const AGeoPoint &destination,
                              const TaskBehaviour &task_behaviour)
   {
-    CalculateRouteArrival(route_planner, task_behaviour);
+    reach = result;
+    reach.Subtract(destination.altitude);
 
     if (!reach.IsReachableDirect())
       reachable = WaypointRenderer::Unreachable;
@@ -384,15 +392,36 @@ public:
   }
 
   void CalculateRoute(const ProtectedRoutePlanner &route_planner) {
-    const ProtectedRoutePlanner::Lease lease(route_planner);
+    /* collect the destinations first, to search the reach for all of
+       them at once */
+    StaticArray<VisibleWaypoint *, 256> targets;
+    StaticArray<AGeoPoint, 256> destinations;
 
     for (auto it = waypoints.begin(), end = waypoints.end(); it != end; ++it) {
       VisibleWaypoint &vwp = *it;
       const Waypoint &way_point = *vwp.waypoint;
 
-      if (way_point.IsLandable() || way_point.flags.watched)
-        vwp.CalculateReachability(lease, task_behaviour);
+      if (way_point.IsLandable() || way_point.flags.watched) {
+        targets.append(&vwp);
+        destinations.append(vwp.GetRouteDestination(task_behaviour));
+      }
     }
+
+    if (targets.empty())
+      return;
+
+    ReachResult results[256];
+
+    {
+      const ProtectedRoutePlanner::Lease lease(route_planner);
+      if (!lease->FindPositiveArrival(destinations.begin(),
+                                      destinations.size(), results))
+        return;
+    }
+
+    for (unsigned i = 0; i < targets.size(); ++i)
+      targets[i]->CalculateReachability(results[i], destinations[i],
+                                        task_behaviour);
   }
 
   void CalculateDirect(const PolarSettings &polar_settings,
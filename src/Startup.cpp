@@ -48,7 +48,6 @@ Copyright_License {
 #include "Logger/Logger.hpp"
 #include "Logger/NMEALogger.hpp"
 #include "Logger/GlueFlightLogger.hpp"
-#include "Waypoint/WaypointDetailsReader.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "MapWindow/GlueMapWindow.hpp"
 #include "Markers/Markers.hpp"
@@ -99,6 +98,8 @@ Copyright_License {
 #include "Plane/PlaneGlue.hpp"
 #include "UIState.hpp"
 #include "Tracking/TrackingGlue.hpp"
+#include "Terrain/TerrainPrefetchThread.hpp"
+#include "Terrain/TerrainPrefetchGlue.hpp"
 #include "Units/Units.hpp"
 #include "Formatter/UserGeoPointFormatter.hpp"
 #include "Thread/Debug.hpp"
@@ -318,6 +319,7 @@ Startup()
   operation.SetText(_("Loading Terrain File..."));
   LogFormat("OpenTerrain");
   terrain = RasterTerrain::OpenTerrain(file_cache, operation);
+  terrain_prefetch = StartTerrainPrefetch(terrain);
 
   logger = new Logger();
 
@@ -348,10 +350,7 @@ Startup()
   LoadConfiguredTopography(*topography, operation);
 
   // Read the waypoint files
-  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
-
-  // Read and parse the airfield info file
-  WaypointDetails::ReadFileFromProfile(way_points, operation);
+  WaypointGlue::LoadWaypoints(way_points, terrain, file_cache, operation);
 
   // Set the home waypoint
   WaypointGlue::SetHome(way_points, terrain,
@@ -368,8 +367,8 @@ Startup()
   RASP.ScanAll(CommonInterface::Basic().location, operation);
 
   // Reads the airspace files
-  ReadAirspace(airspace_database, terrain, computer_settings.pressure,
-               operation);
+  ReadAirspace(airspace_database, terrain, file_cache,
+               computer_settings.pressure, operation);
 
   {
     const AircraftState aircraft_state =
@@ -508,6 +507,9 @@ Shutdown()
   // Turn off all displays
   global_running = false;
 
+  if (terrain_prefetch != NULL)
+    terrain_prefetch->StopAsync();
+
 #ifdef HAVE_TRACKING
   if (tracking != NULL)
     tracking->StopAsync();
@@ -584,6 +586,9 @@ Shutdown()
 
   // Clear terrain database
 
+  StopTerrainPrefetch(terrain_prefetch);
+  terrain_prefetch = NULL;
+
   delete terrain;
   delete topography;
 
@@ -208,6 +208,15 @@ ProtectedTaskManager::SetRoutePlanner(const RoutePlannerGlue *_route) {
   lease->SetIntersectionTest(&intersection_test);
 }
 
+gcc_pure
+static bool
+IsIntersecting(const ReachResult &result, const AGeoPoint &destination)
+{
+  return result.terrain_valid == ReachResult::Validity::UNREACHABLE ||
+    (result.terrain_valid == ReachResult::Validity::VALID &&
+     result.terrain < destination.altitude);
+}
+
 bool
 ReachIntersectionTest::Intersects(const AGeoPoint& destination)
 {
@@ -220,7 +229,23 @@ ReachIntersectionTest::Intersects(const AGeoPoint& destination)
 
   // we use find_positive_arrival here instead of is_inside, because may use
   // arrival height for sorting later
-  return result.terrain_valid == ReachResult::Validity::UNREACHABLE ||
-    (result.terrain_valid == ReachResult::Validity::VALID &&
-     result.terrain < destination.altitude);
+  return IsIntersecting(result, destination);
+}
+
+void
+ReachIntersectionTest::Intersects(const std::vector<AGeoPoint> &destinations,
+                                  std::vector<bool> &results)
+{
+  results.assign(destinations.size(), false);
+
+  if (!route || destinations.empty())
+    return;
+
+  std::vector<ReachResult> reach(destinations.size());
+  if (!route->FindPositiveArrival(destinations.data(), destinations.size(),
+                                  reach.data()))
+    return;
+
+  for (unsigned i = 0, n = destinations.size(); i < n; ++i)
+    results[i] = IsIntersecting(reach[i], destinations[i]);
 }
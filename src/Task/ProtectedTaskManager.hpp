@@ -42,6 +42,8 @@ public:
   }
 
   virtual bool Intersects(const AGeoPoint& destination);
+  virtual void Intersects(const std::vector<AGeoPoint> &destinations,
+                          std::vector<bool> &results);
 };
 
 /**
@@ -25,12 +25,26 @@
 #include "Terrain/RasterTerrain.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "NMEA/Derived.hpp"
+
+#include <algorithm>
+
 #include <assert.h>
 
 RoutePlannerGlue::RoutePlannerGlue(const Airspaces &master):
   terrain(NULL),
-  planner(master)
+  planner(master),
+  arrival_serial(planner.GetReachSerial())
+{
+}
+
+bool
+RoutePlannerGlue::CachedArrival::operator<(const CachedArrival &other) const
 {
+  if (destination.latitude != other.destination.latitude)
+    return destination.latitude < other.destination.latitude;
+  if (destination.longitude != other.destination.longitude)
+    return destination.longitude < other.destination.longitude;
+  return destination.altitude < other.destination.altitude;
 }
 
 void
@@ -74,7 +88,57 @@ bool
 RoutePlannerGlue::FindPositiveArrival(const AGeoPoint &dest,
                                       ReachResult &result_r) const
 {
-  return planner.FindPositiveArrival(dest, result_r);
+  return FindPositiveArrival(&dest, 1, &result_r);
+}
+
+bool
+RoutePlannerGlue::FindPositiveArrival(const AGeoPoint *dests, unsigned n,
+                                      ReachResult *results) const
+{
+  if (planner.IsReachEmpty())
+    return false;
+
+  ScopeLock protect(arrival_mutex);
+
+  if (arrival_serial != planner.GetReachSerial()) {
+    arrival_cache.clear();
+    arrival_serial = planner.GetReachSerial();
+  }
+
+  std::vector<AGeoPoint> missing;
+  std::vector<unsigned> missing_index;
+
+  for (unsigned i = 0; i < n; ++i) {
+    CachedArrival key;
+    key.destination = dests[i];
+
+    const auto found = std::lower_bound(arrival_cache.begin(),
+                                        arrival_cache.end(), key);
+    if (found != arrival_cache.end() && !(key < *found)) {
+      results[i] = found->result;
+    } else {
+      missing.push_back(dests[i]);
+      missing_index.push_back(i);
+    }
+  }
+
+  if (missing.empty())
+    return true;
+
+  std::vector<ReachResult> solved(missing.size());
+  planner.FindPositiveArrival(missing.data(), missing.size(), solved.data());
+
+  for (unsigned i = 0, end = missing.size(); i < end; ++i) {
+    results[missing_index[i]] = solved[i];
+
+    CachedArrival item;
+    item.destination = missing[i];
+    item.result = solved[i];
+    arrival_cache.push_back(item);
+  }
+
+  std::sort(arrival_cache.begin(), arrival_cache.end());
+  return true;
 }
 
 void
@@ -23,6 +23,10 @@
 #define ROUTE_PLANNER_GLUE_HPP
 
 #include "Route/AirspaceRoute.hpp"
+#include "Route/ReachResult.hpp"
+#include "Thread/Mutex.hpp"
+
+#include <vector>
 
 struct GlideSettings;
 class RoughAltitude;
@@ -32,6 +36,33 @@ class RoutePlannerGlue {
   const RasterTerrain *terrain;
   AirspaceRoute planner;
 
+  struct CachedArrival {
+    AGeoPoint destination;
+    ReachResult result;
+
+    gcc_pure
+    bool operator<(const CachedArrival &other) const;
+  };
+
+  /**
+   * Protects the arrival cache, which is filled by const methods that
+   * may be called by the map and the calculation thread at the same
+   * time.
+   */
+  mutable Mutex arrival_mutex;
+
+  /**
+   * The results of FindPositiveArrival(), sorted by destination, so
+   * all clients share one calculation per reach solution.
+   */
+  mutable std::vector<CachedArrival> arrival_cache;
+
+  /**
+   * The RoutePlanner::GetReachSerial() value #arrival_cache belongs
+   * to.
+   */
+  mutable unsigned arrival_serial;
+
 public:
   RoutePlannerGlue(const Airspaces &master);
 
@@ -42,6 +73,7 @@ public:
                    const GlidePolar &safety_polar,
                    const SpeedVector &wind) {
     planner.UpdatePolar(settings, polar, safety_polar, wind);
+    ClearArrivalCache();
   }
 
   void Synchronise(const Airspaces &master, const AGeoPoint &origin,
@@ -72,14 +104,47 @@ public:
   void SolveReach(const AGeoPoint &origin, const RoutePlannerConfig &config,
                   RoughAltitude h_ceiling, bool do_solve);
 
+  /**
+   * @see RoutePlanner::PrepareReach()
+   */
+  gcc_pure
+  RoutePolars PrepareReach(const AGeoPoint &origin,
+                           const RoutePlannerConfig &config,
+                           RoughAltitude h_ceiling) const {
+    return planner.PrepareReach(origin, config, h_ceiling);
+  }
+
+  /**
+   * @see RoutePlanner::SwapReach()
+   */
+  void SwapReach(ReachFan &other, const RoutePolars &polars) {
+    planner.SwapReach(other, polars);
+  }
+
   bool FindPositiveArrival(const AGeoPoint &dest, ReachResult &result_r) const;
 
+  /**
+   * Batched version of FindPositiveArrival().  Results are cached
+   * until the reach or the polar changes; destinations not found in
+   * the cache are calculated in one pass over the reach fans.
+   *
+   * @param results receives one result per destination
+   */
+  bool FindPositiveArrival(const AGeoPoint *dests, unsigned n,
+                           ReachResult *results) const;
+
   void AcceptInRange(const GeoBounds &bounds, TriangleFanVisitor &visitor) const;
 
   bool Intersection(const AGeoPoint &origin, const AGeoPoint &destination,
                     GeoPoint &intx) const;
 
   RoughAltitude GetTerrainBase() const;
+
+private:
+  void ClearArrivalCache() {
+    ScopeLock protect(arrival_mutex);
+    arrival_cache.clear();
+  }
 };
 
 #endif
@@ -505,7 +505,7 @@ TaskFileSeeYou::GetTask(const TaskBehaviour &task_behaviour,
       return NULL;
 
     // Try to find waypoint by name
-    const Waypoint* wp = waypoints->LookupName(file_wp->name);
+    const Waypoint* wp = waypoints->LookupName(file_wp->name.c_str());
 
     // If waypoint by name found and closer than 10m to the original
     if (wp != NULL &&
@@ -30,7 +30,11 @@ Copyright_License {
 #include "Projection/WindowProjection.hpp"
 #endif
 
+#include <algorithm>
+
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 void
 HeightMatrix::SetSize(size_t _size)
@@ -87,13 +91,112 @@ HeightMatrix::Fill(const RasterMap &map, const WindowProjection &projection,
   SetSize((screen_width + quantisation_pixels - 1) / quantisation_pixels,
           (screen_height + quantisation_pixels - 1) / quantisation_pixels);
 
-  short *p = data.begin();
-  for (unsigned y = 0; y < screen_height;
-       y += quantisation_pixels, p += width) {
-    map.ScanLine(projection.ScreenToGeo(0, y),
-                 projection.ScreenToGeo(screen_width, y),
+  FillRows(map, projection, quantisation_pixels, 0, 0, 0, height,
+           interpolate);
+}
+
+void
+HeightMatrix::FillRows(const RasterMap &map,
+                       const WindowProjection &projection,
+                       unsigned quantisation_pixels,
+                       int offset_x, int offset_y,
+                       unsigned y0, unsigned y1, bool interpolate)
+{
+  assert(y0 <= y1);
+  assert(y1 <= height);
+
+  const int q = quantisation_pixels;
+  const int left = offset_x * q;
+  const int right = (offset_x + (int)width - 1) * q;
+
+  short *p = data.begin() + y0 * width;
+  for (unsigned y = y0; y < y1; ++y, p += width) {
+    const int screen_y = (offset_y + (int)y) * q;
+    map.ScanLine(projection.ScreenToGeo(left, screen_y),
+                 projection.ScreenToGeo(right, screen_y),
                  p, width, interpolate);
   }
 }
 
+void
+HeightMatrix::FillColumns(const RasterMap &map,
+                          const WindowProjection &projection,
+                          unsigned quantisation_pixels,
+                          int offset_x, int offset_y,
+                          unsigned x0, unsigned x1, unsigned y0, unsigned y1,
+                          bool interpolate)
+{
+  assert(x0 <= x1);
+  assert(x1 <= width);
+  assert(y0 < y1);
+  assert(y1 <= height);
+
+  const unsigned n = y1 - y0;
+  column.GrowDiscard(n);
+
+  const int q = quantisation_pixels;
+  const int top = (offset_y + (int)y0) * q;
+  const int bottom = (offset_y + (int)y1 - 1) * q;
+
+  for (unsigned x = x0; x < x1; ++x) {
+    const int screen_x = (offset_x + (int)x) * q;
+    map.ScanLine(projection.ScreenToGeo(screen_x, top),
+                 projection.ScreenToGeo(screen_x, bottom),
+                 column.begin(), n, interpolate);
+
+    short *p = data.begin() + y0 * width + x;
+    for (unsigned i = 0; i < n; ++i, p += width)
+      *p = column[i];
+  }
+}
+
+void
+HeightMatrix::Scroll(const RasterMap &map, const WindowProjection &projection,
+                     unsigned quantisation_pixels,
+                     int offset_x, int offset_y, int dx, int dy,
+                     bool interpolate)
+{
+  assert(abs(dx) < (int)width);
+  assert(abs(dy) < (int)height);
+
+  /* move the cells which remain visible; memmove() because source
+     and destination overlap if dy is 0 */
+
+  const size_t n = (width - abs(dx)) * sizeof(short);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  if (dy >= 0) {
+    for (unsigned y = 0; y + dy < height; ++y)
+      memmove(data.begin() + y * width + dest_x,
+              GetRow(y + dy) + src_x, n);
+  } else {
+    for (unsigned y = height - 1; y >= (unsigned)-dy; --y)
+      memmove(data.begin() + y * width + dest_x,
+              GetRow(y + dy) + src_x, n);
+  }
+
+  /* fill the exposed rows */
+
+  unsigned y0 = 0, y1 = height;
+  if (dy > 0) {
+    y1 = height - dy;
+    FillRows(map, projection, quantisation_pixels, offset_x, offset_y,
+             y1, height, interpolate);
+  } else if (dy < 0) {
+    y0 = -dy;
+    FillRows(map, projection, quantisation_pixels, offset_x, offset_y,
+             0, y0, interpolate);
+  }
+
+  /* fill the exposed columns of the other rows; scanning vertical
+     lines avoids lots of very short ScanLine() calls */
+
+  if (dx > 0)
+    FillColumns(map, projection, quantisation_pixels, offset_x, offset_y,
+                width - dx, width, y0, y1, interpolate);
+  else if (dx < 0)
+    FillColumns(map, projection, quantisation_pixels, offset_x, offset_y,
+                0, -dx, y0, y1, interpolate);
+}
+
 #endif
@@ -40,6 +40,13 @@ class HeightMatrix : private NonCopyable {
   AllocatedArray<short> data;
   unsigned width, height;
 
+#ifndef ENABLE_OPENGL
+  /**
+   * A temporary buffer for FillColumns().
+   */
+  AllocatedArray<short> column;
+#endif
+
 public:
   HeightMatrix():width(0), height(0) {}
 
@@ -57,10 +64,49 @@ public:
             unsigned _width, unsigned _height, bool interpolate);
 #else
   /**
+   * Cell (x, y) is filled with the height at screen pixel (x, y)
+   * multiplied by the quantisation.
+   *
    * @param interpolate true enables interpolation of sub-pixel values
    */
   void Fill(const RasterMap &map, const WindowProjection &map_projection,
             unsigned quantisation_pixels, bool interpolate);
+
+  /**
+   * Move the contents after the projection has been translated, and
+   * fill only the cells which have become exposed.  Afterwards, cell
+   * (x, y) contains what cell (x + dx, y + dy) contained before.
+   *
+   * @param map_projection the projection which was passed to Fill()
+   * @param offset_x the horizontal position of the new cell origin
+   * relative to the one of the Fill() call, in cells
+   * @param offset_y the vertical position of the new cell origin
+   * relative to the one of the Fill() call, in cells
+   */
+  void Scroll(const RasterMap &map, const WindowProjection &map_projection,
+              unsigned quantisation_pixels,
+              int offset_x, int offset_y, int dx, int dy,
+              bool interpolate);
+
+private:
+  /**
+   * Fill the rows y0 to y1 (exclusive) by scanning horizontal lines.
+   */
+  void FillRows(const RasterMap &map, const WindowProjection &map_projection,
+                unsigned quantisation_pixels, int offset_x, int offset_y,
+                unsigned y0, unsigned y1, bool interpolate);
+
+  /**
+   * Fill the columns x0 to x1 (exclusive) within the rows y0 to y1
+   * (exclusive) by scanning vertical lines.
+   */
+  void FillColumns(const RasterMap &map,
+                   const WindowProjection &map_projection,
+                   unsigned quantisation_pixels, int offset_x, int offset_y,
+                   unsigned x0, unsigned x1, unsigned y0, unsigned y1,
+                   bool interpolate);
+
+public:
 #endif
 
   unsigned GetWidth() const {
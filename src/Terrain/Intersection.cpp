@@ -27,6 +27,7 @@ Copyright_License {
 #include <string.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <limits>
 
 //#define DEBUG_TILE
 #ifdef DEBUG_TILE
@@ -115,6 +116,28 @@ RasterTileCache::FirstIntersection(const int x0, const int y0,
   printf("# fint width %d height %d\n", width, height);
 #endif
 
+  if (slope_fact >= 0) {
+    /* the glide line is rising; if it is above the terrain's maximum
+       height everywhere, there's no need to walk it.  Both end
+       heights are capped like the walk below caps h_int; the straight
+       line between them stays below the capped glide line */
+    int h_first = h_origin;
+    int h_last = h_origin + ((max_steps * slope_fact) >> RASTER_SLOPE_FACT);
+    if (can_climb) {
+      h_first = std::min(h_first, h_dest);
+      h_last = std::min(h_last, h_dest);
+    }
+
+    if (h_last <= h_ceiling &&
+        IsClear(x0, y0, x1, y1, CLEAR_MARGIN,
+                h_first - h_safety, h_last - h_safety, CLEAR_MIN_DISTANCE)) {
+#ifdef DEBUG_TILE
+      printf("# fint proven clear\n");
+#endif
+      return false;
+    }
+  }
+
   // location of last point within ceiling limit that doesnt intersect
   RasterLocation last_clear_location = location;
   int last_clear_h = h_origin;
@@ -262,6 +285,113 @@ RasterTileCache::GetFieldDirect(const unsigned px, const unsigned py) const
   return std::make_pair(overview.Get(x_overview, y_overview), false);
 }
 
+short
+RasterTileCache::GetMaximum(int x0, int y0, int x1, int y1) const
+{
+  assert(x0 <= x1);
+  assert(y0 <= y1);
+
+  /* clip to the map; pixels outside are never sampled */
+
+  if (x1 < 0 || y1 < 0 || x0 >= (int)width || y0 >= (int)height)
+    return RasterBuffer::TERRAIN_INVALID;
+
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, (int)width - 1);
+  y1 = std::min(y1, (int)height - 1);
+
+  if (!overview_pyramid.IsDefined())
+    /* unknown */
+    return std::numeric_limits<short>::max();
+
+  /* GetFieldDirect() clips overview coordinates the same way */
+  const unsigned overview_x1 =
+    std::min((unsigned)x1 >> OVERVIEW_BITS, overview.GetWidth() - 1);
+  const unsigned overview_y1 =
+    std::min((unsigned)y1 >> OVERVIEW_BITS, overview.GetHeight() - 1);
+  const unsigned overview_x0 =
+    std::min((unsigned)x0 >> OVERVIEW_BITS, overview_x1);
+  const unsigned overview_y0 =
+    std::min((unsigned)y0 >> OVERVIEW_BITS, overview_y1);
+
+  short result = overview_pyramid.GetMaximum(overview_x0, overview_y0,
+                                             overview_x1, overview_y1);
+
+  /* the loaded tiles may have higher peaks than the overview */
+
+  const unsigned column1 = std::min((unsigned)x1 / tile_width,
+                                    tiles.GetWidth() - 1);
+  const unsigned row1 = std::min((unsigned)y1 / tile_height,
+                                 tiles.GetHeight() - 1);
+
+  for (unsigned row = (unsigned)y0 / tile_height; row <= row1; ++row) {
+    for (unsigned column = (unsigned)x0 / tile_width; column <= column1;
+         ++column) {
+      const RasterTile &tile = tiles.Get(column, row);
+      if (tile.IsEnabled())
+        result = std::max(result, tile.GetMaximum(x0, y0, x1, y1));
+    }
+  }
+
+  return result;
+}
+
+bool
+RasterTileCache::IsClear(int x0, int y0, int x1, int y1, unsigned margin,
+                         int h0, int h1, int min_distance) const
+{
+  const int dx = x1 - x0, dy = y1 - y0, dh = h1 - h0;
+  const int distance = abs(dx) + abs(dy);
+
+  /* the line is divided into at most "n" pieces; the end points of
+     each piece are calculated from the parameter of the whole line,
+     to avoid accumulating rounding errors */
+  int n = 1;
+  while (n < (int)CLEAR_MAX_PIECES && distance / (2 * n) >= min_distance)
+    n *= 2;
+
+  struct Range {
+    int begin, end;
+  };
+
+  /* depth-first bisection, with an explicit stack */
+  Range stack[16];
+  unsigned top = 0;
+  stack[top++] = { 0, n };
+
+  while (top > 0) {
+    const Range range = stack[--top];
+
+    const int ax = x0 + dx * range.begin / n, ay = y0 + dy * range.begin / n;
+    const int bx = x0 + dx * range.end / n, by = y0 + dy * range.end / n;
+
+    /* the heights are linear along the line; subtract one to account
+       for rounding */
+    const int h = std::min(h0 + dh * range.begin / n,
+                           h0 + dh * range.end / n) - 1;
+
+    const short h_terrain =
+      GetMaximum(std::min(ax, bx) - (int)margin,
+                 std::min(ay, by) - (int)margin,
+                 std::max(ax, bx) + (int)margin,
+                 std::max(ay, by) + (int)margin);
+    if (h_terrain <= h)
+      continue;
+
+    if (range.end - range.begin == 1)
+      /* can't bisect any further */
+      return false;
+
+    const int middle = (range.begin + range.end) / 2;
+    assert(top + 2 <= sizeof(stack) / sizeof(stack[0]));
+    stack[top++] = { middle, range.end };
+    stack[top++] = { range.begin, middle };
+  }
+
+  return true;
+}
+
 RasterLocation
 RasterTileCache::Intersection(const int x0, const int y0,
                               const int x1, const int y1,
@@ -304,6 +434,16 @@ RasterTileCache::Intersection(const int x0, const int y0,
   printf("# step fine %d\n", step_fine);
 #endif
 
+  if (slope_fact >= 0) {
+    /* the glide line is descending; the walk below may sample up to
+       two steps beyond the destination */
+    const int h_last = h_origin -
+      (((max_steps + 2) * slope_fact) >> RASTER_SLOPE_FACT);
+    if (IsClear(x0, y0, x1, y1, CLEAR_MARGIN, h_origin, h_last,
+                CLEAR_MIN_DISTANCE))
+      return RasterLocation(x1, y1);
+  }
+
   RasterLocation last_clear_location = location;
   int last_clear_h = h_origin;
 
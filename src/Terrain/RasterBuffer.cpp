@@ -27,12 +27,243 @@ Copyright_License {
 #include <algorithm>
 #include <assert.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#include <string.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HAVE_NEON
+#endif
+
+/**
+ * The parameters of one bilinear interpolation: the top left pixel,
+ * the offsets to its right and lower neighbours, and the sub-pixel
+ * position (0..255) within the four pixels.
+ */
+struct InterpolationSample {
+  const short *tm;
+  unsigned dx, dy;
+  unsigned ix, iy;
+};
+
+static inline short
+Interpolate(const InterpolationSample &s)
+{
+  const short *tm = s.tm;
+  const unsigned dx = s.dx, dy = s.dy;
+
+  if (RasterBuffer::IsSpecial(*tm) || RasterBuffer::IsSpecial(tm[dx]) ||
+      RasterBuffer::IsSpecial(tm[dy]) || RasterBuffer::IsSpecial(tm[dx + dy]))
+    return *tm;
+
+  const unsigned ix = s.ix, iy = s.iy;
+  unsigned kx = 0x100 - ix;
+  unsigned ky = 0x100 - iy;
+
+  return (*tm * kx * ky + tm[dx] * ix * ky + tm[dy] * kx * iy + tm[dx + dy] * ix * iy) >> 16;
+}
+
+#ifdef __SSE2__
+
+/**
+ * Multiply 32 bit integers, keeping the lower 32 bits of each
+ * product.  This emulates _mm_mullo_epi32(), which requires SSE4.1.
+ */
+static inline __m128i
+MultiplyLow32(__m128i a, __m128i b)
+{
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4),
+                                    _mm_srli_si128(b, 4));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * Load a pixel and its right neighbour (which is the pixel itself at
+ * the right edge) as one 32 bit integer.
+ */
+static inline int
+LoadPair(const short *p, unsigned dx)
+{
+  if (gcc_likely(dx > 0)) {
+    int result;
+    memcpy(&result, p, sizeof(result));
+    return result;
+  }
+
+  return (int)(unsigned short)*p | ((int)*p << 16);
+}
+
+/**
+ * Four interpolations at a time.  The result is bit-identical to
+ * Interpolate(): the sum of the four weighted pixels always fits
+ * into a signed 32 bit integer (the weights add up to 0x10000, and
+ * special values are excluded), so the arithmetic shift yields the
+ * same lower 16 bits as the unsigned arithmetic of the scalar
+ * version.
+ */
+static inline void
+Interpolate4(const InterpolationSample *s, short *dest)
+{
+  /* pairs of horizontal neighbours, for _mm_madd_epi16() */
+  const __m128i top =
+    _mm_setr_epi32(LoadPair(s[0].tm, s[0].dx), LoadPair(s[1].tm, s[1].dx),
+                   LoadPair(s[2].tm, s[2].dx), LoadPair(s[3].tm, s[3].dx));
+  const __m128i bottom =
+    _mm_setr_epi32(LoadPair(s[0].tm + s[0].dy, s[0].dx),
+                   LoadPair(s[1].tm + s[1].dy, s[1].dx),
+                   LoadPair(s[2].tm + s[2].dy, s[2].dx),
+                   LoadPair(s[3].tm + s[3].dy, s[3].dx));
+  const __m128i kx =
+    _mm_setr_epi16(0x100 - s[0].ix, s[0].ix, 0x100 - s[1].ix, s[1].ix,
+                   0x100 - s[2].ix, s[2].ix, 0x100 - s[3].ix, s[3].ix);
+  const __m128i iy = _mm_setr_epi32(s[0].iy, s[1].iy, s[2].iy, s[3].iy);
+  const __m128i ky = _mm_sub_epi32(_mm_set1_epi32(0x100), iy);
+
+  const __m128i sum =
+    _mm_add_epi32(MultiplyLow32(_mm_madd_epi16(top, kx), ky),
+                  MultiplyLow32(_mm_madd_epi16(bottom, kx), iy));
+  const __m128i result = _mm_srai_epi32(sum, 16);
+
+  /* fall back to the top left pixel if one of the four is special */
+  const __m128i threshold =
+    _mm_set1_epi16(RasterBuffer::TERRAIN_WATER_THRESHOLD + 1);
+  const __m128i special = _mm_or_si128(_mm_cmplt_epi16(top, threshold),
+                                       _mm_cmplt_epi16(bottom, threshold));
+  const __m128i regular = _mm_cmpeq_epi32(special, _mm_setzero_si128());
+  const __m128i top_left = _mm_srai_epi32(_mm_slli_epi32(top, 16), 16);
+  const __m128i value = _mm_or_si128(_mm_and_si128(regular, result),
+                                     _mm_andnot_si128(regular, top_left));
+
+  _mm_storel_epi64((__m128i *)dest, _mm_packs_epi32(value, value));
+}
+
+#elif defined(HAVE_NEON)
+
+/**
+ * Four interpolations at a time.  The result is bit-identical to
+ * Interpolate(), see the SSE2 version.
+ */
+static inline void
+Interpolate4(const InterpolationSample *s, short *dest)
+{
+  const int16_t a[4] = {
+    s[0].tm[0], s[1].tm[0], s[2].tm[0], s[3].tm[0],
+  };
+  const int16_t b[4] = {
+    s[0].tm[s[0].dx], s[1].tm[s[1].dx], s[2].tm[s[2].dx], s[3].tm[s[3].dx],
+  };
+  const int16_t c[4] = {
+    s[0].tm[s[0].dy], s[1].tm[s[1].dy], s[2].tm[s[2].dy], s[3].tm[s[3].dy],
+  };
+  const int16_t d[4] = {
+    s[0].tm[s[0].dx + s[0].dy], s[1].tm[s[1].dx + s[1].dy],
+    s[2].tm[s[2].dx + s[2].dy], s[3].tm[s[3].dx + s[3].dy],
+  };
+  const int32_t ix_[4] = {
+    (int32_t)s[0].ix, (int32_t)s[1].ix, (int32_t)s[2].ix, (int32_t)s[3].ix,
+  };
+  const int32_t iy_[4] = {
+    (int32_t)s[0].iy, (int32_t)s[1].iy, (int32_t)s[2].iy, (int32_t)s[3].iy,
+  };
+
+  const int32x4_t va = vmovl_s16(vld1_s16(a));
+  const int32x4_t vb = vmovl_s16(vld1_s16(b));
+  const int32x4_t vc = vmovl_s16(vld1_s16(c));
+  const int32x4_t vd = vmovl_s16(vld1_s16(d));
+
+  const int32x4_t one = vdupq_n_s32(0x100);
+  const int32x4_t ix = vld1q_s32(ix_), iy = vld1q_s32(iy_);
+  const int32x4_t kx = vsubq_s32(one, ix), ky = vsubq_s32(one, iy);
+
+  const int32x4_t h_top = vmlaq_s32(vmulq_s32(va, kx), vb, ix);
+  const int32x4_t h_bottom = vmlaq_s32(vmulq_s32(vc, kx), vd, ix);
+  const int32x4_t result =
+    vshrq_n_s32(vmlaq_s32(vmulq_s32(h_top, ky), h_bottom, iy), 16);
+
+  /* fall back to the top left pixel if one of the four is special */
+  const int32x4_t threshold = vdupq_n_s32(RasterBuffer::TERRAIN_WATER_THRESHOLD);
+  const uint32x4_t special =
+    vorrq_u32(vorrq_u32(vcleq_s32(va, threshold), vcleq_s32(vb, threshold)),
+              vorrq_u32(vcleq_s32(vc, threshold), vcleq_s32(vd, threshold)));
+
+  vst1_s16(dest, vmovn_s32(vbslq_s32(special, va, result)));
+}
+
+#endif
+
+/**
+ * Perform a number of interpolations, using SIMD instructions if
+ * available.
+ */
+static void
+InterpolateSamples(const InterpolationSample *gcc_restrict samples,
+                   unsigned n, short *gcc_restrict dest)
+{
+#if defined(__SSE2__) || defined(HAVE_NEON)
+  for (; n >= 4; n -= 4, samples += 4, dest += 4)
+    Interpolate4(samples, dest);
+#endif
+
+  for (; n > 0; --n)
+    *dest++ = Interpolate(*samples++);
+}
+
+/**
+ * Collects #InterpolationSample objects and submits them to
+ * InterpolateSamples() in batches.
+ */
+class InterpolationBatch {
+  static constexpr unsigned CAPACITY = 64;
+
+  const RasterBuffer &buffer;
+  short *dest;
+
+  unsigned n;
+  InterpolationSample samples[CAPACITY];
+
+public:
+  InterpolationBatch(const RasterBuffer &_buffer, short *_dest)
+    :buffer(_buffer), dest(_dest), n(0) {}
+
+  ~InterpolationBatch() {
+    Flush();
+  }
+
+  void Add(unsigned lx, unsigned ly, unsigned ix, unsigned iy) {
+    assert(lx < buffer.GetWidth());
+    assert(ly < buffer.GetHeight());
+    assert(ix < 0x100);
+    assert(iy < 0x100);
+
+    InterpolationSample &s = samples[n];
+    s.tm = buffer.GetDataAt(lx, ly);
+    s.dx = (lx == buffer.GetWidth() - 1) ? 0 : 1;
+    s.dy = (ly == buffer.GetHeight() - 1) ? 0 : buffer.GetWidth();
+    s.ix = ix;
+    s.iy = iy;
+
+    if (++n == CAPACITY)
+      Flush();
+  }
+
+  void Flush() {
+    InterpolateSamples(samples, n, dest);
+    dest += n;
+    n = 0;
+  }
+};
+
 void
 RasterBuffer::Resize(unsigned _width, unsigned _height)
 {
   assert(_width > 0 && _height > 0);
 
-  data.GrowDiscard(_width, _height);
+  storage.GrowDiscard(_width * _height);
+  data = storage.begin();
+  width = _width;
+  height = _height;
 }
 
 short
@@ -46,18 +277,14 @@ RasterBuffer::GetInterpolated(unsigned lx, unsigned ly,
   assert(iy < 0x100);
 
   // perform piecewise linear interpolation
-  const unsigned int dx = (lx == GetWidth() - 1) ? 0 : 1;
-  const unsigned int dy = (ly == GetHeight() - 1) ? 0 : GetWidth();
-  const short *tm = GetDataAt(lx, ly);
-
-  if (IsSpecial(*tm) || IsSpecial(tm[dx]) ||
-      IsSpecial(tm[dy]) || IsSpecial(tm[dx + dy]))
-    return *tm;
-
-  unsigned kx = 0x100 - ix;
-  unsigned ky = 0x100 - iy;
-
-  return (*tm * kx * ky + tm[dx] * ix * ky + tm[dy] * kx * iy + tm[dx + dy] * ix * iy) >> 16;
+  InterpolationSample s;
+  s.tm = GetDataAt(lx, ly);
+  s.dx = (lx == GetWidth() - 1) ? 0 : 1;
+  s.dy = (ly == GetHeight() - 1) ? 0 : GetWidth();
+  s.ix = ix;
+  s.iy = iy;
+
+  return Interpolate(s);
 }
 
 short
@@ -140,12 +367,14 @@ RasterBuffer::ScanHorizontalLine(unsigned ax, unsigned bx, unsigned y,
     unsigned cy = y;
     const unsigned int iy = CombinedDivAndMod(cy);
 
+    InterpolationBatch batch(*this, buffer);
+
     --size;
     for (int i = 0; (unsigned)i <= size; ++i) {
       unsigned cx = ax + (i * dx) / (int)size;
       const unsigned int ix = CombinedDivAndMod(cx);
 
-      *buffer++ = GetInterpolated(cx, cy, ix, iy);
+      batch.Add(cx, cy, ix, iy);
     }
   } else if (gcc_likely(dx > 0)) {
     /* no interpolation needed, forward scan */
@@ -205,6 +434,8 @@ RasterBuffer::ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
   if (interpolate && (unsigned)(abs(dx) + abs(dy)) < (2 * size << 8u)) {
     /* interpolate */
 
+    InterpolationBatch batch(*this, buffer);
+
     for (int i = 0; (unsigned)i <= size; ++i) {
       unsigned cx = ax + (i * dx) / (int)size;
       unsigned cy = ay + (i * dy) / (int)size;
@@ -212,7 +443,7 @@ RasterBuffer::ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
       const unsigned int ix = CombinedDivAndMod(cx);
       const unsigned int iy = CombinedDivAndMod(cy);
 
-      *buffer++ = GetInterpolated(cx, cy, ix, iy);
+      batch.Add(cx, cy, ix, iy);
     }
   } else {
     /* no interpolation needed */
@@ -250,5 +481,5 @@ RasterBuffer::ScanLineChecked(unsigned ax, unsigned ay,
 short
 RasterBuffer::GetMaximum() const
 {
-  return IsDefined() ? *std::max_element(data.begin(), data.end()) : 0;
+  return IsDefined() ? *std::max_element(data, data + width * height) : 0;
 }
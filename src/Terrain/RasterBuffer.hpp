@@ -25,10 +25,11 @@ Copyright_License {
 #define XCSOAR_RASTER_BUFFER_HPP
 
 #include "Util/NonCopyable.hpp"
-#include "Util/AllocatedGrid.hpp"
+#include "Util/AllocatedArray.hpp"
 #include "Compiler.h"
 
 #include <cstddef>
+#include <assert.h>
 
 class RasterBuffer : private NonCopyable {
 public:
@@ -67,23 +68,45 @@ public:
   }
 
 private:
-  AllocatedGrid<short> data;
+  /**
+   * The memory owned by this object.  It is empty if the buffer is
+   * undefined or if it refers to foreign memory (see SetMapped()).
+   */
+  AllocatedArray<short> storage;
+
+  /**
+   * Pointer to the first value; either the beginning of #storage or
+   * read-only memory owned by somebody else.  nullptr if the buffer
+   * is undefined.
+   */
+  const short *data;
+
+  unsigned width, height;
 
 public:
-  RasterBuffer() = default;
+  RasterBuffer():data(nullptr), width(0), height(0) {}
   RasterBuffer(unsigned _width, unsigned _height)
-    :data(_width, _height) {}
+    :storage(_width * _height), data(storage.begin()),
+     width(_width), height(_height) {}
 
   bool IsDefined() const {
-    return data.IsDefined();
+    return data != nullptr;
+  }
+
+  /**
+   * Does this buffer refer to foreign read-only memory instead of
+   * owning its values?
+   */
+  bool IsMapped() const {
+    return data != nullptr && storage.empty();
   }
 
   unsigned GetWidth() const {
-    return data.GetWidth();
+    return width;
   }
 
   unsigned GetHeight() const {
-    return data.GetHeight();
+    return height;
   }
 
   unsigned GetFineWidth() const {
@@ -95,23 +118,45 @@ public:
   }
 
   short *GetData() {
-    return data.begin();
+    assert(!IsMapped());
+
+    return storage.begin();
   }
 
   const short *GetData() const {
-    return data.begin();
+    return data;
   }
 
   const short *GetDataAt(unsigned x, unsigned y) const {
-    return data.GetPointerAt(x, y);
+    assert(x < width);
+    assert(y < height);
+
+    return data + y * width + x;
   }
 
   void Reset() {
-    data.Reset();
+    storage.ResizeDiscard(0);
+    data = nullptr;
+    width = height = 0;
   }
 
   void Resize(unsigned _width, unsigned _height);
 
+  /**
+   * Let this buffer refer to the specified read-only memory, which
+   * is owned by the caller and must remain valid until Reset() or
+   * Resize() is called.  Frees the memory owned by this object.
+   */
+  void SetMapped(const short *_data, unsigned _width, unsigned _height) {
+    assert(_data != nullptr);
+    assert(_width > 0 && _height > 0);
+
+    storage.ResizeDiscard(0);
+    data = _data;
+    width = _width;
+    height = _height;
+  }
+
   gcc_pure
   short GetInterpolated(unsigned lx, unsigned ly,
                         unsigned ix, unsigned iy) const;
@@ -26,6 +26,8 @@ Copyright_License {
 #include "IO/FileCache.hpp"
 #include "Util/ConvertString.hpp"
 
+#include <windef.h> /* for MAX_PATH */
+
 #include <algorithm>
 #include <assert.h>
 #include <string.h>
@@ -66,6 +68,9 @@ RasterMap::RasterMap(const TCHAR *_path, const TCHAR *world_file,
     }
   }
 
+  if (cache != NULL)
+    LoadTileStore(*cache, _path, operation);
+
   projection.Set(GetBounds(),
                  raster_tile_cache.GetFineWidth(),
                  raster_tile_cache.GetFineHeight());
@@ -75,6 +80,41 @@ RasterMap::~RasterMap() {
   free(path);
 }
 
+void
+RasterMap::LoadTileStore(FileCache &cache, const TCHAR *original_path,
+                         OperationEnvironment &operation)
+{
+  static const TCHAR *const name = _T("terrain_tiles");
+
+  TCHAR buffer[MAX_PATH];
+  size_t offset;
+  const TCHAR *store_path = cache.LoadPath(name, original_path,
+                                           buffer, offset);
+  if (store_path == NULL) {
+    /* decode all tiles once and save them, so we never need to
+       decode them again */
+    FILE *file = cache.Save(name, original_path);
+    if (file == NULL)
+      return;
+
+    if (!raster_tile_cache.SaveTileStore(path, file, operation)) {
+      cache.Cancel(name, file);
+      return;
+    }
+
+    if (!cache.Commit(name, file))
+      return;
+
+    store_path = cache.LoadPath(name, original_path, buffer, offset);
+    if (store_path == NULL)
+      return;
+  }
+
+  if (!raster_tile_cache.OpenTileStore(store_path, offset))
+    /* obsolete or corrupt; it will be regenerated next time */
+    cache.Flush(name);
+}
+
 static unsigned
 AngleToPixel(Angle value, Angle start, Angle end, unsigned width)
 {
@@ -99,6 +139,24 @@ RasterMap::SetViewCenter(const GeoPoint &location, fixed radius)
                                 projection.DistancePixelsCoarse(radius));
 }
 
+void
+RasterMap::Prefetch(const GeoPoint &location, fixed radius)
+{
+  if (!raster_tile_cache.GetInitialised())
+    return;
+
+  const GeoBounds &bounds = GetBounds();
+
+  int x = AngleToPixel(location.longitude, bounds.GetWest(), bounds.GetEast(),
+                       raster_tile_cache.GetWidth());
+
+  int y = AngleToPixel(location.latitude, bounds.GetNorth(), bounds.GetSouth(),
+                       raster_tile_cache.GetHeight());
+
+  raster_tile_cache.PrefetchTiles(path, x, y,
+                                  projection.DistancePixelsCoarse(radius));
+}
+
 short
 RasterMap::GetHeight(const GeoPoint &location) const
 {
@@ -45,6 +45,16 @@ public:
             OperationEnvironment &operation);
   ~RasterMap();
 
+private:
+  /**
+   * Open the #RasterTileStore from the cache; generate it if it does
+   * not exist yet.
+   */
+  void LoadTileStore(FileCache &cache, const TCHAR *original_path,
+                     OperationEnvironment &operation);
+
+public:
+
   bool IsDefined() const {
     return raster_tile_cache.GetInitialised();
   }
@@ -65,6 +75,16 @@ public:
 
   void SetViewCenter(const GeoPoint &location, fixed radius);
 
+  /**
+   * Load the terrain around a location where the view is expected to
+   * be soon.  See RasterTileCache::PrefetchTiles().
+   */
+  void Prefetch(const GeoPoint &location, fixed radius);
+
+  const RasterTileCache::PrefetchStatistics &GetPrefetchStatistics() const {
+    return raster_tile_cache.GetPrefetchStatistics();
+  }
+
   /**
    * Determines if SetViewCenter() should be called again to continue
    * loading.
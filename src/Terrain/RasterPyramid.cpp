@@ -0,0 +1,137 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "RasterPyramid.hpp"
+#include "RasterBuffer.hpp"
+
+#include <algorithm>
+
+static constexpr short
+ReplaceSpecial0(short h)
+{
+  return RasterBuffer::IsSpecial(h) ? 0 : h;
+}
+
+void
+RasterPyramid::Build(const RasterBuffer &buffer, unsigned _block_bits)
+{
+  assert(buffer.IsDefined());
+
+  block_bits = _block_bits;
+
+  const unsigned block_size = 1 << block_bits;
+  unsigned width = ((buffer.GetWidth() - 1) >> block_bits) + 1;
+  unsigned height = ((buffer.GetHeight() - 1) >> block_bits) + 1;
+
+  /* the first level is calculated from the buffer */
+
+  AllocatedGrid<short> &first = levels[0];
+  first.GrowDiscard(width, height);
+  std::fill(first.begin(), first.end(), 0);
+
+  const short *src = buffer.GetDataAt(0, 0);
+  for (unsigned y = 0; y < buffer.GetHeight(); ++y) {
+    short *dest = first.GetPointerAt(0, y >> block_bits);
+
+    for (unsigned x = 0; x < buffer.GetWidth(); x += block_size, ++dest) {
+      const unsigned n = std::min(block_size, buffer.GetWidth() - x);
+      for (unsigned i = 0; i < n; ++i)
+        *dest = std::max(*dest, ReplaceSpecial0(*src++));
+    }
+  }
+
+  /* each following level halves the previous one, until a single
+     cell remains */
+
+  num_levels = 1;
+  while ((width > 1 || height > 1) && num_levels < MAX_LEVELS) {
+    const AllocatedGrid<short> &previous = levels[num_levels - 1];
+    width = (width + 1) / 2;
+    height = (height + 1) / 2;
+
+    AllocatedGrid<short> &level = levels[num_levels++];
+    level.GrowDiscard(width, height);
+
+    for (unsigned y = 0; y < height; ++y) {
+      const unsigned y0 = y * 2;
+      const unsigned y1 = std::min(y0 + 1, previous.GetHeight() - 1);
+
+      for (unsigned x = 0; x < width; ++x) {
+        const unsigned x0 = x * 2;
+        const unsigned x1 = std::min(x0 + 1, previous.GetWidth() - 1);
+
+        level.Get(x, y) = std::max(std::max(previous.Get(x0, y0),
+                                            previous.Get(x1, y0)),
+                                   std::max(previous.Get(x0, y1),
+                                            previous.Get(x1, y1)));
+      }
+    }
+  }
+}
+
+void
+RasterPyramid::Reset()
+{
+  for (unsigned i = 0; i < num_levels; ++i)
+    levels[i].Reset();
+
+  num_levels = 0;
+}
+
+short
+RasterPyramid::GetMaximum(unsigned x0, unsigned y0,
+                          unsigned x1, unsigned y1) const
+{
+  assert(IsDefined());
+  assert(x0 <= x1);
+  assert(y0 <= y1);
+
+  x0 >>= block_bits;
+  y0 >>= block_bits;
+  x1 >>= block_bits;
+  y1 >>= block_bits;
+
+  /* pick the finest level where the rectangle covers no more than
+     4x4 cells */
+  unsigned level = 0;
+  while (level + 1 < num_levels && (x1 - x0 > 3 || y1 - y0 > 3)) {
+    x0 >>= 1;
+    y0 >>= 1;
+    x1 >>= 1;
+    y1 >>= 1;
+    ++level;
+  }
+
+  const AllocatedGrid<short> &grid = levels[level];
+  assert(x1 < grid.GetWidth());
+  assert(y1 < grid.GetHeight());
+
+  short result = grid.Get(x0, y0);
+  for (unsigned y = y0; y <= y1; ++y) {
+    const short *p = grid.GetPointerAt(x0, y);
+    for (unsigned x = x0; x <= x1; ++x)
+      result = std::max(result, *p++);
+  }
+
+  return result;
+}
@@ -0,0 +1,75 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_RASTER_PYRAMID_HPP
+#define XCSOAR_RASTER_PYRAMID_HPP
+
+#include "Util/AllocatedGrid.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+class RasterBuffer;
+
+/**
+ * A pyramid of maximum heights of a #RasterBuffer.  Each cell of the
+ * first level contains the maximum of a block of pixels, and each
+ * following level contains the maximum of 2x2 cells of the previous
+ * one.  This allows determining an upper bound for the terrain
+ * height in a rectangle with only a few lookups.
+ *
+ * Special values (water and invalid) are counted as 0, which is what
+ * the intersection code uses for them.
+ */
+class RasterPyramid : private NonCopyable {
+  static constexpr unsigned MAX_LEVELS = 12;
+
+  /**
+   * The size of the blocks in the first level is 2^block_bits.
+   */
+  unsigned block_bits;
+
+  unsigned num_levels;
+
+  AllocatedGrid<short> levels[MAX_LEVELS];
+
+public:
+  RasterPyramid():num_levels(0) {}
+
+  bool IsDefined() const {
+    return num_levels > 0;
+  }
+
+  void Build(const RasterBuffer &buffer, unsigned block_bits);
+
+  void Reset();
+
+  /**
+   * Returns an upper bound for the height of all pixels in the
+   * specified rectangle (inclusive).  The coordinates must be within
+   * the buffer which was passed to Build().
+   */
+  gcc_pure
+  short GetMaximum(unsigned x0, unsigned y0, unsigned x1, unsigned y1) const;
+};
+
+#endif
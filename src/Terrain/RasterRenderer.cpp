@@ -34,6 +34,8 @@ Copyright_License {
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 //#define FAST_RSQRT
 
@@ -68,8 +70,10 @@ RasterRenderer::RasterRenderer()
 #ifdef ENABLE_OPENGL
    last_quantisation_pixels(-1),
    bounds(GeoBounds::Invalid()),
+#else
+   scan_valid(false),
 #endif
-   image(NULL)
+   image(NULL), image_valid(false), scroll_x(0), scroll_y(0)
 {
   // scale quantisation_pixels so resolution is not too high on old hardware
   // with large displays
@@ -108,6 +112,56 @@ RasterRenderer::UpdateQuantisation()
   return quantisation_pixels < last_quantisation_pixels;
 }
 
+#else
+
+/**
+ * Divide and round to the nearest integer, also for negative values.
+ */
+gcc_const
+static int
+RoundedDivide(int a, int b)
+{
+  return a >= 0
+    ? (a + b / 2) / b
+    : -((-a + b / 2) / b);
+}
+
+bool
+RasterRenderer::IsTranslated(const RasterMap &map,
+                             const WindowProjection &projection,
+                             int &offset_x, int &offset_y) const
+{
+  if (!scan_valid || &map != scan_map)
+    return false;
+
+  const unsigned width = projection.GetScreenWidth();
+  const unsigned height = projection.GetScreenHeight();
+  if (width != scan_projection.GetScreenWidth() ||
+      height != scan_projection.GetScreenHeight() ||
+      projection.GetScale() != scan_projection.GetScale() ||
+      projection.GetScreenAngle() != scan_projection.GetScreenAngle())
+    return false;
+
+  /* where are the corners of the new screen in the old projection?
+     this tolerates the small non-linearities of the projection, but
+     rejects anything that is not a translation */
+
+  const RasterPoint top_left =
+    scan_projection.GeoToScreen(projection.ScreenToGeo(0, 0));
+  const RasterPoint bottom_right =
+    scan_projection.GeoToScreen(projection.ScreenToGeo(width, height));
+
+  if (abs(bottom_right.x - (int)width - top_left.x) > 1 ||
+      abs(bottom_right.y - (int)height - top_left.y) > 1)
+    return false;
+
+  /* the remainder (up to half a cell) is not corrected; it is
+     relative to #scan_projection, so it does not accumulate */
+  offset_x = RoundedDivide(top_left.x, quantisation_pixels);
+  offset_y = RoundedDivide(top_left.y, quantisation_pixels);
+  return true;
+}
+
 #endif
 
 void
@@ -151,11 +205,72 @@ RasterRenderer::ScanMap(const RasterMap &map, const WindowProjection &projection
                      true);
 
   last_quantisation_pixels = quantisation_pixels;
+  image_valid = false;
 #else
+  int offset_x, offset_y;
+  if (IsTranslated(map, projection, offset_x, offset_y)) {
+    const int dx = offset_x - scan_offset_x;
+    const int dy = offset_y - scan_offset_y;
+
+    if (abs(dx) < (int)height_matrix.GetWidth() &&
+        abs(dy) < (int)height_matrix.GetHeight()) {
+      if (dx != 0 || dy != 0)
+        height_matrix.Scroll(map, scan_projection, quantisation_pixels,
+                             offset_x, offset_y, dx, dy, true);
+
+      scan_offset_x = offset_x;
+      scan_offset_y = offset_y;
+      scroll_x += dx;
+      scroll_y += dy;
+      return;
+    }
+  }
+
   height_matrix.Fill(map, projection, quantisation_pixels, true);
+
+  scan_projection = projection;
+  scan_map = &map;
+  scan_valid = true;
+  scan_offset_x = scan_offset_y = 0;
+  image_valid = false;
+  scroll_x = scroll_y = 0;
 #endif
 }
 
+/**
+ * Returns a pointer to the specified row of the image.
+ */
+static BGRColor *
+GetImageRow(RawBitmap &image, unsigned y)
+{
+  BGRColor *top = image.GetTopRow();
+  return top + (image.GetNextRow(top) - top) * (ptrdiff_t)y;
+}
+
+/**
+ * Move the pixels of the image, see HeightMatrix::Scroll().
+ */
+static void
+ScrollImage(RawBitmap &image, unsigned width, unsigned height,
+            int dx, int dy)
+{
+  assert(abs(dx) < (int)width);
+  assert(abs(dy) < (int)height);
+
+  const size_t n = (width - abs(dx)) * sizeof(BGRColor);
+  const unsigned src_x = std::max(dx, 0), dest_x = std::max(-dx, 0);
+
+  if (dy >= 0) {
+    for (unsigned y = 0; y + dy < height; ++y)
+      memmove(GetImageRow(image, y) + dest_x,
+              GetImageRow(image, y + dy) + src_x, n);
+  } else {
+    for (unsigned y = height - 1; y >= (unsigned)-dy; --y)
+      memmove(GetImageRow(image, y) + dest_x,
+              GetImageRow(image, y + dy) + src_x, n);
+  }
+}
+
 void
 RasterRenderer::GenerateImage(bool do_shading,
                               unsigned height_scale,
@@ -168,30 +283,147 @@ RasterRenderer::GenerateImage(bool do_shading,
     delete image;
     image = new RawBitmap(height_matrix.GetWidth(),
                           height_matrix.GetHeight());
+    image_valid = false;
   }
 
   if (quantisation_effective == 0)
     do_shading = false;
 
+  ImageParameters parameters;
+  parameters.do_shading = do_shading;
+  parameters.height_scale = height_scale;
+  parameters.contrast = contrast;
+  parameters.brightness = brightness;
+  parameters.sunazimuth = sunazimuth;
+  parameters.quantisation_effective = quantisation_effective;
+  parameters.pixel_size = (unsigned)pixel_size;
+
+  const int width = height_matrix.GetWidth();
+  const int height = height_matrix.GetHeight();
+
+  if (!image_valid || !(parameters == image_parameters) ||
+      abs(scroll_x) >= width || abs(scroll_y) >= height) {
+    GenerateImage(PixelRect(0, 0, width, height), do_shading, height_scale,
+                  contrast, brightness, sunazimuth);
+  } else if (scroll_x != 0 || scroll_y != 0) {
+    ScrollImage(*image, width, height, scroll_x, scroll_y);
+
+    /* regenerate the exposed rows and columns; with slope shading,
+       this includes the neighbours which were used for the slope */
+    const int border = do_shading ? (int)quantisation_effective : 0;
+
+    if (scroll_y > 0)
+      GenerateImage(PixelRect(0, std::max(height - scroll_y - border, 0),
+                              width, height),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+    else if (scroll_y < 0)
+      GenerateImage(PixelRect(0, 0,
+                              width, std::min(-scroll_y + border, height)),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+
+    if (scroll_x > 0)
+      GenerateImage(PixelRect(std::max(width - scroll_x - border, 0), 0,
+                              width, height),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+    else if (scroll_x < 0)
+      GenerateImage(PixelRect(0, 0,
+                              std::min(-scroll_x + border, width), height),
+                    do_shading, height_scale, contrast, brightness,
+                    sunazimuth);
+  }
+
+  image_parameters = parameters;
+  image_valid = true;
+  scroll_x = scroll_y = 0;
+}
+
+/**
+ * Converts horizontal bands of a #PixelRect; each part of the job
+ * writes to its own rows of the image.
+ */
+class RasterRenderer::GenerateJob final : public ThreadPool::Job {
+  RasterRenderer &renderer;
+  const PixelRect rect;
+  const bool do_shading;
+  const unsigned height_scale;
+  const int contrast, brightness;
+  const Angle sunazimuth;
+
+public:
+  GenerateJob(RasterRenderer &_renderer, const PixelRect &_rect,
+              bool _do_shading, unsigned _height_scale,
+              int _contrast, int _brightness, const Angle _sunazimuth)
+    :renderer(_renderer), rect(_rect), do_shading(_do_shading),
+     height_scale(_height_scale),
+     contrast(_contrast), brightness(_brightness),
+     sunazimuth(_sunazimuth) {}
+
+  virtual void Run(unsigned index, unsigned n) override {
+    const unsigned height = rect.bottom - rect.top;
+
+    PixelRect band = rect;
+    band.top = rect.top + height * index / n;
+    band.bottom = rect.top + height * (index + 1) / n;
+
+    renderer.GenerateBand(band, do_shading, height_scale,
+                          contrast, brightness, sunazimuth);
+  }
+};
+
+/**
+ * Don't split the image into bands smaller than this number of rows;
+ * the thread overhead would outweigh the gain.
+ */
+static constexpr unsigned MIN_BAND_HEIGHT = 16;
+
+void
+RasterRenderer::GenerateImage(const PixelRect &rect, bool do_shading,
+                              unsigned height_scale,
+                              int contrast, int brightness,
+                              const Angle sunazimuth)
+{
+  const unsigned n = std::min(thread_pool.GetConcurrency(),
+                              (rect.bottom - rect.top) / MIN_BAND_HEIGHT);
+  if (n > 1) {
+    GenerateJob job(*this, rect, do_shading, height_scale,
+                    contrast, brightness, sunazimuth);
+    thread_pool.Run(job, n);
+  } else
+    GenerateBand(rect, do_shading, height_scale,
+                 contrast, brightness, sunazimuth);
+
+  image->SetDirty();
+}
+
+void
+RasterRenderer::GenerateBand(const PixelRect &rect, bool do_shading,
+                             unsigned height_scale,
+                             int contrast, int brightness,
+                             const Angle sunazimuth)
+{
   if (do_shading)
-    GenerateSlopeImage(height_scale, contrast, brightness,
+    GenerateSlopeImage(rect, height_scale, contrast, brightness,
                        sunazimuth);
   else
-    GenerateUnshadedImage(height_scale);
+    GenerateUnshadedImage(rect, height_scale);
 }
 
 void
-RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
+RasterRenderer::GenerateUnshadedImage(const PixelRect &rect,
+                                      unsigned height_scale)
 {
-  const short *src = height_matrix.GetData();
   const BGRColor *oColorBuf = color_table + 64 * 256;
-  BGRColor *dest = image->GetTopRow();
+  BGRColor *dest = GetImageRow(*image, rect.top);
 
-  for (unsigned y = height_matrix.GetHeight(); y > 0; --y) {
-    BGRColor *p = dest;
+  for (unsigned y = rect.top; y < (unsigned)rect.bottom; ++y) {
+    const short *src = height_matrix.GetRow(y) + rect.left;
+    BGRColor *p = dest + rect.left;
     dest = image->GetNextRow(dest);
 
-    for (unsigned x = height_matrix.GetWidth(); x > 0; --x) {
+    for (unsigned x = rect.left; x < (unsigned)rect.right; ++x) {
       short h = *src++;
       if (gcc_likely(!RasterBuffer::IsSpecial(h))) {
         if (h < 0)
@@ -208,8 +440,6 @@ RasterRenderer::GenerateUnshadedImage(unsigned height_scale)
       }
     }
   }
-
-  image->SetDirty();
 }
 
 /**
@@ -231,7 +461,8 @@ ClipHeightDelta(int d)
 // (gridding of display) This is why quantisation_effective is used instead of 1
 // previously.  for large zoom levels, quantisation_effective=1
 void
-RasterRenderer::GenerateSlopeImage(unsigned height_scale,
+RasterRenderer::GenerateSlopeImage(const PixelRect &rect,
+                                   unsigned height_scale,
                                    int contrast,
                                    const int sx, const int sy, const int sz)
 {
@@ -250,7 +481,6 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
              square will not overflow */
           8192u / (quantisation_effective * quantisation_effective));
 
-  const short *src = height_matrix.GetData();
   const BGRColor *oColorBuf = color_table + 64 * 256;
 #ifdef FAST_RSQRT
   const short szindex = sz*contrast/128;
@@ -262,9 +492,9 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   const int sz_c = sz*contrast>>7;
 #endif
 
-  BGRColor *dest = image->GetTopRow();
+  BGRColor *dest = GetImageRow(*image, rect.top);
 
-  for (unsigned y = 0; y < height_matrix.GetHeight(); ++y) {
+  for (unsigned y = rect.top; y < (unsigned)rect.bottom; ++y) {
     const unsigned row_plus_index = y < (unsigned)border.bottom
       ? quantisation_effective
       : height_matrix.GetHeight() - 1 - y;
@@ -276,10 +506,11 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
 
     const unsigned p31 = row_plus_index + row_minus_index;
 
-    BGRColor *p = dest;
+    const short *src = height_matrix.GetRow(y) + rect.left;
+    BGRColor *p = dest + rect.left;
     dest = image->GetNextRow(dest);
 
-    for (unsigned x = 0; x < height_matrix.GetWidth(); ++x, ++src) {
+    for (unsigned x = rect.left; x < (unsigned)rect.right; ++x, ++src) {
       short h = *src;
       if (gcc_likely(!RasterBuffer::IsSpecial(h))) {
         if (h < 0)
@@ -361,12 +592,11 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
       }
     }
   }
-
-  image->SetDirty();
 }
 
 void
-RasterRenderer::GenerateSlopeImage(unsigned height_scale,
+RasterRenderer::GenerateSlopeImage(const PixelRect &rect,
+                                   unsigned height_scale,
                                    int contrast, int brightness,
                                    const Angle sunazimuth)
 {
@@ -377,7 +607,7 @@ RasterRenderer::GenerateSlopeImage(unsigned height_scale,
   const int sy = (int)(255 * fudgeelevation.fastcosine() * -sunazimuth.fastcosine());
   const int sz = (int)(255 * fudgeelevation.fastsine());
 
-  GenerateSlopeImage(height_scale, contrast,
+  GenerateSlopeImage(rect, height_scale, contrast,
                      sx, sy, sz);
 }
 
@@ -385,6 +615,8 @@ void
 RasterRenderer::ColorTable(const ColorRamp *color_ramp, bool do_water,
                            unsigned height_scale, int interp_levels)
 {
+  image_valid = false;
+
   for (int i = 0; i < 256; i++) {
     for (int mag = -64; mag < 64; mag++) {
       uint8_t r, g, b;
@@ -27,15 +27,18 @@ Copyright_License {
 #include "Terrain/HeightMatrix.hpp"
 #include "Screen/RawBitmap.hpp"
 #include "Math/fixed.hpp"
+#include "Math/Angle.hpp"
 #include "Util/NonCopyable.hpp"
+#include "Thread/ThreadPool.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Geo/GeoBounds.hpp"
+#else
+#include "Projection/WindowProjection.hpp"
 #endif
 
 #define NUM_COLOR_RAMP_LEVELS 13
 
-class Angle;
 class Canvas;
 class RasterMap;
 class WindowProjection;
@@ -68,13 +71,80 @@ class RasterRenderer : private NonCopyable {
   GeoBounds bounds;
 #endif
 
+#ifndef ENABLE_OPENGL
+  /**
+   * The projection of the last ScanMap() call which filled the whole
+   * #HeightMatrix.  Only valid if #scan_valid is set.
+   */
+  WindowProjection scan_projection;
+
+  /**
+   * The map which was scanned into the #HeightMatrix.
+   */
+  const RasterMap *scan_map;
+
+  bool scan_valid;
+
+  /**
+   * The position of the #HeightMatrix origin relative to
+   * #scan_projection, in cells.  This is non-zero after the
+   * #HeightMatrix has been scrolled.
+   */
+  int scan_offset_x, scan_offset_y;
+#endif
+
   HeightMatrix height_matrix;
   RawBitmap *image;
 
+  /**
+   * The parameters which were used to generate the #RawBitmap.  If
+   * they are unchanged, GenerateImage() only needs to update the
+   * parts of the image which were scrolled in.
+   */
+  struct ImageParameters {
+    bool do_shading;
+    unsigned height_scale;
+    int contrast, brightness;
+    Angle sunazimuth;
+    unsigned quantisation_effective;
+    unsigned pixel_size;
+
+    bool operator==(const ImageParameters &other) const {
+      return do_shading == other.do_shading &&
+        height_scale == other.height_scale &&
+        contrast == other.contrast && brightness == other.brightness &&
+        sunazimuth == other.sunazimuth &&
+        quantisation_effective == other.quantisation_effective &&
+        pixel_size == other.pixel_size;
+    }
+  };
+
+  ImageParameters image_parameters;
+
+  /**
+   * Does #image match the #HeightMatrix, except for #scroll_x and
+   * #scroll_y?
+   */
+  bool image_valid;
+
+  /**
+   * The number of cells the #HeightMatrix has been scrolled since
+   * the last GenerateImage() call.
+   */
+  int scroll_x, scroll_y;
+
   fixed pixel_size;
 
   BGRColor color_table[256 * 128];
 
+  /**
+   * The threads which convert horizontal bands of the height matrix
+   * into the image.
+   */
+  ThreadPool thread_pool;
+
+  class GenerateJob;
+
 public:
   RasterRenderer();
   ~RasterRenderer();
@@ -91,11 +161,30 @@ public:
     return height_matrix.GetHeight();
   }
 
-#ifdef ENABLE_OPENGL
+  /**
+   * Set the number of threads used by GenerateImage().  0 selects
+   * the number of CPUs.
+   */
+  void SetConcurrency(unsigned concurrency) {
+    thread_pool.SetConcurrency(concurrency);
+  }
+
+  /**
+   * Discard the #HeightMatrix and the image, e.g. because the
+   * terrain has changed.  The next ScanMap() call will scan the whole
+   * map.
+   */
   void Invalidate() {
+#ifdef ENABLE_OPENGL
     bounds.SetInvalid();
+#else
+    scan_valid = false;
+#endif
+    image_valid = false;
   }
 
+#ifdef ENABLE_OPENGL
+
   /**
    * Calculate a new #quantisation_pixels value.
    *
@@ -120,7 +209,9 @@ public:
                   unsigned height_scale, int interp_levels);
 
   /**
-   * Scan the map and fill the height matrix.
+   * Scan the map and fill the height matrix.  If the projection has
+   * only been translated since the previous call, the matrix is
+   * scrolled, and only the newly exposed parts are scanned.
    */
   void ScanMap(const RasterMap &map, const WindowProjection &projection);
 
@@ -136,21 +227,54 @@ public:
   }
 
 protected:
+#ifndef ENABLE_OPENGL
+  /**
+   * Check whether the map is the same as in the previous scan and
+   * the projection differs from #scan_projection only by a
+   * translation.
+   *
+   * @param offset_x the horizontal translation in cells (output)
+   * @param offset_y the vertical translation in cells (output)
+   */
+  gcc_pure
+  bool IsTranslated(const RasterMap &map, const WindowProjection &projection,
+                    int &offset_x, int &offset_y) const;
+#endif
+
+  /**
+   * Convert the specified part of the height matrix into the image.
+   * Large areas are split into horizontal bands which are converted
+   * by the #thread_pool.
+   */
+  void GenerateImage(const PixelRect &rect, bool do_shading,
+                     unsigned height_scale, int contrast, int brightness,
+                     const Angle sunazimuth);
+
+  /**
+   * Convert the specified part of the height matrix into the image
+   * in the current thread.
+   */
+  void GenerateBand(const PixelRect &rect, bool do_shading,
+                    unsigned height_scale, int contrast, int brightness,
+                    const Angle sunazimuth);
+
   /**
    * Convert the height matrix into the image, without shading.
    */
-  void GenerateUnshadedImage(unsigned height_scale);
+  void GenerateUnshadedImage(const PixelRect &rect, unsigned height_scale);
 
   /**
    * Convert the height matrix into the image, with slope shading.
    */
-  void GenerateSlopeImage(unsigned height_scale, int contrast,
+  void GenerateSlopeImage(const PixelRect &rect,
+                          unsigned height_scale, int contrast,
                           const int sx, const int sy, const int sz);
 
   /**
    * Convert the height matrix into the image, with slope shading.
    */
-  void GenerateSlopeImage(unsigned height_scale,
+  void GenerateSlopeImage(const PixelRect &rect,
+                          unsigned height_scale,
                           int contrast, int brightness,
                           const Angle sunazimuth);
 };
@@ -24,6 +24,7 @@ Copyright_License {
 #include "Terrain/RasterTile.hpp"
 
 #include <algorithm>
+#include <limits>
 
 bool
 RasterTile::SaveCache(FILE *file) const
@@ -72,6 +73,25 @@ RasterTile::GetHeight(unsigned x, unsigned y) const
   return buffer.Get(x, y);
 }
 
+short
+RasterTile::GetMaximum(unsigned x0, unsigned y0,
+                       unsigned x1, unsigned y1) const
+{
+  if (x1 < xstart || x0 >= xend || y1 < ystart || y0 >= yend)
+    return RasterBuffer::TERRAIN_INVALID;
+
+  if (!pyramid.IsDefined())
+    /* unknown */
+    return std::numeric_limits<short>::max();
+
+  x0 = std::max(x0, xstart) - xstart;
+  y0 = std::max(y0, ystart) - ystart;
+  x1 = std::min(x1, xend - 1) - xstart;
+  y1 = std::min(y1, yend - 1) - ystart;
+
+  return pyramid.GetMaximum(x0, y0, x1, y1);
+}
+
 short
 RasterTile::GetInterpolatedHeight(unsigned lx, unsigned ly,
                                   unsigned ix, unsigned iy) const
@@ -93,6 +113,17 @@ RasterTile::GetInterpolatedHeight(unsigned lx, unsigned ly,
   return buffer.GetInterpolated(lx, ly, ix, iy);
 }
 
+unsigned
+RasterTile::CalcDistance(int x, int y) const
+{
+  const unsigned int dx1 = abs(x - (int)xstart);
+  const unsigned int dx2 = abs((int)xend - x);
+  const unsigned int dy1 = abs(y - (int)ystart);
+  const unsigned int dy2 = abs((int)yend - y);
+
+  return std::max(std::min(dx1, dx2), std::min(dy1, dy2));
+}
+
 bool
 RasterTile::CheckTileVisibility(int view_x, int view_y, unsigned view_radius)
 {
@@ -101,12 +132,7 @@ RasterTile::CheckTileVisibility(int view_x, int view_y, unsigned view_radius)
     return false;
   }
 
-  const unsigned int dx1 = abs(view_x - (int)xstart);
-  const unsigned int dx2 = abs((int)xend - view_x);
-  const unsigned int dy1 = abs(view_y - (int)ystart);
-  const unsigned int dy2 = abs((int)yend - view_y);
-
-  distance = std::max(std::min(dx1, dx2), std::min(dy1, dy2));
+  distance = CalcDistance(view_x, view_y);
   return distance <= view_radius || IsEnabled();
 }
 
@@ -116,3 +142,23 @@ RasterTile::VisibilityChanged(int view_x, int view_y, unsigned view_radius)
   request = false;
   return CheckTileVisibility(view_x, view_y, view_radius);
 }
+
+bool
+RasterTile::VisibilityChanged(int view_x, int view_y, unsigned view_radius,
+                              int prefetch_x, int prefetch_y,
+                              unsigned prefetch_radius)
+{
+  if (VisibilityChanged(view_x, view_y, view_radius) &&
+      distance <= view_radius)
+    return true;
+
+  if (!width || !height)
+    return false;
+
+  const unsigned prefetch_distance = CalcDistance(prefetch_x, prefetch_y);
+  if (prefetch_distance > prefetch_radius)
+    return IsEnabled();
+
+  distance = std::min(distance, view_radius + prefetch_distance);
+  return true;
+}
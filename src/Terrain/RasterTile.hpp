@@ -25,6 +25,7 @@ Copyright_License {
 #define XCSOAR_RASTERTILE_HPP
 
 #include "Terrain/RasterBuffer.hpp"
+#include "Terrain/RasterPyramid.hpp"
 #include "Util/NonCopyable.hpp"
 
 #include <stdio.h>
@@ -46,12 +47,25 @@ public:
 
   bool request;
 
+  /**
+   * Was this tile loaded by RasterTileCache::PrefetchTiles() and has
+   * not become visible yet?
+   */
+  bool prefetched;
+
   RasterBuffer buffer;
 
+  /**
+   * The maximum heights of #buffer, for RasterTileCache::IsClear().
+   * Only defined while the tile is enabled and UpdatePyramid() has
+   * been called.
+   */
+  RasterPyramid pyramid;
+
 public:
   RasterTile()
     :xstart(0), ystart(0), xend(0), yend(0),
-     width(0), height(0) {}
+     width(0), height(0), prefetched(false) {}
 
   void Set(unsigned _xstart, unsigned _ystart,
            unsigned _xend, unsigned _yend) {
@@ -69,6 +83,7 @@ public:
   void Clear() {
     width = height = 0;
     request = false;
+    prefetched = false;
   }
 
   bool IsDefined() const {
@@ -94,13 +109,66 @@ public:
   bool SaveCache(FILE *file) const;
   bool LoadCache(FILE *file);
 
+  void SetPrefetched() {
+    prefetched = true;
+  }
+
+  /**
+   * Clear the "prefetched" flag.
+   *
+   * @return the old value
+   */
+  bool ConsumePrefetched() {
+    bool result = prefetched;
+    prefetched = false;
+    return result;
+  }
+
   bool CheckTileVisibility(int view_x, int view_y, unsigned view_radius);
 
   void Disable() {
     buffer.Reset();
+    pyramid.Reset();
+    prefetched = false;
   }
 
   void Enable();
+
+  /**
+   * Enable this tile, letting it refer to height values which were
+   * already decoded (e.g. from a #RasterTileStore mapping).  The
+   * memory is owned by the caller and must remain valid until this
+   * tile is disabled.
+   */
+  void EnableMapped(const short *data) {
+    buffer.SetMapped(data, width, height);
+    request = false;
+  }
+
+  /**
+   * Calculate the #RasterPyramid after the height values have been
+   * loaded.
+   */
+  void UpdatePyramid() {
+    pyramid.Build(buffer, 4);
+  }
+
+  /**
+   * Returns an upper bound for the height of all pixels in the
+   * specified rectangle, which is clipped to this tile.  Returns
+   * RasterBuffer::TERRAIN_INVALID if this tile does not overlap the
+   * rectangle, and the largest possible value if there is no
+   * pyramid.
+   *
+   * @param x0 the left pixel column within the map
+   * @param y0 the top pixel row within the map
+   * @param x1 the right pixel column within the map (inclusive)
+   * @param y1 the bottom pixel row within the map (inclusive)
+   */
+  gcc_pure
+  short GetMaximum(unsigned x0, unsigned y0,
+                   unsigned x1, unsigned y1) const;
+
   bool IsEnabled() const {
     return buffer.IsDefined();
   }
@@ -137,6 +205,21 @@ public:
 
   bool VisibilityChanged(int view_x, int view_y, unsigned view_radius);
 
+  /**
+   * Like VisibilityChanged(), but additionally selects the tile if it
+   * is inside the "prefetch" circle.  Such tiles are ranked behind
+   * all tiles inside the view.
+   */
+  bool VisibilityChanged(int view_x, int view_y, unsigned view_radius,
+                         int prefetch_x, int prefetch_y,
+                         unsigned prefetch_radius);
+
+private:
+  gcc_pure
+  unsigned CalcDistance(int x, int y) const;
+
+public:
+
   void ScanLine(unsigned ax, unsigned ay, unsigned bx, unsigned by,
                 short *dest, unsigned size, bool interpolate) const {
     buffer.ScanLine(ax - (xstart << 8), ay - (ystart << 8),
@@ -28,6 +28,7 @@ Copyright_License {
 #include "IO/ZipLineReader.hpp"
 #include "Operation/Operation.hpp"
 #include "Math/FastMath.h"
+#include "Util/AllocatedArray.hpp"
 
 #include <string.h>
 #include <algorithm>
@@ -89,45 +90,99 @@ RasterTileCache::PollTiles(int x, int y, unsigned radius)
      loaded are added to RequestTiles */
 
   request_tiles.clear();
-  for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i)
-    if (tiles.GetLinear(i).VisibilityChanged(x, y, radius))
-      request_tiles.append(i);
+  if (prefetch_radius > 0) {
+    const unsigned _prefetch_radius = prefetch_radius + 256;
+    for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i)
+      if (tiles.GetLinear(i).VisibilityChanged(x, y, radius,
+                                               prefetch_x, prefetch_y,
+                                               _prefetch_radius))
+        request_tiles.append(i);
+  } else {
+    for (int i = tiles.GetSize() - 1; i >= 0 && !request_tiles.full(); --i)
+      if (tiles.GetLinear(i).VisibilityChanged(x, y, radius))
+        request_tiles.append(i);
+  }
+
+  /* reduce if there are too many; tiles served from the tile store
+     don't occupy heap memory, only address space, so they are not
+     limited */
 
-  /* reduce if there are too many */
+  const unsigned max_active = store.IsDefined()
+    ? (unsigned)MAX_RTC_TILES
+    : (unsigned)MAX_ACTIVE_TILES;
 
-  if (request_tiles.size() > MAX_ACTIVE_TILES) {
+  if (request_tiles.size() > max_active) {
     /* sort by distance */
     const RTDistanceSort sort(*this);
     std::sort(request_tiles.begin(), request_tiles.end(), sort);
 
     /* dispose all tiles which are out of range */
-    for (unsigned i = MAX_ACTIVE_TILES; i < request_tiles.size(); ++i) {
+    for (unsigned i = max_active; i < request_tiles.size(); ++i) {
       RasterTile &tile = tiles.GetLinear(request_tiles[i]);
       tile.Disable();
     }
 
-    request_tiles.shrink(MAX_ACTIVE_TILES);
+    request_tiles.shrink(max_active);
   }
 
   /* fill ActiveTiles and request new tiles */
 
   dirty = false;
 
-  unsigned num_activate = 0;
+  unsigned num_activate = 0, num_mapped = 0;
   for (unsigned i = 0; i < request_tiles.size(); ++i) {
     RasterTile &tile = tiles.GetLinear(request_tiles[i]);
-    if (tile.IsEnabled())
+
+    /* is this tile only selected because of PrefetchTiles()? */
+    const bool prefetch = tile.GetDistance() > (int)radius;
+
+    if (tile.IsEnabled()) {
+      if (!prefetch && tile.ConsumePrefetched())
+        ++prefetch_statistics.hits;
       continue;
+    }
+
+    if (store.IsDefined()) {
+      const short *data = store.GetTile(request_tiles[i],
+                                        tile.width, tile.height);
+      if (data != nullptr) {
+        /* already decoded: no need to throttle this one */
+        tile.EnableMapped(data);
+        tile.UpdatePyramid();
+        ++num_mapped;
+      }
+    }
+
+    if (!tile.IsEnabled()) {
+      if (++num_activate > MAX_ACTIVATE) {
+        /* this tile will be loaded in the next iteration */
+        dirty = true;
+        continue;
+      }
 
-    if (++num_activate <= MAX_ACTIVATE)
       /* request the tile in the current iteration */
       tile.SetRequest();
-    else
-      /* this tile will be loaded in the next iteration */
-      dirty = true;
+    }
+
+    if (prefetch) {
+      tile.SetPrefetched();
+      ++prefetch_statistics.prefetched;
+    } else
+      ++prefetch_statistics.misses;
   }
 
-  return num_activate > 0;
+  return num_activate > 0 || num_mapped > 0;
+}
+
+bool
+RasterTileCache::HasRequestedTiles() const
+{
+  for (auto it = request_tiles.begin(), end = request_tiles.end();
+       it != end; ++it)
+    if (tiles.GetLinear(*it).IsRequested())
+      return true;
+
+  return false;
 }
 
 bool
@@ -222,6 +277,12 @@ RasterTileCache::Reset()
   scan_overview = true;
 
   overview.Reset();
+  overview_pyramid.Reset();
+  store.Close();
+
+  view_radius = 0;
+  prefetch_radius = 0;
+  prefetch_statistics.Clear();
 
   for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it)
     it->Disable();
@@ -422,7 +483,9 @@ RasterTileCache::LoadOverview(const char *path, const TCHAR *world_file,
   if (initialised && !bounds_initialised)
     initialised = false;
 
-  if (!initialised)
+  if (initialised)
+    BuildOverviewPyramid();
+  else
     Reset();
 
   operation = NULL;
@@ -432,12 +495,38 @@ RasterTileCache::LoadOverview(const char *path, const TCHAR *world_file,
 void
 RasterTileCache::UpdateTiles(const char *path, int x, int y, unsigned radius)
 {
+  view_x = x;
+  view_y = y;
+  view_radius = radius;
+
   if (!PollTiles(x, y, radius))
     return;
 
-  remaining_segments = 0;
+  LoadRequestedTiles(path);
+}
 
-  LoadJPG2000(path);
+void
+RasterTileCache::PrefetchTiles(const char *path, int x, int y,
+                               unsigned radius)
+{
+  prefetch_x = x;
+  prefetch_y = y;
+  prefetch_radius = radius;
+
+  if (view_radius == 0 || !PollTiles(view_x, view_y, view_radius))
+    return;
+
+  LoadRequestedTiles(path);
+}
+
+void
+RasterTileCache::LoadRequestedTiles(const char *path)
+{
+  if (HasRequestedTiles()) {
+    remaining_segments = 0;
+
+    LoadJPG2000(path);
+  }
 
   /* permanently disable the requested tiles which are still not
      loaded, to prevent trying to reload them over and over in a busy
@@ -445,7 +534,12 @@ RasterTileCache::UpdateTiles(const char *path, int x, int y, unsigned radius)
   for (auto it = request_tiles.begin(), end = request_tiles.end();
       it != end; ++it) {
     RasterTile &tile = tiles.GetLinear(*it);
-    if (tile.IsRequested() && !tile.IsEnabled())
+    if (!tile.IsRequested())
+      continue;
+
+    if (tile.IsEnabled())
+      tile.UpdatePyramid();
+    else
       tile.Clear();
   }
 
@@ -554,7 +648,103 @@ RasterTileCache::LoadCache(FILE *file)
             overview_size, file) != overview_size)
     return false;
 
+  BuildOverviewPyramid();
+
   initialised = true;
   scan_overview = false;
   return true;
 }
+
+bool
+RasterTileCache::SaveTileStore(const char *path, FILE *file,
+                               OperationEnvironment &_operation)
+{
+  assert(initialised);
+  assert(!scan_overview);
+  assert(!store.IsDefined());
+
+  const long base = ftell(file);
+  if (base < 0)
+    return false;
+
+  const unsigned num_tiles = tiles.GetSize();
+
+  RasterTileStore::Header header;
+  header.version = RasterTileStore::Header::VERSION;
+  header.tile_columns = tiles.GetWidth();
+  header.tile_rows = tiles.GetHeight();
+
+  AllocatedArray<RasterTileStore::TileInfo> index(num_tiles);
+  std::fill(index.begin(), index.end(), RasterTileStore::TileInfo{0, 0, 0});
+
+  /* write a preliminary (empty) tile table; it is rewritten after
+     all tiles have been decoded */
+  if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+      fwrite(index.begin(), sizeof(*index.begin()), num_tiles,
+             file) != num_tiles)
+    return false;
+
+  uint32_t offset = sizeof(header) + num_tiles * sizeof(*index.begin());
+
+  for (auto it = tiles.begin(), end = tiles.end(); it != end; ++it) {
+    it->ClearRequest();
+    it->Disable();
+  }
+
+  _operation.SetProgressRange(num_tiles);
+
+  /* decode in batches, to keep the amount of memory within the same
+     limit as during normal operation */
+  for (unsigned first = 0; first < num_tiles; first += MAX_ACTIVE_TILES) {
+    const unsigned last = std::min(first + MAX_ACTIVE_TILES, num_tiles);
+
+    request_tiles.clear();
+    for (unsigned i = first; i < last; ++i) {
+      RasterTile &tile = tiles.GetLinear(i);
+      if (tile.IsDefined()) {
+        tile.SetRequest();
+        request_tiles.append(i);
+      }
+    }
+
+    remaining_segments = 0;
+    LoadJPG2000(path);
+    if (!initialised)
+      /* the JPEG2000 file has vanished */
+      return false;
+
+    for (unsigned i = first; i < last; ++i) {
+      RasterTile &tile = tiles.GetLinear(i);
+      if (tile.IsEnabled()) {
+        const size_t n = tile.width * tile.height;
+        if (fwrite(tile.buffer.GetData(), sizeof(short), n, file) != n)
+          return false;
+
+        index[i].offset = offset;
+        index[i].width = tile.width;
+        index[i].height = tile.height;
+        offset += n * sizeof(short);
+      }
+
+      tile.ClearRequest();
+      tile.Disable();
+    }
+
+    _operation.SetProgressPosition(last);
+  }
+
+  request_tiles.clear();
+
+  /* now write the real tile table */
+  return fseek(file, base + sizeof(header), SEEK_SET) == 0 &&
+    fwrite(index.begin(), sizeof(*index.begin()), num_tiles,
+           file) == num_tiles;
+}
+
+bool
+RasterTileCache::OpenTileStore(const TCHAR *path, size_t offset)
+{
+  assert(initialised);
+
+  return store.Open(path, offset, tiles.GetWidth(), tiles.GetHeight());
+}
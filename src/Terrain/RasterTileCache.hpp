@@ -25,8 +25,11 @@ Copyright_License {
 #define XCSOAR_RASTERTILE_CACHE_HPP
 
 #include "RasterTile.hpp"
+#include "RasterTileStore.hpp"
+#include "RasterPyramid.hpp"
 #include "Geo/GeoBounds.hpp"
 #include "Util/NonCopyable.hpp"
+#include "Util/AllocatedGrid.hpp"
 #include "Util/StaticArray.hpp"
 #include "Util/Serial.hpp"
 
@@ -68,12 +71,28 @@ class RasterTileCache : private NonCopyable {
    */
   static constexpr unsigned OVERVIEW_BITS = 4;
 
+  /**
+   * The size of the blocks in the first level of #overview_pyramid
+   * is 2^OVERVIEW_PYRAMID_BITS overview pixels.
+   */
+  static constexpr unsigned OVERVIEW_PYRAMID_BITS = 2;
+
   /**
    * Target number of steps in intersection searches; total distance
    * is shifted by this number of bits
    */
   static constexpr unsigned INTERSECT_BITS = 7;
 
+  /**
+   * Parameters for IsClear() in intersection searches: the number of
+   * pixels around the line to be checked (accounts for rounding and
+   * for samples slightly beyond the destination), the minimum length
+   * of a piece and the maximum number of pieces.
+   */
+  static constexpr unsigned CLEAR_MARGIN = 2;
+  static constexpr int CLEAR_MIN_DISTANCE = 32;
+  static constexpr unsigned CLEAR_MAX_PIECES = 64;
+
 public:
   /**
    * The fixed-point fractional part of sub-pixel coordinates.
@@ -83,6 +102,29 @@ public:
    */
   static constexpr unsigned SUBPIXEL_BITS = 8;
 
+  struct PrefetchStatistics {
+    /**
+     * The number of tiles which were loaded in advance by
+     * PrefetchTiles().
+     */
+    unsigned prefetched;
+
+    /**
+     * The number of prefetched tiles which have become visible later.
+     */
+    unsigned hits;
+
+    /**
+     * The number of tiles which had to be loaded when they became
+     * visible.
+     */
+    unsigned misses;
+
+    void Clear() {
+      prefetched = hits = misses = 0;
+    }
+  };
+
 protected:
   friend struct RTDistanceSort;
 
@@ -148,12 +190,25 @@ protected:
   unsigned short tile_width, tile_height;
 
   RasterBuffer overview;
+
+  /**
+   * The maximum heights of #overview, see IsClear().
+   */
+  RasterPyramid overview_pyramid;
+
   bool scan_overview;
   unsigned int width, height;
   unsigned int overview_width_fine, overview_height_fine;
 
   GeoBounds bounds;
 
+  /**
+   * The pre-decoded tiles, if available.  Tiles found here are served
+   * directly from the mapping instead of being decoded from the
+   * JPEG2000 file.
+   */
+  RasterTileStore store;
+
   StaticArray<MarkerSegmentInfo, 8192> segments;
 
   /**
@@ -168,6 +223,22 @@ protected:
    */
   StaticArray<uint16_t, MAX_RTC_TILES> request_tiles;
 
+  /**
+   * The view which was passed to UpdateTiles() most recently.
+   * view_radius is 0 if UpdateTiles() has not been called yet.
+   */
+  int view_x, view_y;
+  unsigned view_radius;
+
+  /**
+   * The location where the next view is expected, see
+   * PrefetchTiles().  prefetch_radius is 0 if there is none.
+   */
+  int prefetch_x, prefetch_y;
+  unsigned prefetch_radius;
+
+  PrefetchStatistics prefetch_statistics;
+
   /**
    * Progress callbacks for loading the file during startup.
    */
@@ -179,6 +250,14 @@ public:
   }
 
 protected:
+  /**
+   * Build #overview_pyramid from the #overview, after it has been
+   * filled.
+   */
+  void BuildOverviewPyramid() {
+    overview_pyramid.Build(overview, OVERVIEW_PYRAMID_BITS);
+  }
+
   void ScanTileLine(GridLocation start, GridLocation end,
                     short *buffer, unsigned size, bool interpolate) const;
 
@@ -248,6 +327,39 @@ private:
   gcc_pure
   std::pair<short, bool> GetFieldDirect(unsigned px, unsigned py) const;
 
+  /**
+   * Returns an upper bound for the heights which GetFieldDirect() may
+   * return within the specified rectangle, which is clipped to the
+   * map.  Water is counted as 0.
+   *
+   * @param x0 the left pixel column
+   * @param y0 the top pixel row
+   * @param x1 the right pixel column (inclusive)
+   * @param y1 the bottom pixel row (inclusive)
+   */
+  gcc_pure
+  short GetMaximum(int x0, int y0, int x1, int y1) const;
+
+  /**
+   * Check whether the terrain along a line is guaranteed to be lower
+   * than a height which changes linearly along the line, using the
+   * #RasterPyramid of the overview and of the loaded tiles.  Long
+   * lines are bisected until they can be proven clear or until the
+   * pieces get too small; in the latter case, the caller must fall
+   * back to walking the line.
+   *
+   * @param margin the number of pixels around the line to be checked
+   * in addition
+   * @param h0 the minimum height at the start of the line
+   * @param h1 the minimum height at the end of the line
+   * @param min_distance don't bisect pieces shorter than this
+   * (Manhattan distance in pixels)
+   * @return true if the terrain is lower than the line everywhere
+   */
+  gcc_pure
+  bool IsClear(int x0, int y0, int x1, int y1, unsigned margin,
+               int h0, int h1, int min_distance) const;
+
 public:
   bool LoadOverview(const char *path, const TCHAR *world_file,
                     OperationEnvironment &operation);
@@ -255,8 +367,43 @@ public:
   bool SaveCache(FILE *file) const;
   bool LoadCache(FILE *file);
 
+  /**
+   * Decode all tiles from the JPEG2000 file and write them to a
+   * #RasterTileStore file.  This is expensive, and is meant to be
+   * done only once per terrain file.
+   *
+   * @param path the JPEG2000 file
+   */
+  bool SaveTileStore(const char *path, FILE *file,
+                     OperationEnvironment &operation);
+
+  /**
+   * Map a file written by SaveTileStore().  From now on, tiles are
+   * served from there.
+   *
+   * @param offset the position of the tile store within the file
+   */
+  bool OpenTileStore(const TCHAR *path, size_t offset);
+
+  bool HasTileStore() const {
+    return store.IsDefined();
+  }
+
   void UpdateTiles(const char *path, int x, int y, unsigned radius);
 
+  /**
+   * Load the tiles around a location where the view is expected to be
+   * soon, in addition to the tiles of the current view.  Tiles of the
+   * current view are preferred if the number of active tiles is
+   * exhausted.  The prefetch area remains active until the next call.
+   * Has no effect before UpdateTiles() has been called.
+   */
+  void PrefetchTiles(const char *path, int x, int y, unsigned radius);
+
+  const PrefetchStatistics &GetPrefetchStatistics() const {
+    return prefetch_statistics;
+  }
+
   /**
    * Determines if there are still tiles scheduled to be loaded.  Call
    * this after UpdateTiles() to determine if UpdateTiles() should be
@@ -314,6 +461,18 @@ public:
 protected:
   bool PollTiles(int x, int y, unsigned radius);
 
+  /**
+   * Load all tiles requested by PollTiles().
+   */
+  void LoadRequestedTiles(const char *path);
+
+  /**
+   * Are there tiles in #request_tiles which still need to be decoded
+   * from the JPEG2000 file?
+   */
+  gcc_pure
+  bool HasRequestedTiles() const;
+
 public:
   short GetMaxElevation() const {
     return overview.GetMaximum();
@@ -0,0 +1,93 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/RasterTileStore.hpp"
+#include "OS/FileMapping.hpp"
+
+#include <assert.h>
+
+bool
+RasterTileStore::Open(const TCHAR *path, size_t offset,
+                      unsigned tile_columns, unsigned tile_rows)
+{
+  Close();
+
+  mapping = new FileMapping(path);
+  if (mapping->error() ||
+      /* the header must be aligned for direct access */
+      offset % sizeof(uint32_t) != 0 ||
+      mapping->size() < offset + sizeof(Header)) {
+    Close();
+    return false;
+  }
+
+  base = (const uint8_t *)mapping->at(offset);
+  const size_t size = mapping->size() - offset;
+
+  const Header &header = *(const Header *)base;
+  num_tiles = tile_columns * tile_rows;
+  if (header.version != Header::VERSION ||
+      header.tile_columns != tile_columns ||
+      header.tile_rows != tile_rows ||
+      size < sizeof(header) + num_tiles * sizeof(TileInfo)) {
+    Close();
+    return false;
+  }
+
+  index = (const TileInfo *)(base + sizeof(header));
+
+  /* verify the tile table once, so GetTile() doesn't need to */
+  for (unsigned i = 0; i < num_tiles; ++i) {
+    const TileInfo &info = index[i];
+    if (info.offset != 0 &&
+        (info.offset % sizeof(short) != 0 ||
+         info.offset + (size_t)info.width * info.height * sizeof(short) > size)) {
+      Close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void
+RasterTileStore::Close()
+{
+  delete mapping;
+  mapping = nullptr;
+}
+
+const short *
+RasterTileStore::GetTile(unsigned i, unsigned width, unsigned height) const
+{
+  assert(IsDefined());
+
+  if (i >= num_tiles)
+    return nullptr;
+
+  const TileInfo &info = index[i];
+  if (info.offset == 0 || info.width != width || info.height != height)
+    return nullptr;
+
+  return (const short *)(base + info.offset);
+}
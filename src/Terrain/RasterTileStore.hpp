@@ -0,0 +1,107 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_RASTER_TILE_STORE_HPP
+#define XCSOAR_RASTER_TILE_STORE_HPP
+
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+#include <tchar.h>
+#include <stddef.h>
+#include <stdint.h>
+
+class FileMapping;
+
+/**
+ * A file which contains the decoded height values of all terrain
+ * tiles in a fixed layout.  It is generated once by
+ * RasterTileCache::SaveTileStore(), and is then mapped into memory,
+ * so tiles can be served to #RasterTile without decoding the
+ * JPEG2000 file again.
+ *
+ * Layout: #Header, followed by one #TileInfo per tile, followed by
+ * the raw (host byte order) height values of each tile.
+ */
+class RasterTileStore : private NonCopyable {
+public:
+  struct Header {
+    static constexpr uint32_t VERSION = 1;
+
+    uint32_t version;
+    uint32_t tile_columns, tile_rows;
+  };
+
+  struct TileInfo {
+    /**
+     * The position of the tile's height values, in bytes relative
+     * to the beginning of the #Header.  0 means the tile is not
+     * available.
+     */
+    uint32_t offset;
+
+    uint16_t width, height;
+  };
+
+private:
+  FileMapping *mapping;
+
+  /**
+   * Pointer to the #Header inside the mapping.
+   */
+  const uint8_t *base;
+
+  const TileInfo *index;
+  unsigned num_tiles;
+
+public:
+  RasterTileStore():mapping(nullptr) {}
+
+  ~RasterTileStore() {
+    Close();
+  }
+
+  bool IsDefined() const {
+    return mapping != nullptr;
+  }
+
+  /**
+   * Map the specified file into memory and verify that it matches
+   * the tile layout.
+   *
+   * @param offset the position of the #Header within the file
+   */
+  bool Open(const TCHAR *path, size_t offset,
+            unsigned tile_columns, unsigned tile_rows);
+
+  void Close();
+
+  /**
+   * Returns a pointer to the height values of the specified tile, or
+   * nullptr if the tile is not available or its size does not match.
+   */
+  gcc_pure
+  const short *GetTile(unsigned i, unsigned width, unsigned height) const;
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_PREFETCH_GLUE_HPP
+#define XCSOAR_TERRAIN_PREFETCH_GLUE_HPP
+
+class RasterTerrain;
+class TerrainPrefetchThread;
+
+/**
+ * Create a #TerrainPrefetchThread for the specified terrain.
+ *
+ * @param terrain the terrain; may be NULL
+ * @return the new thread or NULL if there is no terrain
+ */
+TerrainPrefetchThread *
+StartTerrainPrefetch(RasterTerrain *terrain);
+
+/**
+ * Stop the #TerrainPrefetchThread, log its statistics and delete it.
+ * This must be called before the #RasterTerrain it was created for
+ * gets deleted.
+ *
+ * @param thread the thread; may be NULL
+ */
+void
+StopTerrainPrefetch(TerrainPrefetchThread *thread);
+
+#endif
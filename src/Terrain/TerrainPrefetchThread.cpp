@@ -0,0 +1,86 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/TerrainPrefetchThread.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "NMEA/MoreData.hpp"
+#include "Geo/GeoVector.hpp"
+
+void
+TerrainPrefetchThread::OnTimer(const MoreData &basic)
+{
+  if (!basic.location_available || !basic.track_available ||
+      !basic.MovementDetected())
+    /* we don't know where we're going */
+    return;
+
+  if (!clock.CheckUpdate(INTERVAL))
+    return;
+
+  ScopeLock protect(mutex);
+  if (IsBusy())
+    /* still loading the previous prediction */
+    return;
+
+  /* cover the whole path from here to the predicted location with
+     one circle */
+  const GeoVector vector(basic.ground_speed * fixed(LOOKAHEAD), basic.track);
+  const GeoPoint destination = vector.EndPoint(basic.location);
+  center = basic.location.Middle(destination);
+  radius = Half(vector.distance);
+
+  Trigger();
+}
+
+RasterTileCache::PrefetchStatistics
+TerrainPrefetchThread::GetStatistics() const
+{
+  RasterTerrain::Lease lease(terrain);
+  return lease->GetPrefetchStatistics();
+}
+
+void
+TerrainPrefetchThread::Tick()
+{
+  const GeoPoint _center = center;
+  const fixed _radius = radius;
+
+  while (true) {
+    mutex.Unlock();
+
+    bool dirty;
+
+    {
+      RasterTerrain::ExclusiveLease lease(terrain);
+      lease->Prefetch(_center, _radius);
+      dirty = lease->IsDirty();
+    }
+
+    mutex.Lock();
+
+    /* not all tiles could be loaded at once; continue, but give
+       other threads a chance to access the terrain */
+    if (!dirty || IsStopped())
+      break;
+  }
+}
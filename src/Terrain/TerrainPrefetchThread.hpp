@@ -0,0 +1,85 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_TERRAIN_PREFETCH_THREAD_HPP
+#define XCSOAR_TERRAIN_PREFETCH_THREAD_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Terrain/RasterTileCache.hpp"
+#include "Time/PeriodClock.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Math/fixed.hpp"
+
+struct MoreData;
+class RasterTerrain;
+
+/**
+ * Loads terrain tiles in background along the predicted flight path,
+ * so they are available when the map view gets there.
+ */
+class TerrainPrefetchThread final : protected StandbyThread {
+  /**
+   * Minimum interval between two predictions [ms].
+   */
+  static constexpr unsigned INTERVAL = 5000;
+
+  /**
+   * How far ahead the flight path is predicted [s].
+   */
+  static constexpr unsigned LOOKAHEAD = 120;
+
+  RasterTerrain &terrain;
+
+  PeriodClock clock;
+
+  /**
+   * The predicted location and the radius around it which shall be
+   * loaded.  Protected by the mutex.
+   */
+  GeoPoint center;
+  fixed radius;
+
+public:
+  TerrainPrefetchThread(RasterTerrain &_terrain)
+    :terrain(_terrain) {}
+
+  void StopAsync() {
+    ScopeLock protect(mutex);
+    StandbyThread::StopAsync();
+  }
+
+  void WaitStopped() {
+    ScopeLock protect(mutex);
+    StandbyThread::WaitStopped();
+  }
+
+  void OnTimer(const MoreData &basic);
+
+  gcc_pure
+  RasterTileCache::PrefetchStatistics GetStatistics() const;
+
+protected:
+  virtual void Tick() override;
+};
+
+#endif
@@ -193,6 +193,7 @@ TerrainRenderer::TerrainRenderer(const RasterTerrain *_terrain)
 {
   assert(terrain != NULL);
   settings.SetDefaults();
+  raster_renderer.SetConcurrency(settings.threads);
 }
 
 void
@@ -210,6 +211,7 @@ TerrainRenderer::SetSettings(const TerrainRendererSettings &_settings)
     return;
 
   settings = _settings;
+  raster_renderer.SetConcurrency(settings.threads);
 
 #ifdef ENABLE_OPENGL
   raster_renderer.Invalidate();
@@ -262,7 +264,12 @@ TerrainRenderer::Generate(const WindowProjection &map_projection,
   compare_projection = CompareProjection(map_projection);
 #endif
 
-  terrain_serial = terrain->GetSerial();
+  if (terrain_serial != terrain->GetSerial()) {
+    /* tiles have been loaded or discarded: the previous height matrix
+       is obsolete */
+    raster_renderer.Invalidate();
+    terrain_serial = terrain->GetSerial();
+  }
 
   last_sun_azimuth = sunazimuth;
 
@@ -53,6 +53,12 @@ struct TerrainRendererSettings {
 
   unsigned short ramp;
 
+  /**
+   * The number of threads used for shading the terrain.  0 selects
+   * the number of CPUs; 1 disables multi-threading.
+   */
+  unsigned threads;
+
   /**
    * Set all attributes to the default values.
    */
@@ -63,7 +69,8 @@ struct TerrainRendererSettings {
       slope_shading == other.slope_shading &&
       contrast == other.contrast &&
       brightness == other.brightness &&
-      ramp == other.ramp;
+      ramp == other.ramp &&
+      threads == other.threads;
   }
 
   bool operator!=(const TerrainRendererSettings &other) const {
@@ -201,6 +201,9 @@ WeatherTerrainRenderer::Generate(const WindowProjection &projection,
     last_color_ramp = color_ramp;
   }
 
+  /* the weather map may have been reloaded; don't reuse anything
+     from the previous frame */
+  raster_renderer.Invalidate();
   raster_renderer.ScanMap(*map, projection);
 
   raster_renderer.GenerateImage(do_shading, height_scale,
@@ -0,0 +1,113 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/ThreadPool.hpp"
+#include "Util/Clamp.hpp"
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include <assert.h>
+
+/**
+ * Determine the number of CPUs which are online.
+ */
+gcc_pure
+static unsigned
+GetProcessorCount()
+{
+#if defined(HAVE_POSIX) && defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? (unsigned)n : 1u;
+#elif !defined(HAVE_POSIX)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors;
+#else
+  return 1;
+#endif
+}
+
+void
+ThreadPool::Worker::Start(Job &_job, unsigned _index, unsigned _n)
+{
+  ScopeLock protect(mutex);
+  job = &_job;
+  index = _index;
+  n = _n;
+  done = false;
+  Trigger();
+}
+
+bool
+ThreadPool::Worker::Wait()
+{
+  ScopeLock protect(mutex);
+  WaitDone();
+  return done;
+}
+
+void
+ThreadPool::Worker::Tick()
+{
+  mutex.Unlock();
+  job->Run(index, n);
+  mutex.Lock();
+
+  done = true;
+}
+
+ThreadPool::~ThreadPool()
+{
+  for (auto &worker : workers)
+    worker.Stop();
+}
+
+void
+ThreadPool::SetConcurrency(unsigned _concurrency)
+{
+  if (_concurrency == 0)
+    _concurrency = GetProcessorCount();
+
+  concurrency = Clamp(_concurrency, 1u, unsigned(MAX_CONCURRENCY));
+}
+
+void
+ThreadPool::Run(Job &job, unsigned n)
+{
+  assert(n >= 1);
+  assert(n <= MAX_CONCURRENCY);
+
+  for (unsigned i = 1; i < n; ++i)
+    workers[i - 1].Start(job, i, n);
+
+  job.Run(0, n);
+
+  for (unsigned i = 1; i < n; ++i)
+    if (!workers[i - 1].Wait())
+      /* the thread could not be launched; do it here */
+      job.Run(i, n);
+}
@@ -0,0 +1,123 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_THREAD_POOL_HPP
+#define XCSOAR_THREAD_THREAD_POOL_HPP
+
+#include "Thread/StandbyThread.hpp"
+#include "Util/NonCopyable.hpp"
+
+/**
+ * A small pool of #StandbyThread instances which run one job in
+ * parallel.  The job is split into parts by the caller; part 0 runs
+ * in the calling thread, the others in the worker threads.  The
+ * threads are launched on demand and stay alive until the pool is
+ * destructed.
+ *
+ * This class is not thread-safe; only one thread may submit jobs.
+ */
+class ThreadPool : private NonCopyable {
+public:
+  static constexpr unsigned MAX_CONCURRENCY = 8;
+
+  class Job {
+  public:
+    /**
+     * Run one part of the job.  This is called concurrently in
+     * different threads, with different indexes.
+     *
+     * @param index the part number, 0 to n-1
+     * @param n the number of parts
+     */
+    virtual void Run(unsigned index, unsigned n) = 0;
+  };
+
+private:
+  class Worker final : public StandbyThread {
+    Job *job;
+    unsigned index, n;
+
+    /**
+     * Was the part run by this thread?  If the thread could not be
+     * launched, the caller has to run it.
+     */
+    bool done;
+
+  public:
+    void Start(Job &_job, unsigned _index, unsigned _n);
+
+    /**
+     * Wait for the part to be finished.
+     *
+     * @return true if the part was run by the thread
+     */
+    bool Wait();
+
+    void Stop() {
+      ScopeLock protect(mutex);
+      StandbyThread::Stop();
+    }
+
+  protected:
+    /* virtual methods from class StandbyThread */
+    virtual void Tick() override;
+  };
+
+  /**
+   * The number of threads which are used for a job, including the
+   * calling thread.
+   */
+  unsigned concurrency;
+
+  Worker workers[MAX_CONCURRENCY - 1];
+
+public:
+  ThreadPool():concurrency(1) {}
+  ~ThreadPool();
+
+  unsigned GetConcurrency() const {
+    return concurrency;
+  }
+
+  /**
+   * Set the number of threads which are used for a job, including
+   * the calling thread.  0 selects the number of CPUs.
+   */
+  void SetConcurrency(unsigned _concurrency);
+
+  /**
+   * Run the job in GetConcurrency() parts, and wait until all of
+   * them are finished.
+   */
+  void Run(Job &job) {
+    Run(job, concurrency);
+  }
+
+  /**
+   * Run the job in the specified number of parts (at most
+   * #MAX_CONCURRENCY), and wait until all of them are finished.
+   */
+  void Run(Job &job, unsigned n);
+};
+
+#endif
@@ -0,0 +1,125 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_TRIPLE_BUFFER_HPP
+#define XCSOAR_THREAD_TRIPLE_BUFFER_HPP
+
+#include <atomic>
+
+/**
+ * A lock-free single-producer/single-consumer channel which passes
+ * the most recent value from one thread to another.  The producer
+ * fills the "back" buffer and publishes it with Publish(); the
+ * consumer obtains the latest published value with Fetch().  Neither
+ * side ever waits for the other.
+ *
+ * A value which is published while the previous one has not been
+ * fetched yet replaces it.  This is suitable for values which
+ * accumulate state (like #NMEAInfo), where only the latest one
+ * matters.
+ */
+template<typename T>
+class TripleBuffer {
+  static constexpr unsigned INDEX_MASK = 0x3;
+
+  /**
+   * This flag in #middle means that the middle buffer contains a
+   * value which has not been fetched yet.
+   */
+  static constexpr unsigned FRESH = 0x4;
+
+  T buffers[3];
+
+  /**
+   * The index of the buffer which is exchanged between the two
+   * threads, plus the #FRESH flag.
+   */
+  std::atomic<unsigned> middle;
+
+  /**
+   * The index of the buffer owned by the producer.
+   */
+  unsigned back;
+
+  /**
+   * The index of the buffer owned by the consumer.
+   */
+  unsigned front;
+
+public:
+  TripleBuffer():middle(1), back(0), front(2) {}
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /**
+   * Returns the buffer to be filled by the producer.
+   */
+  T &GetBack() {
+    return buffers[back];
+  }
+
+  /**
+   * Publish the back buffer.  Call this from the producer thread.
+   *
+   * @return false if the previously published value was replaced
+   * before the consumer fetched it
+   */
+  bool Publish() {
+    const unsigned old = middle.exchange(back | FRESH,
+                                         std::memory_order_acq_rel);
+    back = old & INDEX_MASK;
+    return (old & FRESH) == 0;
+  }
+
+  /**
+   * Obtain the latest published value.  Call this from the consumer
+   * thread.
+   *
+   * @return true if a new value is available in the front buffer
+   */
+  bool Fetch() {
+    if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+      return false;
+
+    front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * Returns the value obtained by the last successful Fetch() call.
+   */
+  const T &GetFront() const {
+    return buffers[front];
+  }
+
+  /**
+   * Discard the published value if it has not been fetched yet.  This
+   * may be called concurrently with Publish(), but not with Fetch().
+   */
+  void Discard() {
+    middle.fetch_and(INDEX_MASK, std::memory_order_relaxed);
+  }
+};
+
+#endif
@@ -0,0 +1,140 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_INTERNED_STRING_HPP
+#define XCSOAR_INTERNED_STRING_HPP
+
+#include "StringPool.hpp"
+#include "StringUtil.hpp"
+#include "tstring.hpp"
+#include "Compiler.h"
+
+#include <tchar.h>
+
+/**
+ * An immutable string stored in the global #StringPool.  Copying it
+ * copies just a pointer, and objects with the same value share the
+ * same memory.  Assigning a new value does not modify the old one,
+ * which may still be referenced by other objects.
+ *
+ * The interface is a subset of std::basic_string, to make it a
+ * drop-in replacement for string attributes which are set once and
+ * read often.
+ */
+class InternedString {
+  const TCHAR *value;
+
+public:
+  InternedString():value(_T("")) {}
+
+  InternedString(const TCHAR *_value)
+    :value(string_pool.Intern(_value)) {}
+
+  InternedString(const TCHAR *_value, size_t length)
+    :value(string_pool.Intern(_value, length)) {}
+
+  InternedString(const tstring &_value)
+    :value(string_pool.Intern(_value.c_str(), _value.length())) {}
+
+  InternedString &operator=(const TCHAR *_value) {
+    value = string_pool.Intern(_value);
+    return *this;
+  }
+
+  InternedString &operator=(const tstring &_value) {
+    value = string_pool.Intern(_value.c_str(), _value.length());
+    return *this;
+  }
+
+  void assign(const TCHAR *_value) {
+    value = string_pool.Intern(_value);
+  }
+
+  void assign(const TCHAR *_value, size_t length) {
+    value = string_pool.Intern(_value, length);
+  }
+
+  void clear() {
+    value = _T("");
+  }
+
+  gcc_pure
+  bool empty() const {
+    return StringIsEmpty(value);
+  }
+
+  gcc_pure
+  size_t length() const {
+    return _tcslen(value);
+  }
+
+  gcc_pure
+  size_t size() const {
+    return length();
+  }
+
+  const TCHAR *c_str() const {
+    return value;
+  }
+
+  tstring ToString() const {
+    return tstring(value);
+  }
+
+  /**
+   * Two interned strings are equal if and only if they point to the
+   * same pooled string; only the empty string may have two
+   * representations.
+   */
+  gcc_pure
+  bool operator==(const InternedString &other) const {
+    return value == other.value || (empty() && other.empty());
+  }
+
+  gcc_pure
+  bool operator!=(const InternedString &other) const {
+    return !(*this == other);
+  }
+
+  gcc_pure
+  bool operator==(const TCHAR *other) const {
+    return StringIsEqual(value, other);
+  }
+
+  gcc_pure
+  bool operator!=(const TCHAR *other) const {
+    return !(*this == other);
+  }
+
+  gcc_pure
+  bool operator==(const tstring &other) const {
+    return other == value;
+  }
+
+  gcc_pure
+  bool operator!=(const tstring &other) const {
+    return !(*this == other);
+  }
+};
+
+#endif
@@ -0,0 +1,167 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#ifndef XCSOAR_RADIX_QUEUE_HPP
+#define XCSOAR_RADIX_QUEUE_HPP
+
+#include "Compiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <assert.h>
+
+/**
+ * A priority queue for values with an unsigned key, lowest key first
+ * (a "radix heap").  It is faster than a binary heap when keys are
+ * pushed in (mostly) monotone order, as in Dijkstra's algorithm:
+ * values are sorted into buckets by the highest bit in which their
+ * key differs from the last key removed, and each value moves to a
+ * lower bucket at most 32 times.
+ *
+ * Keys which are lower than the last key removed are allowed; they
+ * are kept in a binary heap together with the values of bucket 0.
+ *
+ * The interface is a subset of std::priority_queue's.
+ *
+ * @param T the value type; it must have a method "unsigned
+ * GetKey() const"
+ */
+template<typename T>
+class RadixQueue {
+  static constexpr unsigned N_BUCKETS = 33;
+
+  struct Greater {
+    gcc_pure
+    bool operator()(const T &a, const T &b) const {
+      return a.GetKey() > b.GetKey();
+    }
+  };
+
+  /**
+   * Bucket 0 is a binary heap containing all values with a key not
+   * greater than #last.  Bucket i contains the values whose key
+   * differs from #last in bit i-1, but not in higher bits.
+   */
+  std::vector<T> buckets[N_BUCKETS];
+
+  /**
+   * The key of the last value moved to bucket 0.
+   */
+  unsigned last;
+
+  unsigned count;
+
+public:
+  typedef unsigned size_type;
+
+  RadixQueue():last(0), count(0) {}
+
+  gcc_pure
+  bool empty() const {
+    return count == 0;
+  }
+
+  gcc_pure
+  size_type size() const {
+    return count;
+  }
+
+  void reserve(size_type capacity) {
+    buckets[0].reserve(capacity);
+  }
+
+  void clear() {
+    for (auto &bucket : buckets)
+      bucket.clear();
+
+    last = 0;
+    count = 0;
+  }
+
+  const T &top() {
+    assert(!empty());
+
+    Refill();
+    return buckets[0].front();
+  }
+
+  void push(const T &value) {
+    const unsigned key = value.GetKey();
+    if (key <= last) {
+      buckets[0].push_back(value);
+      std::push_heap(buckets[0].begin(), buckets[0].end(), Greater());
+    } else
+      buckets[GetBucket(key)].push_back(value);
+
+    ++count;
+  }
+
+  void pop() {
+    assert(!empty());
+
+    Refill();
+    std::pop_heap(buckets[0].begin(), buckets[0].end(), Greater());
+    buckets[0].pop_back();
+    --count;
+  }
+
+private:
+  gcc_pure
+  unsigned GetBucket(unsigned key) const {
+    assert(key > last);
+
+    return 32 - __builtin_clz(key ^ last);
+  }
+
+  /**
+   * Make sure bucket 0 is not empty: find the lowest key in the
+   * first non-empty bucket, and redistribute that bucket's values.
+   */
+  void Refill() {
+    if (!buckets[0].empty())
+      return;
+
+    unsigned i = 1;
+    while (buckets[i].empty())
+      ++i;
+
+    std::vector<T> &source = buckets[i];
+    last = std::min_element(source.begin(), source.end(),
+                            [](const T &a, const T &b) {
+                              return a.GetKey() < b.GetKey();
+                            })->GetKey();
+
+    /* all values move to lower buckets; the ones with the lowest
+       key go to bucket 0, and since their keys are equal, they form
+       a valid heap */
+    for (const T &value : source) {
+      const unsigned key = value.GetKey();
+      buckets[key == last ? 0 : GetBucket(key)].push_back(value);
+    }
+
+    source.clear();
+  }
+};
+
+#endif
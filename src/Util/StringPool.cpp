@@ -0,0 +1,175 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "StringPool.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include <assert.h>
+#include <string.h>
+
+StringPool string_pool;
+
+gcc_pure
+static unsigned
+HashString(const TCHAR *value, size_t length)
+{
+  /* FNV-1a */
+  unsigned hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= (unsigned)value[i];
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+StringPool::~StringPool()
+{
+  Chunk *chunk = chunks;
+  while (chunk != nullptr) {
+    Chunk *next = chunk->next;
+    ::operator delete(chunk);
+    chunk = next;
+  }
+}
+
+const TCHAR **
+StringPool::Find(const TCHAR *value, size_t length, unsigned hash)
+{
+  assert(!table.empty());
+
+  const unsigned mask = table.size() - 1;
+  for (unsigned i = hash & mask;; i = (i + 1) & mask) {
+    const TCHAR *&slot = table[i];
+    if (slot == nullptr ||
+        (_tcsncmp(slot, value, length) == 0 && slot[length] == 0))
+      return &slot;
+  }
+}
+
+StringPool::Chunk *
+StringPool::NewChunk(size_t size)
+{
+  Chunk *chunk = (Chunk *)::operator new(sizeof(*chunk) +
+                                         size * sizeof(TCHAR));
+  chunk->size = size;
+  chunk->used = 0;
+
+  n_bytes += size * sizeof(TCHAR);
+  return chunk;
+}
+
+TCHAR *
+StringPool::Allocate(size_t length)
+{
+  const size_t size = length + 1;
+
+  if (size > CHUNK_SIZE) {
+    /* a long string gets a chunk of its own, which is linked behind
+       the current one, so the space left there is not lost */
+    Chunk *chunk = NewChunk(size);
+    chunk->used = size;
+
+    if (chunks == nullptr) {
+      chunk->next = nullptr;
+      chunks = chunk;
+    } else {
+      chunk->next = chunks->next;
+      chunks->next = chunk;
+    }
+
+    return chunk->GetData();
+  }
+
+  if (chunks == nullptr || chunks->size - chunks->used < size) {
+    Chunk *chunk = NewChunk(CHUNK_SIZE);
+    chunk->next = chunks;
+    chunks = chunk;
+  }
+
+  TCHAR *p = chunks->GetData() + chunks->used;
+  chunks->used += size;
+  return p;
+}
+
+void
+StringPool::Grow()
+{
+  std::vector<const TCHAR *> old(std::max(table.size() * 2, (size_t)1024),
+                                 nullptr);
+  old.swap(table);
+
+  for (const TCHAR *value : old) {
+    if (value == nullptr)
+      continue;
+
+    const size_t length = _tcslen(value);
+    *Find(value, length, HashString(value, length)) = value;
+  }
+}
+
+const TCHAR *
+StringPool::Intern(const TCHAR *value, size_t length)
+{
+  const unsigned hash = HashString(value, length);
+
+  mutex.Lock();
+
+  /* keep the load factor below 1/2 */
+  if ((n_strings + 1) * 2 > table.size())
+    Grow();
+
+  const TCHAR **slot = Find(value, length, hash);
+  if (*slot == nullptr) {
+    TCHAR *p = Allocate(length);
+    memcpy(p, value, length * sizeof(*p));
+    p[length] = 0;
+
+    *slot = p;
+    ++n_strings;
+  }
+
+  const TCHAR *result = *slot;
+  mutex.Unlock();
+  return result;
+}
+
+unsigned
+StringPool::GetCount() const
+{
+  mutex.Lock();
+  const unsigned result = n_strings;
+  mutex.Unlock();
+  return result;
+}
+
+size_t
+StringPool::GetMemoryUsage() const
+{
+  mutex.Lock();
+  const size_t result = n_bytes;
+  mutex.Unlock();
+  return result;
+}
@@ -0,0 +1,126 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_STRING_POOL_HPP
+#define XCSOAR_STRING_POOL_HPP
+
+#include "Thread/FastMutex.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Compiler.h"
+
+#include <vector>
+
+#include <tchar.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * An append-only arena of null-terminated strings.  Each distinct
+ * string is stored only once, and a stored string is never moved or
+ * freed, so the pointers returned by Intern() remain valid for the
+ * lifetime of the pool.
+ *
+ * Strings are packed into large chunks, which avoids one heap
+ * allocation (and its overhead) per string.  This class is
+ * thread-safe.
+ */
+class StringPool : private NonCopyable {
+  /**
+   * The number of characters allocated for one chunk.  Longer
+   * strings get a chunk of their own.
+   */
+  static constexpr size_t CHUNK_SIZE = 16384;
+
+  struct Chunk {
+    Chunk *next;
+    size_t size, used;
+
+    TCHAR *GetData() {
+      return reinterpret_cast<TCHAR *>(this + 1);
+    }
+  };
+
+  mutable FastMutex mutex;
+
+  /**
+   * The chunk which is currently being filled; the head of a linked
+   * list of all chunks.
+   */
+  Chunk *chunks;
+
+  /**
+   * An open-addressing hash table of all stored strings.  The size
+   * is a power of two, and unused slots are nullptr.
+   */
+  std::vector<const TCHAR *> table;
+
+  unsigned n_strings;
+
+  size_t n_bytes;
+
+public:
+  StringPool():chunks(nullptr), n_strings(0), n_bytes(0) {}
+  ~StringPool();
+
+  /**
+   * Returns a pooled copy of the given string.  Equal strings yield
+   * the same pointer.
+   *
+   * @param length the number of characters to copy; the string does
+   * not need to be null-terminated after that
+   */
+  const TCHAR *Intern(const TCHAR *value, size_t length);
+
+  gcc_nonnull_all
+  const TCHAR *Intern(const TCHAR *value) {
+    return Intern(value, _tcslen(value));
+  }
+
+  /**
+   * Returns the number of distinct strings in the pool.
+   */
+  gcc_pure
+  unsigned GetCount() const;
+
+  /**
+   * Returns the number of bytes allocated for the string data.
+   */
+  gcc_pure
+  size_t GetMemoryUsage() const;
+
+private:
+  gcc_pure
+  const TCHAR **Find(const TCHAR *value, size_t length, unsigned hash);
+
+  Chunk *NewChunk(size_t size);
+  TCHAR *Allocate(size_t length);
+
+  void Grow();
+};
+
+/**
+ * The pool which stores the strings of #InternedString objects.
+ */
+extern StringPool string_pool;
+
+#endif
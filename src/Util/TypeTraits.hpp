@@ -80,4 +80,22 @@ struct is_trivial_ndebug
 };
 #endif
 
+/**
+ * Check if the specified type has a trivial default constructor and
+ * a trivial destructor, but allow a non-trivial copy (e.g. one which
+ * copies only the used part of a large array).
+ */
+template<typename T>
+struct has_trivial_constructor_and_destructor
+  : public std::integral_constant<bool,
+#ifdef LIBCXX
+                                  std::is_trivially_default_constructible<T>::value &&
+                                  std::is_trivially_destructible<T>::value>
+#else
+                                  std::has_trivial_default_constructor<T>::value &&
+                                  std::has_trivial_destructor<T>::value>
+#endif
+{
+};
+
 #endif
@@ -29,7 +29,7 @@ Copyright_License {
 #include "ComputerSettings.hpp"
 #include "MapSettings.hpp"
 #include "Terrain/RasterTerrain.hpp"
-#include "Waypoint/WaypointDetailsReader.hpp"
+#include "Terrain/TerrainPrefetchGlue.hpp"
 #include "Topography/TopographyStore.hpp"
 #include "Topography/TopographyGlue.hpp"
 #include "Dialogs/Dialogs.h"
@@ -66,7 +66,6 @@ Copyright_License {
 bool DevicePortChanged = false;
 bool MapFileChanged = false;
 bool AirspaceFileChanged = false;
-bool AirfieldFileChanged = false;
 bool WaypointFileChanged = false;
 bool InputFileChanged = false;
 bool LanguageChanged = false;
@@ -81,7 +80,6 @@ SettingsEnter()
 
   MapFileChanged = false;
   AirspaceFileChanged = false;
-  AirfieldFileChanged = false;
   WaypointFileChanged = false;
   InputFileChanged = false;
   DevicePortChanged = false;
@@ -108,7 +106,6 @@ SettingsLeave(const UISettings &old_ui_settings)
     /* set these flags, because they may be loaded from the map
        file */
     AirspaceFileChanged = true;
-    AirfieldFileChanged = true;
     WaypointFileChanged = true;
     TerrainFileChanged = true;
     TopographyFileChanged = true;
@@ -124,9 +121,14 @@ SettingsLeave(const UISettings &old_ui_settings)
     main_window.SetTerrain(NULL);
     glide_computer->SetTerrain(NULL);
 
+    /* the prefetch thread refers to the old terrain object */
+    StopTerrainPrefetch(terrain_prefetch);
+    terrain_prefetch = NULL;
+
     // re-load terrain
     delete terrain;
     terrain = RasterTerrain::OpenTerrain(file_cache, operation);
+    terrain_prefetch = StartTerrainPrefetch(terrain);
 
     main_window.SetTerrain(terrain);
     glide_computer->SetTerrain(terrain);
@@ -135,10 +137,9 @@ SettingsLeave(const UISettings &old_ui_settings)
     Pages::Update();
   }
 
-  if (WaypointFileChanged || AirfieldFileChanged) {
+  if (WaypointFileChanged) {
     // re-load waypoints
-    WaypointGlue::LoadWaypoints(way_points, terrain, operation);
-    WaypointDetails::ReadFileFromProfile(way_points, operation);
+    WaypointGlue::LoadWaypoints(way_points, terrain, file_cache, operation);
   }
 
   if (WaypointFileChanged && protected_task_manager != NULL) {
@@ -181,7 +182,7 @@ SettingsLeave(const UISettings &old_ui_settings)
       glide_computer->ClearAirspaces();
 
     airspace_database.clear();
-    ReadAirspace(airspace_database, terrain,
+    ReadAirspace(airspace_database, terrain, file_cache,
                  CommonInterface::GetComputerSettings().pressure,
                  operation);
   }
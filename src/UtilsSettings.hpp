@@ -29,7 +29,6 @@ Copyright_License {
 extern bool DevicePortChanged;
 extern bool AirspaceFileChanged;
 extern bool WaypointFileChanged;
-extern bool AirfieldFileChanged;
 extern bool InputFileChanged;
 extern bool MapFileChanged;
 extern bool LanguageChanged;
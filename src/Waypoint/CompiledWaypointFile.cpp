@@ -0,0 +1,194 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Waypoint/CompiledWaypointFile.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "IO/MemoryReader.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdint.h>
+#include <string.h>
+
+namespace CompiledWaypointFile {
+  /**
+   * Followed by the name and the comment, each as a uint32_t length
+   * and the TCHAR array.
+   */
+  struct Record {
+    GeoPoint location;
+    fixed elevation;
+
+    uint32_t original_id;
+    Runway runway;
+    RadioFrequency radio_frequency;
+
+    uint8_t type;
+
+    /**
+     * The #Waypoint::Flags, see #FlagBits.
+     */
+    uint8_t flags;
+
+    int8_t file_num;
+  };
+
+  enum FlagBits : uint8_t {
+    TURN_POINT = 0x1,
+    HOME = 0x2,
+    START_POINT = 0x4,
+    FINISH_POINT = 0x8,
+  };
+}
+
+using namespace CompiledWaypointFile;
+
+static uint8_t
+PackFlags(const Waypoint::Flags flags)
+{
+  return (flags.turn_point ? TURN_POINT : 0) |
+    (flags.home ? HOME : 0) |
+    (flags.start_point ? START_POINT : 0) |
+    (flags.finish_point ? FINISH_POINT : 0);
+}
+
+static Waypoint::Flags
+UnpackFlags(uint8_t bits)
+{
+  Waypoint::Flags flags = Waypoint::Flags::Defaults();
+  flags.turn_point = (bits & TURN_POINT) != 0;
+  flags.home = (bits & HOME) != 0;
+  flags.start_point = (bits & START_POINT) != 0;
+  flags.finish_point = (bits & FINISH_POINT) != 0;
+  return flags;
+}
+
+static bool
+WriteString(FILE *file, const InternedString &value)
+{
+  const uint32_t length = value.length();
+  return fwrite(&length, sizeof(length), 1, file) == 1 &&
+    fwrite(value.c_str(), sizeof(TCHAR), length, file) == length;
+}
+
+static bool
+WriteRecord(FILE *file, const Waypoint &waypoint)
+{
+  Record record;
+
+  /* zero-fill all implicit padding bytes (to make valgrind happy) */
+  memset(&record, 0, sizeof(record));
+
+  record.location = waypoint.location;
+  record.elevation = waypoint.elevation;
+  record.original_id = waypoint.original_id;
+  record.runway = waypoint.runway;
+  record.radio_frequency = waypoint.radio_frequency;
+  record.type = (uint8_t)waypoint.type;
+  record.flags = PackFlags(waypoint.flags);
+  record.file_num = waypoint.file_num;
+
+  return fwrite(&record, sizeof(record), 1, file) == 1 &&
+    WriteString(file, waypoint.name) &&
+    WriteString(file, waypoint.comment);
+}
+
+static bool
+CompareId(const Waypoint *a, const Waypoint *b)
+{
+  return a->id < b->id;
+}
+
+bool
+SaveCompiledWaypoints(FILE *file, const TCHAR *source_path,
+                      const Waypoints &waypoints)
+{
+  /* the tree is not in id order; restore the order of the source
+     file, so the snapshot assigns the same ids as the parser */
+  std::vector<const Waypoint *> sorted;
+  sorted.reserve(waypoints.size());
+  for (const auto &i : waypoints)
+    sorted.push_back(&i);
+  std::sort(sorted.begin(), sorted.end(), CompareId);
+
+  if (!CompiledFile::WriteHeader(file, source_path, sorted.size()))
+    return false;
+
+  for (const Waypoint *waypoint : sorted)
+    if (!WriteRecord(file, *waypoint))
+      return false;
+
+  return true;
+}
+
+static bool
+ReadString(MemoryReader &reader, InternedString &value)
+{
+  uint32_t length;
+  return reader.Read(length) && reader.ReadString(value, length);
+}
+
+static bool
+ReadRecord(MemoryReader &reader, Waypoint &waypoint)
+{
+  Record record;
+  if (!reader.Read(record) ||
+      record.type > (uint8_t)Waypoint::Type::THERMAL_HOTSPOT ||
+      !ReadString(reader, waypoint.name) ||
+      !ReadString(reader, waypoint.comment))
+    return false;
+
+  waypoint.location = record.location;
+  waypoint.elevation = record.elevation;
+  waypoint.original_id = record.original_id;
+  waypoint.runway = record.runway;
+  waypoint.radio_frequency = record.radio_frequency;
+  waypoint.type = (Waypoint::Type)record.type;
+  waypoint.flags = UnpackFlags(record.flags);
+  waypoint.file_num = record.file_num;
+  return true;
+}
+
+bool
+CompiledWaypointsLoader::Read(MemoryReader &reader, unsigned n_records)
+{
+  if (n_records > reader.GetRemaining() / sizeof(Record))
+    return false;
+
+  loaded.resize(n_records);
+  for (auto &waypoint : loaded)
+    if (!ReadRecord(reader, waypoint))
+      return false;
+
+  return true;
+}
+
+void
+CompiledWaypointsLoader::Commit()
+{
+  for (auto &waypoint : loaded)
+    waypoints.Append(std::move(waypoint));
+
+  loaded.clear();
+}
@@ -0,0 +1,72 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_COMPILED_WAYPOINT_FILE_HPP
+#define XCSOAR_COMPILED_WAYPOINT_FILE_HPP
+
+#include "IO/CompiledFile.hpp"
+#include "Engine/Waypoint/Waypoint.hpp"
+
+#include <vector>
+
+class Waypoints;
+
+/**
+ * The payload of a compiled waypoint file (see #CompiledFile): the
+ * waypoints parsed from one waypoint file.
+ *
+ * Airfield details are not part of the snapshot; they are loaded on
+ * demand by WaypointDetails::ReadFromProfile().
+ */
+
+/**
+ * Write all waypoints of the given #Waypoints object to a compiled
+ * waypoint file, in the order they were appended.
+ *
+ * @param source_path the path of the text file the waypoints were
+ * parsed from
+ * @return true on success
+ */
+bool
+SaveCompiledWaypoints(FILE *file, const TCHAR *source_path,
+                      const Waypoints &waypoints);
+
+/**
+ * Reads the waypoints of a compiled waypoint file, and appends them
+ * to the #Waypoints object when the file is valid.
+ */
+class CompiledWaypointsLoader final : public CompiledFile::Loader {
+  Waypoints &waypoints;
+
+  std::vector<Waypoint> loaded;
+
+public:
+  explicit CompiledWaypointsLoader(Waypoints &_waypoints)
+    :waypoints(_waypoints) {}
+
+  /* virtual methods from CompiledFile::Loader */
+  virtual bool Read(MemoryReader &reader, unsigned n_records) override;
+  virtual void Commit() override;
+};
+
+#endif
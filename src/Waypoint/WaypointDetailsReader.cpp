@@ -23,19 +23,17 @@ Copyright_License {
 */
 
 #include "WaypointDetailsReader.hpp"
-#include "Language/Language.hpp"
 #include "Profile/ProfileKeys.hpp"
-#include "Interface.hpp"
 #include "Util/StringUtil.hpp"
 #include "Engine/Waypoint/Waypoint.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "IO/ConfiguredFile.hpp"
-#include "Operation/Operation.hpp"
 
 #include <vector>
+#include <memory>
 
 static const Waypoint *
-FindWaypoint(Waypoints &way_points, const TCHAR *name)
+FindWaypoint(const Waypoints &way_points, const TCHAR *name)
 {
   const Waypoint *wp = way_points.LookupName(name);
   if (wp != NULL)
@@ -59,31 +57,24 @@ FindWaypoint(Waypoints &way_points, const TCHAR *name)
 }
 
 static void
-SetAirfieldDetails(Waypoints &way_points, const TCHAR *name,
-                   const tstring &Details,
+SetAirfieldDetails(Waypoint &waypoint, const tstring &Details,
                    const std::vector<tstring> &files_external,
                    const std::vector<tstring> &files_embed)
 {
-  const Waypoint *wp = FindWaypoint(way_points, name);
-  if (wp == NULL)
-    return;
-
-  Waypoint new_wp(*wp);
-  new_wp.details = Details.c_str();
-  new_wp.files_embed.assign(files_embed.begin(), files_embed.end());
+  waypoint.details = Details.c_str();
+  waypoint.files_embed.assign(files_embed.begin(), files_embed.end());
 #ifdef ANDROID
-  new_wp.files_external.assign(files_external.begin(), files_external.end());
+  waypoint.files_external.assign(files_external.begin(), files_external.end());
 #endif
-  way_points.Replace(*wp, new_wp);
-  way_points.Optimise();
 }
 
 /**
- * Parses the data provided by the airfield details file handle
+ * Parses the data provided by the airfield details file handle, and
+ * collects the sections which belong to the given waypoint
  */
-static void
-ParseAirfieldDetails(Waypoints &way_points, TLineReader &reader,
-                     OperationEnvironment &operation)
+bool
+WaypointDetails::Read(TLineReader &reader, const Waypoints &way_points,
+                      Waypoint &waypoint)
 {
   tstring details;
   std::vector<tstring> files_external, files_embed;
@@ -92,18 +83,19 @@ ParseAirfieldDetails(Waypoints &way_points, TLineReader &reader,
 
   name[0] = 0;
 
+  bool found = false;
+
+  /* are we inside a section which belongs to the waypoint? */
   bool in_details = false;
   int i;
 
-  const long filesize = std::max(reader.GetSize(), 1l);
-  operation.SetProgressRange(100);
-
   TCHAR *line;
   while ((line = reader.ReadLine()) != NULL) {
     if (line[0] == _T('[')) { // Look for start
-      if (in_details)
-        SetAirfieldDetails(way_points, name, details, files_external,
-                           files_embed);
+      if (in_details) {
+        SetAirfieldDetails(waypoint, details, files_external, files_embed);
+        found = true;
+      }
 
       details.clear();
       files_external.clear();
@@ -118,9 +110,10 @@ ParseAirfieldDetails(Waypoints &way_points, TLineReader &reader,
       }
       name[i - 1] = 0;
 
-      in_details = true;
-
-      operation.SetProgressPosition(reader.Tell() * 100 / filesize);
+      const Waypoint *wp = FindWaypoint(way_points, name);
+      in_details = wp != NULL && wp->id == waypoint.id;
+    } else if (!in_details) {
+      /* skip the sections of other waypoints */
     } else if ((filename =
                 StringAfterPrefixCI(line, _T("image="))) != NULL) {
       files_embed.emplace_back(filename);
@@ -138,28 +131,20 @@ ParseAirfieldDetails(Waypoints &way_points, TLineReader &reader,
     }
   }
 
-  if (in_details)
-    SetAirfieldDetails(way_points, name, details, files_external, files_embed);
-}
+  if (in_details) {
+    SetAirfieldDetails(waypoint, details, files_external, files_embed);
+    found = true;
+  }
 
-/**
- * Opens the airfield details file and parses it
- */
-void
-WaypointDetails::ReadFile(TLineReader &reader, Waypoints &way_points,
-                          OperationEnvironment &operation)
-{
-  operation.SetText(_("Loading Airfield Details File..."));
-  ParseAirfieldDetails(way_points, reader, operation);
+  return found;
 }
 
-void
-WaypointDetails::ReadFileFromProfile(Waypoints &way_points,
-                                     OperationEnvironment &operation)
+bool
+WaypointDetails::ReadFromProfile(const Waypoints &way_points,
+                                 Waypoint &waypoint)
 {
   std::unique_ptr<TLineReader>
   reader(OpenConfiguredTextFile(ProfileKeys::AirfieldFile, _T("airfields.txt"),
                                 ConvertLineReader::AUTO));
-  if (reader)
-    ReadFile(*reader, way_points, operation);
+  return reader && Read(*reader, way_points, waypoint);
 }
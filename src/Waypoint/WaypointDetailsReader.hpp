@@ -24,16 +24,35 @@ Copyright_License {
 #ifndef WAYPOINT_DETAILS_READER_HPP
 #define WAYPOINT_DETAILS_READER_HPP
 
+struct Waypoint;
 class Waypoints;
-class OperationEnvironment;
 class TLineReader;
 
+/**
+ * Reads the airfield details file.  The details are not kept in
+ * memory; they are looked up on demand when a waypoint's details are
+ * shown.
+ */
 namespace WaypointDetails
 {
-  void ReadFile(TLineReader &reader, Waypoints &way_points,
-                OperationEnvironment &operation);
-  void ReadFileFromProfile(Waypoints &way_points,
-                           OperationEnvironment &operation);
+  /**
+   * Look up the details of a waypoint in an airfield details file,
+   * and store them in Waypoint::details, Waypoint::files_embed and
+   * Waypoint::files_external.  If there are several sections for the
+   * waypoint, the last one wins.
+   *
+   * @param way_points the database which contains the waypoint; it
+   * is used to resolve the section names
+   * @return true if details for the waypoint were found
+   */
+  bool Read(TLineReader &reader, const Waypoints &way_points,
+            Waypoint &waypoint);
+
+  /**
+   * Like Read(), but use the airfield details file configured in the
+   * profile.
+   */
+  bool ReadFromProfile(const Waypoints &way_points, Waypoint &waypoint);
 }
 
 #endif
@@ -28,14 +28,19 @@ Copyright_License {
 #include "LogFile.hpp"
 #include "Waypoint/Waypoints.hpp"
 #include "WaypointReader.hpp"
+#include "CompiledWaypointFile.hpp"
 #include "Language/Language.hpp"
 #include "NMEA/Aircraft.hpp"
 #include "Airspace/ProtectedAirspaceWarningManager.hpp"
 #include "IO/TextWriter.hpp"
+#include "IO/FileCache.hpp"
 #include "OS/PathName.hpp"
 #include "Waypoint/WaypointWriter.hpp"
 #include "Operation/Operation.hpp"
 
+#include <algorithm>
+#include <vector>
+
 #include <windef.h> /* for MAX_PATH */
 
 namespace WaypointGlue {
@@ -83,8 +88,9 @@ WaypointGlue::IsWritable()
 }
 
 static bool
-LoadWaypointFile(Waypoints &waypoints, const TCHAR *path, int file_num,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+ParseWaypointFile(Waypoints &waypoints, const TCHAR *path, int file_num,
+                  const RasterTerrain *terrain, bool &needs_terrain,
+                  OperationEnvironment &operation)
 {
   WaypointReader reader(path, file_num);
   if (reader.Error()) {
@@ -99,12 +105,91 @@ LoadWaypointFile(Waypoints &waypoints, const TCHAR *path, int file_num,
     return false;
   }
 
+  needs_terrain = reader.NeedsTerrain();
+  return true;
+}
+
+/**
+ * Save the waypoints parsed from one file as a compiled waypoint
+ * file in the cache.
+ */
+static bool
+CompileWaypointFile(FileCache &cache, const TCHAR *name, const TCHAR *path,
+                    const Waypoints &parsed)
+{
+  FILE *file = cache.Save(name, path);
+  if (file == NULL)
+    return false;
+
+  return CompiledFile::Finish(cache, name, file,
+                              SaveCompiledWaypoints(file, path, parsed));
+}
+
+static bool
+CompareId(const Waypoint *a, const Waypoint *b)
+{
+  return a->id < b->id;
+}
+
+/**
+ * Append copies of all waypoints, in the order they were appended to
+ * the source.
+ */
+static void
+AppendWaypoints(Waypoints &dest, const Waypoints &src)
+{
+  std::vector<const Waypoint *> sorted;
+  sorted.reserve(src.size());
+  for (const auto &i : src)
+    sorted.push_back(&i);
+  std::sort(sorted.begin(), sorted.end(), CompareId);
+
+  for (const Waypoint *waypoint : sorted)
+    dest.Append(Waypoint(*waypoint));
+}
+
+/**
+ * Load the waypoint file from its compiled version in the cache, and
+ * compile it if the cache does not have a valid one.  Falls back to
+ * parsing the file if there is no cache.
+ *
+ * Waypoints whose elevation had to be looked up in the terrain
+ * depend on the terrain file, which is not covered by the cache, so
+ * such waypoint files are not compiled.
+ *
+ * @param name the name of the compiled waypoint file in the cache
+ */
+static bool
+LoadWaypointFile(Waypoints &waypoints, const TCHAR *path, int file_num,
+                 const RasterTerrain *terrain, FileCache *cache,
+                 const TCHAR *name, OperationEnvironment &operation)
+{
+  bool needs_terrain;
+
+  if (cache == NULL)
+    return ParseWaypointFile(waypoints, path, file_num, terrain,
+                             needs_terrain, operation);
+
+  CompiledWaypointsLoader loader(waypoints);
+  if (CompiledFile::Load(*cache, name, path, loader))
+    return true;
+
+  Waypoints parsed;
+  if (!ParseWaypointFile(parsed, path, file_num, terrain, needs_terrain,
+                         operation))
+    return false;
+
+  if (!needs_terrain)
+    CompileWaypointFile(*cache, name, path, parsed);
+
+  AppendWaypoints(waypoints, parsed);
   return true;
 }
 
 bool
 WaypointGlue::LoadWaypoints(Waypoints &way_points,
                             const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation)
 {
   LogFormat("ReadWaypoints");
@@ -119,15 +204,18 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
 
   // ### FIRST FILE ###
   if (Profile::GetPath(ProfileKeys::WaypointFile, path))
-    found |= LoadWaypointFile(way_points, path, 1, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 1, terrain, cache,
+                              _T("waypoints1"), operation);
 
   // ### SECOND FILE ###
   if (Profile::GetPath(ProfileKeys::AdditionalWaypointFile, path))
-    found |= LoadWaypointFile(way_points, path, 2, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 2, terrain, cache,
+                              _T("waypoints2"), operation);
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
   if (Profile::GetPath(ProfileKeys::WatchedWaypointFile, path))
-    found |= LoadWaypointFile(way_points, path, 3, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 3, terrain, cache,
+                              _T("waypoints3"), operation);
 
   // ### MAP/FOURTH FILE ###
 
@@ -136,10 +224,12 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
     TCHAR *tail = path + _tcslen(path);
 
     _tcscpy(tail, _T("/waypoints.xcw"));
-    found |= LoadWaypointFile(way_points, path, 0, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 0, terrain, cache,
+                              _T("waypoints_map_xcw"), operation);
 
     _tcscpy(tail, _T("/waypoints.cup"));
-    found |= LoadWaypointFile(way_points, path, 0, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 0, terrain, cache,
+                              _T("waypoints_map_cup"), operation);
   }
 
   // Optimise the waypoint list after attaching new waypoints
@@ -89,6 +89,13 @@ public:
    */
   bool Parse(Waypoints &way_points, OperationEnvironment &operation);
 
+  /**
+   * @see WaypointReaderBase::NeedsTerrain()
+   */
+  bool NeedsTerrain() const {
+    return reader != NULL && reader->NeedsTerrain();
+  }
+
   /**
    * Returns whether there is a valid internal reader
    * that can be used for parsing the waypoint file.
@@ -41,6 +41,12 @@ protected:
   const RasterTerrain* terrain;
   bool compressed;
 
+  /**
+   * Was the elevation of a waypoint missing, so it had to be looked
+   * up in the terrain?
+   */
+  bool needs_terrain;
+
 protected:
   WaypointReaderBase(const int _file_num,
                bool _compressed = false);
@@ -61,9 +67,17 @@ public:
     terrain = _terrain;
   }
 
+  /**
+   * Did the parsed waypoints depend on the terrain, because some
+   * elevations were missing in the file?
+   */
+  bool NeedsTerrain() const {
+    return needs_terrain;
+  }
+
 protected:
   static bool CheckAltitude(Waypoint &new_waypoint, const RasterTerrain *terrain);
-  bool CheckAltitude(Waypoint &new_waypoint) const;
+  bool CheckAltitude(Waypoint &new_waypoint);
 
   /**
    * Parse a file line
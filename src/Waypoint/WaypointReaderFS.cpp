@@ -131,16 +131,17 @@ ParseAltitude(const TCHAR *src, fixed &dest)
 }
 
 static bool
-ParseString(const TCHAR *src, tstring &dest, unsigned len = 0)
+ParseString(const TCHAR *src, InternedString &dest, unsigned len = 0)
 {
   if (src[0] == 0)
     return true;
 
-  dest.assign(src);
+  tstring value(src);
   if (len > 0)
-    dest = dest.substr(0, len);
+    value = value.substr(0, len);
 
-  trim_inplace(dest);
+  trim_inplace(value);
+  dest = value;
 
   return true;
 }
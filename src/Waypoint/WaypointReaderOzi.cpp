@@ -54,13 +54,14 @@ ParseNumber(const TCHAR *src, long &dest)
 }
 
 static bool
-ParseString(const TCHAR *src, tstring &dest)
+ParseString(const TCHAR *src, InternedString &dest)
 {
   if (src[0] == 0)
     return true;
 
-  dest.assign(src);
-  trim_inplace(dest);
+  tstring value(src);
+  trim_inplace(value);
+  dest = value;
 
   return true;
 }
@@ -27,20 +27,21 @@ Copyright_License {
 #include <stdio.h>
 
 static bool
-ParseString(const TCHAR* src, tstring& dest, unsigned len)
+ParseString(const TCHAR* src, InternedString& dest, unsigned len)
 {
   if (src[0] == 0)
     return true;
 
-  dest.assign(src);
+  tstring value(src);
 
   // Cut the string after the first space, tab or null character
-  size_t found = dest.find_first_of(_T("\t\0"));
+  size_t found = value.find_first_of(_T("\t\0"));
   if (found != tstring::npos)
-    dest = dest.substr(0, found);
+    value = value.substr(0, found);
 
-  dest = dest.substr(0, len);
-  trim_inplace(dest);
+  value = value.substr(0, len);
+  trim_inplace(value);
+  dest = value;
   return true;
 }
 
@@ -0,0 +1,245 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compares the airspace containers Airspaces::AirspaceKDTree and
+ * Airspaces::AirspaceTree on random airspaces generated by
+ * harness_airspace.  The range, intersection and inside queries
+ * issued by Airspaces are timed on both, and both must return the
+ * same airspaces.
+ *
+ * Usage: BenchmarkAirspaces [NUMBER_OF_AIRSPACES]
+ */
+
+#include "harness_airspace.hpp"
+#include "Geo/Flat/FlatRay.hpp"
+#include "Geo/GeoVector.hpp"
+#include "OS/Clock.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_QUERIES = 2000;
+static constexpr unsigned ROUNDS = 10;
+
+enum class QueryType {
+  RANGE,
+  INTERSECT,
+  INSIDE,
+};
+
+struct Query {
+  /** the location passed to Airspace::IsInside() */
+  GeoPoint location;
+
+  /** the box passed to the tree, enlarged by #range */
+  Airspace target;
+  unsigned range;
+
+  /** the ray passed to Airspace::Intersects() */
+  FlatRay ray;
+
+  Query(const GeoPoint &_location, const GeoPoint &end,
+        const TaskProjection &projection, QueryType type)
+    :location(_location),
+     target(type == QueryType::INTERSECT ? location.Middle(end) : location,
+            projection),
+     range(type == QueryType::INSIDE
+           ? 0
+           : projection.ProjectRangeInteger(location,
+                                            location.Distance(end) /
+                                            (type == QueryType::RANGE
+                                             ? 1 : 2))),
+     ray(projection.ProjectInteger(location), projection.ProjectInteger(end)) {}
+};
+
+typedef std::vector<const AbstractAirspace *> Result;
+
+/**
+ * A visitor which collects the airspaces matching a query.  It
+ * stores pointers only, because KDTree needs to copy-assign it.
+ */
+class Collector {
+  const Query *query;
+  QueryType type;
+  Result *result;
+
+public:
+  Collector(const Query &_query, QueryType _type, Result &_result)
+    :query(&_query), type(_type), result(&_result) {}
+
+  void operator()(const Airspace &as) {
+    switch (type) {
+    case QueryType::RANGE:
+      break;
+
+    case QueryType::INTERSECT:
+      if (!as.Intersects(query->ray))
+        return;
+      break;
+
+    case QueryType::INSIDE:
+      if (!as.IsInside(query->location))
+        return;
+      break;
+    }
+
+    result->push_back(as.GetAirspace());
+  }
+};
+
+static void
+Visit(const Airspaces::AirspaceKDTree &tree, const Query &query,
+      Collector &collector)
+{
+  tree.visit_within_range(query.target, -(int)query.range, collector);
+}
+
+static void
+Visit(const Airspaces::AirspaceTree &tree, const Query &query,
+      Collector &collector)
+{
+  tree.visit_within_range(query.target, query.range, collector);
+}
+
+template<typename Tree>
+static std::vector<Result>
+Run(const char *name, const Tree &tree,
+    const std::vector<Query> &queries, QueryType type)
+{
+  std::vector<Result> results(queries.size());
+
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned round = 0; round < ROUNDS; ++round) {
+    for (unsigned i = 0; i < queries.size(); ++i) {
+      results[i].clear();
+      Collector collector(queries[i], type, results[i]);
+      Visit(tree, queries[i], collector);
+    }
+  }
+  const uint64_t us = MonotonicClockUS() - start;
+
+  unsigned long found = 0;
+  for (auto &result : results) {
+    std::sort(result.begin(), result.end());
+    found += result.size();
+  }
+
+  printf("  %s: %lu us (%lu airspaces found)\n", name,
+         (unsigned long)(us / ROUNDS), found);
+  return results;
+}
+
+static bool
+Compare(const char *name,
+        const Airspaces::AirspaceKDTree &kd_tree,
+        const Airspaces::AirspaceTree &r_tree,
+        const std::vector<Query> &queries, QueryType type)
+{
+  printf("%s (%u queries)\n", name, (unsigned)queries.size());
+
+  const auto expected = Run("kd-tree", kd_tree, queries, type);
+  const auto actual = Run("R-tree ", r_tree, queries, type);
+  for (unsigned i = 0; i < queries.size(); ++i) {
+    if (actual[i] != expected[i]) {
+      fprintf(stderr, "Mismatch in query %u: %u != %u airspaces\n", i,
+              (unsigned)actual[i].size(), (unsigned)expected[i].size());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static GeoPoint
+RandomLocation(const GeoPoint &center)
+{
+  return GeoPoint(center.longitude +
+                  Angle::Degrees(fixed((rand() % 1600 - 800) / 1000.0)),
+                  center.latitude +
+                  Angle::Degrees(fixed((rand() % 1600 - 800) / 1000.0)));
+}
+
+static std::vector<Query>
+MakeQueries(const GeoPoint &center, const TaskProjection &projection,
+            QueryType type)
+{
+  std::vector<Query> queries;
+  queries.reserve(N_QUERIES);
+  for (unsigned i = 0; i < N_QUERIES; ++i) {
+    const GeoPoint location = RandomLocation(center);
+    const GeoVector vector(fixed(1000 + rand() % 30000),
+                           Angle::Degrees(fixed(rand() % 360)));
+    queries.emplace_back(location, vector.EndPoint(location),
+                         projection, type);
+  }
+
+  return queries;
+}
+
+int
+main(int argc, char **argv)
+{
+  const unsigned n = argc > 1 ? atoi(argv[1]) : 5000;
+  const GeoPoint center(Angle::Degrees(fixed(7.7)),
+                        Angle::Degrees(fixed(51.05)));
+
+  srand(42);
+
+  Airspaces airspaces;
+  setup_airspaces(airspaces, center, n);
+
+  Airspaces::AirspaceKDTree kd_tree;
+  Airspaces::AirspaceTree r_tree;
+  for (const auto &as : airspaces) {
+    kd_tree.insert(as);
+    r_tree.insert(as);
+  }
+
+  printf("build (%u airspaces)\n", airspaces.size());
+
+  uint64_t start = MonotonicClockUS();
+  kd_tree.optimise();
+  printf("  kd-tree: %lu us\n", (unsigned long)(MonotonicClockUS() - start));
+
+  start = MonotonicClockUS();
+  r_tree.optimise();
+  printf("  R-tree : %lu us\n", (unsigned long)(MonotonicClockUS() - start));
+
+  const TaskProjection &projection = airspaces.GetProjection();
+
+  bool success = true;
+  success &= Compare("range", kd_tree, r_tree,
+                     MakeQueries(center, projection, QueryType::RANGE),
+                     QueryType::RANGE);
+  success &= Compare("intersect", kd_tree, r_tree,
+                     MakeQueries(center, projection, QueryType::INTERSECT),
+                     QueryType::INTERSECT);
+  success &= Compare("inside", kd_tree, r_tree,
+                     MakeQueries(center, projection, QueryType::INSIDE),
+                     QueryType::INSIDE);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compares the Dijkstra MapTemplates HashScanTaskPointMap and
+ * DenseScanTaskPointMap on graphs shaped like the ones built by
+ * ContestDijkstra (OLC classic on a trace) and TaskDijkstraMax (a
+ * task with sampled observation zone boundaries), and verifies that
+ * both find equally good paths.
+ */
+
+#include "PathSolvers/Dijkstra.hpp"
+#include "PathSolvers/ScanTaskPointMap.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "Math/FastMath.h"
+#include "OS/Clock.hpp"
+#include "Compiler.h"
+
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned ROUNDS = 20;
+
+struct Graph {
+  /**
+   * The points of each stage.
+   */
+  std::vector<std::vector<FlatGeoPoint>> stages;
+
+  /**
+   * Do all stages share the same points, which must be visited in
+   * order (like a trace)?
+   */
+  bool ordered;
+
+  gcc_pure
+  const FlatGeoPoint &GetPoint(ScanTaskPoint p) const {
+    return stages[p.GetStageNumber()][p.GetPointIndex()];
+  }
+};
+
+/**
+ * A random walk, similar to a thinned flight trace.
+ */
+static Graph
+MakeContestGraph(unsigned n_points, unsigned n_stages)
+{
+  std::vector<FlatGeoPoint> trace;
+  FlatGeoPoint p(0, 0);
+  for (unsigned i = 0; i < n_points; ++i) {
+    p.longitude += rand() % 41 - 18;
+    p.latitude += rand() % 41 - 20;
+    trace.push_back(p);
+  }
+
+  Graph graph;
+  graph.stages.assign(n_stages, trace);
+  graph.ordered = true;
+  return graph;
+}
+
+/**
+ * Circles around random turn points, similar to the boundaries of a
+ * racing task.
+ */
+static Graph
+MakeTaskGraph(unsigned n_points, unsigned n_stages)
+{
+  Graph graph;
+  graph.stages.resize(n_stages);
+  for (auto &stage : graph.stages) {
+    const FlatGeoPoint center(rand() % 2000, rand() % 2000);
+    const unsigned radius = 10 + rand() % 50;
+    for (unsigned i = 0; i < n_points; ++i) {
+      const int dx = rand() % (2 * radius + 1) - radius;
+      const int dy = (int)isqrt4(radius * radius - dx * dx) *
+        (rand() % 2 ? 1 : -1);
+      stage.push_back(FlatGeoPoint(center.longitude + dx,
+                                   center.latitude + dy));
+    }
+  }
+
+  graph.ordered = false;
+  return graph;
+}
+
+/**
+ * Find the path with the maximum distance through all stages.
+ *
+ * @return the distance of that path
+ */
+template<typename MapTemplate>
+static unsigned
+Solve(const Graph &graph)
+{
+  Dijkstra<ScanTaskPoint, MapTemplate> dijkstra;
+  dijkstra.Clear();
+  dijkstra.Reserve(5000);
+
+  const unsigned n_stages = graph.stages.size();
+  for (unsigned i = 0; i < graph.stages[0].size(); ++i)
+    dijkstra.Link(ScanTaskPoint(0, i), ScanTaskPoint(0, i), 0);
+
+  while (!dijkstra.IsEmpty()) {
+    const ScanTaskPoint origin = dijkstra.Pop();
+    const unsigned stage = origin.GetStageNumber();
+
+    if (stage + 1 == n_stages) {
+      unsigned distance = 0;
+      for (ScanTaskPoint p = origin; p.GetStageNumber() > 0;) {
+        const ScanTaskPoint parent = dijkstra.GetPredecessor(p);
+        distance += graph.GetPoint(p).Distance(graph.GetPoint(parent));
+        p = parent;
+      }
+
+      return distance;
+    }
+
+    const FlatGeoPoint &location = graph.GetPoint(origin);
+    const unsigned size = graph.stages[stage + 1].size();
+    for (unsigned i = graph.ordered ? origin.GetPointIndex() : 0;
+         i < size; ++i) {
+      const ScanTaskPoint destination(stage + 1, i);
+      const unsigned d = location.Distance(graph.GetPoint(destination));
+      dijkstra.Link(destination, origin, DIJKSTRA_MINMAX_OFFSET - d);
+    }
+  }
+
+  return 0;
+}
+
+template<typename MapTemplate>
+static unsigned
+Run(const char *name, const Graph &graph)
+{
+  unsigned distance = 0;
+
+  const uint64_t start = MonotonicClockUS();
+  for (unsigned i = 0; i < ROUNDS; ++i)
+    distance = Solve<MapTemplate>(graph);
+  const uint64_t us = MonotonicClockUS() - start;
+
+  printf("  %s: %lu us\n", name, (unsigned long)(us / ROUNDS));
+  return distance;
+}
+
+static bool
+Compare(const char *name, const Graph &graph)
+{
+  printf("%s\n", name);
+
+  const unsigned expected = Run<HashScanTaskPointMap>("hash ", graph);
+  const unsigned actual = Run<DenseScanTaskPointMap>("dense", graph);
+  if (actual != expected) {
+    fprintf(stderr, "Mismatch: %u != %u\n", actual, expected);
+    return false;
+  }
+
+  return true;
+}
+
+int
+main(gcc_unused int argc, gcc_unused char **argv)
+{
+  srand(42);
+
+  bool success = true;
+  success &= Compare("contest (512 points, 7 stages)",
+                     MakeContestGraph(512, 7));
+  success &= Compare("contest (1024 points, 5 stages)",
+                     MakeContestGraph(1024, 5));
+  success &= Compare("task (64 points, 8 stages)",
+                     MakeTaskGraph(64, 8));
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
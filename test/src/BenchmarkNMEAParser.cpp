@@ -0,0 +1,134 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measures the throughput of the NMEA parsers.  A set of typical
+ * sentences (GPS, FLARM, LX vario) is parsed repeatedly, first by the
+ * specified driver (if any), then by NMEAParser, the same way
+ * DeviceDescriptor::ParseNMEA() does.  Lines read from stdin replace
+ * the built-in sentences.
+ *
+ * Usage: BenchmarkNMEAParser [DRIVER] [< FILE.nmea]
+ */
+
+#include "NMEA/Info.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Driver.hpp"
+#include "Device/Register.hpp"
+#include "Device/Parser.hpp"
+#include "OS/Clock.hpp"
+#include "OS/PathName.hpp"
+#include "Profile/DeviceConfig.hpp"
+#include "Util/StringUtil.hpp"
+
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static constexpr unsigned ROUNDS = 20000;
+
+static const char *const default_sentences[] = {
+  "$GPRMC,082310,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.3,W*6D",
+  "$GPGGA,082310,5103.5403,N,00741.5742,E,1,08,0.9,1247.6,M,46.9,M,,*75",
+  "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39",
+  "$PGRMZ,2447,F,2*0F",
+  "$PFLAU,3,1,2,1,1,-30,2,-32,755*55",
+  "$PFLAA,0,-1234,1234,220,2,DD8F12,180,,30,-1.4,1*19",
+  "$PFLAA,1,100,-150,10,2,DDA85C,123,13,24,1.4,2*7E",
+  "$PFLAA,0,1206,574,21,2,DDAED5,196,,32,1.0,1*10",
+  "$LXWP0,Y,222.3,1665.5,1.71,,,,,,239,174,10.1*47",
+  "$PTAS1,201,200,02426,000*24",
+};
+
+int main(int argc, char **argv)
+{
+  if (argc > 2) {
+    fprintf(stderr, "Usage: %s [DRIVER]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  Device *device = NULL;
+  NullPort port;
+  if (argc == 2) {
+    PathName driver_name(argv[1]);
+    const struct DeviceRegister *driver = FindDriverByName(driver_name);
+    if (driver == NULL) {
+      fprintf(stderr, "No such driver: %s\n", argv[1]);
+      return EXIT_FAILURE;
+    }
+
+    DeviceConfig config;
+    config.Clear();
+
+    if (driver->CreateOnPort != NULL)
+      device = driver->CreateOnPort(config, port);
+  }
+
+  std::vector<std::string> sentences;
+  if (!isatty(0)) {
+    char buffer[1024];
+    while (fgets(buffer, sizeof(buffer), stdin) != NULL) {
+      TrimRight(buffer);
+      if (!StringIsEmpty(buffer))
+        sentences.push_back(buffer);
+    }
+  }
+
+  if (sentences.empty())
+    for (const char *sentence : default_sentences)
+      sentences.push_back(sentence);
+
+  NMEAParser parser;
+
+  NMEAInfo data;
+  data.Reset();
+  data.UpdateClock();
+
+  unsigned n_parsed = 0;
+
+  const uint64_t start = MonotonicClockUS();
+
+  for (unsigned round = 0; round < ROUNDS; ++round) {
+    for (const auto &sentence : sentences) {
+      if ((device != NULL && device->ParseNMEA(sentence.c_str(), data)) ||
+          parser.ParseLine(sentence.c_str(), data))
+        ++n_parsed;
+    }
+
+    /* keep the FLARM traffic list from filling up */
+    data.flarm.traffic.Clear();
+  }
+
+  const uint64_t us = MonotonicClockUS() - start;
+  const unsigned long n = (unsigned long)ROUNDS * sentences.size();
+
+  printf("%lu sentences (%u parsed) in %lu us: %.0f sentences/s\n",
+         n, n_parsed, (unsigned long)us,
+         us > 0 ? n * 1000000. / us : 0.);
+
+  delete device;
+  return EXIT_SUCCESS;
+}
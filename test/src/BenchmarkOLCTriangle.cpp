@@ -0,0 +1,227 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measures how long OLCTriangle takes to find the best FAI and free
+ * triangle in a flight, and verifies the results against a brute
+ * force search over all turn point combinations.
+ */
+
+#include "Engine/Trace/Trace.hpp"
+#include "Contest/Solvers/OLCTriangle.hpp"
+#include "Geo/Flat/TaskProjection.hpp"
+#include "OS/Args.hpp"
+#include "OS/Clock.hpp"
+#include "DebugReplay.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr fixed max_distance(5000);
+
+/**
+ * The brute force equivalent of OLCTriangle.
+ *
+ * @return the flat distance of the best triangle
+ */
+static unsigned
+SolveBruteForce(const Trace &trace, bool is_fai)
+{
+  TracePointVector points;
+  trace.GetPoints(points);
+  const unsigned n = points.size();
+
+  /* for each start point, the last trace point which closes the
+     triangle with this or an earlier start point */
+  std::vector<unsigned> closing(n);
+  unsigned last = 0;
+  for (unsigned i = 0; i < n; ++i) {
+    const unsigned range =
+      trace.ProjectRange(points[i].GetLocation(), max_distance);
+    for (unsigned j = n - 1; j > last; --j) {
+      if (points[i].FlatDistanceTo(points[j]) <= range &&
+          points[i].GetLocation().Distance(points[j].GetLocation()) < max_distance) {
+        last = j;
+        break;
+      }
+    }
+
+    closing[i] = std::max(i, last);
+  }
+
+  unsigned best = 0;
+  for (unsigned a = 0; a < n; ++a) {
+    for (unsigned b = a + 1; b < n; ++b) {
+      const unsigned d1 = points[a].FlatDistanceTo(points[b]);
+
+      for (unsigned c = b + 1; c <= closing[a]; ++c) {
+        const unsigned d2 = points[b].FlatDistanceTo(points[c]);
+        const unsigned d3 = points[c].FlatDistanceTo(points[a]);
+        const unsigned total = d1 + d2 + d3;
+        if (total <= best || total < 20)
+          continue;
+
+        const unsigned shortest = std::min({d1, d2, d3});
+        if (shortest == 0)
+          continue;
+
+        if (is_fai && shortest * 25 < total * 7) {
+          if (shortest * 4 < total ||
+              std::max({d1, d2, d3}) * 20 > total * 9)
+            continue;
+
+          fixed leg;
+          if (d1 == shortest)
+            leg = points[a].GetLocation().Distance(points[b].GetLocation());
+          else if (d2 == shortest)
+            leg = points[b].GetLocation().Distance(points[c].GetLocation());
+          else
+            leg = points[c].GetLocation().Distance(points[a].GetLocation());
+
+          if (fixed(total) * leg / shortest < fixed(500000))
+            continue;
+        }
+
+        best = total;
+      }
+    }
+  }
+
+  return best;
+}
+
+/**
+ * Calculate the flat distance of the triangle found by OLCTriangle.
+ */
+static unsigned
+GetFlatDistance(const Trace &trace, const ContestTraceVector &solution)
+{
+  if (solution.size() != 5)
+    return 0;
+
+  FlatGeoPoint tp[3];
+  for (unsigned i = 0; i < 3; ++i)
+    tp[i] = trace.GetProjection().ProjectInteger(solution[1 + i].GetLocation());
+
+  return tp[0].Distance(tp[1]) + tp[1].Distance(tp[2]) +
+    tp[2].Distance(tp[0]);
+}
+
+static bool
+Run(const Trace &trace, bool is_fai)
+{
+  OLCTriangle triangle(trace, is_fai, false);
+  triangle.Reset();
+
+  uint64_t start = MonotonicClockUS();
+  triangle.Solve(true);
+  const uint64_t solver_us = MonotonicClockUS() - start;
+
+  start = MonotonicClockUS();
+  const unsigned expected = SolveBruteForce(trace, is_fai);
+  const uint64_t brute_force_us = MonotonicClockUS() - start;
+
+  const unsigned actual = GetFlatDistance(trace,
+                                          triangle.GetBestSolution());
+
+  printf("  %s: %.3f km, OLCTriangle %lu us, brute force %lu us\n",
+         is_fai ? "FAI " : "free",
+         (double)triangle.GetBestResult().distance / 1000,
+         (unsigned long)solver_us, (unsigned long)brute_force_us);
+
+  if (actual != expected) {
+    fprintf(stderr, "Mismatch: flat distance %u != %u\n", actual, expected);
+    return false;
+  }
+
+  /* solve again in small steps, like ContestManager does while
+     flying; each step must be short */
+  triangle.Reset();
+
+  unsigned n_calls = 0;
+  uint64_t max_call_us = 0;
+  SolverResult result;
+  do {
+    start = MonotonicClockUS();
+    result = triangle.Solve(false);
+    max_call_us = std::max(max_call_us, MonotonicClockUS() - start);
+    ++n_calls;
+  } while (result == SolverResult::INCOMPLETE);
+
+  printf("        incremental: %u calls, longest %lu us\n",
+         n_calls, (unsigned long)max_call_us);
+
+  const unsigned incremental = GetFlatDistance(trace,
+                                               triangle.GetBestSolution());
+  if (incremental != expected) {
+    fprintf(stderr, "Mismatch: incremental flat distance %u != %u\n",
+            incremental, expected);
+    return false;
+  }
+
+  return true;
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "FILE.igc ...");
+
+  Trace trace(0, Trace::null_time, 1024);
+
+  bool success = true;
+  do {
+    const char *path = args.PeekNext();
+    DebugReplay *replay = CreateDebugReplay(args);
+    if (replay == NULL)
+      return EXIT_FAILURE;
+
+    bool released = false;
+    while (replay->Next()) {
+      const MoreData &basic = replay->Basic();
+      if (!basic.time_available || !basic.location_available ||
+          !basic.NavAltitudeAvailable())
+        continue;
+
+      if (!released && !negative(replay->Calculated().flight.release_time)) {
+        released = true;
+        trace.EraseEarlierThan(replay->Calculated().flight.release_time);
+      }
+
+      trace.push_back(TracePoint(basic));
+    }
+
+    delete replay;
+
+    printf("%s: %u points\n", path, trace.size());
+    success &= Run(trace, true);
+    success &= Run(trace, false);
+
+    trace.clear();
+  } while (!args.IsEmpty());
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
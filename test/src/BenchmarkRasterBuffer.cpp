@@ -0,0 +1,138 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compares RasterBuffer::ScanLine() (which interpolates whole lines
+ * at a time) with calling RasterBuffer::GetInterpolated() for each
+ * sample, and verifies that both yield the same values.
+ */
+
+#include "Terrain/RasterBuffer.hpp"
+#include "OS/Clock.hpp"
+#include "Compiler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned WIDTH = 1024, HEIGHT = 1024;
+static constexpr unsigned SIZE = 640;
+static constexpr unsigned ROUNDS = 4096;
+
+static void
+Fill(RasterBuffer &buffer)
+{
+  short *p = buffer.GetData();
+  srand(42);
+  for (unsigned y = 0; y < HEIGHT; ++y) {
+    for (unsigned x = 0; x < WIDTH; ++x) {
+      int h = (int)((x * 7 + y * 3) % 3000) - 200 + rand() % 50;
+      if (rand() % 512 == 0)
+        h = RasterBuffer::TERRAIN_INVALID;
+      else if (rand() % 512 == 0)
+        h = RasterBuffer::TERRAIN_WATER_THRESHOLD;
+      *p++ = (short)h;
+    }
+  }
+}
+
+/**
+ * Determine the vertical coordinates of the line for the given
+ * round.  Every other line is horizontal, the others are slightly
+ * sloped, and all of them are short enough for ScanLine() to
+ * interpolate.
+ */
+static void
+GetLine(unsigned i, unsigned &ay, unsigned &by)
+{
+  ay = (i * 997) % ((HEIGHT - 128) << 8);
+  by = (i & 1) ? ay : ay + (i * 389) % (127 << 8);
+}
+
+/**
+ * Calculate the line the old way, one sample at a time.
+ */
+static void
+ScanLineReference(const RasterBuffer &buffer,
+                  unsigned ax, unsigned ay, unsigned bx, unsigned by,
+                  short *dest, unsigned size)
+{
+  --size;
+  const int dx = bx - ax, dy = by - ay;
+  for (int i = 0; (unsigned)i <= size; ++i) {
+    unsigned cx = ax + (i * dx) / (int)size;
+    unsigned cy = ay + (i * dy) / (int)size;
+
+    *dest++ = buffer.GetInterpolated(cx, cy);
+  }
+}
+
+int
+main(gcc_unused int argc, gcc_unused char **argv)
+{
+  RasterBuffer buffer(WIDTH, HEIGHT);
+  Fill(buffer);
+
+  short expected[SIZE], actual[SIZE];
+  long checksum = 0;
+
+  uint64_t start = MonotonicClockUS();
+  for (unsigned i = 0; i < ROUNDS; ++i) {
+    unsigned ay, by;
+    GetLine(i, ay, by);
+    ScanLineReference(buffer, 1 << 8, ay, (SIZE / 2) << 8, by,
+                      expected, SIZE);
+    checksum += expected[i % SIZE];
+  }
+  const uint64_t reference_us = MonotonicClockUS() - start;
+
+  start = MonotonicClockUS();
+  for (unsigned i = 0; i < ROUNDS; ++i) {
+    unsigned ay, by;
+    GetLine(i, ay, by);
+    buffer.ScanLine(1 << 8, ay, (SIZE / 2) << 8, by, actual, SIZE, true);
+    checksum -= actual[i % SIZE];
+  }
+  const uint64_t scan_line_us = MonotonicClockUS() - start;
+
+  /* verify */
+  for (unsigned i = 0; i < ROUNDS; ++i) {
+    unsigned ay, by;
+    GetLine(i, ay, by);
+    ScanLineReference(buffer, 1 << 8, ay, (SIZE / 2) << 8, by,
+                      expected, SIZE);
+    buffer.ScanLine(1 << 8, ay, (SIZE / 2) << 8, by, actual, SIZE, true);
+
+    for (unsigned j = 0; j < SIZE; ++j) {
+      if (actual[j] != expected[j]) {
+        fprintf(stderr, "Mismatch in line %u, sample %u: %d != %d\n",
+                i, j, actual[j], expected[j]);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  printf("GetInterpolated: %lu us\n", (unsigned long)reference_us);
+  printf("ScanLine:        %lu us\n", (unsigned long)scan_line_us);
+
+  return checksum != 0;
+}
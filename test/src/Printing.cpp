@@ -139,6 +139,8 @@ void PrintHelper::print_route(RoutePlanner& r)
   printf("#   airspace queries %d\n", (int)r.count_airspace);
   printf("#   terrain queries %d\n", (int)r.count_terrain);
   printf("#   supressed %d\n", (int)r.count_supressed);
+  printf("#   expanded nodes %d\n", (int)r.count_expanded);
+  printf("#   stored nodes %d\n", (int)r.count_nodes);
 }
 
 #include "Route/ReachFan.hpp"
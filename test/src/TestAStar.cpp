@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Route/AStar.hpp"
+#include "Geo/Flat/FlatGeoPoint.hpp"
+#include "TestUtil.hpp"
+
+struct HashPoint {
+  unsigned operator()(const FlatGeoPoint &p) const {
+    return (unsigned)p.longitude * 73856093u ^
+      (unsigned)p.latitude * 19349663u;
+  }
+};
+
+struct EqualPoint {
+  bool operator()(const FlatGeoPoint &a, const FlatGeoPoint &b) const {
+    return a == b;
+  }
+};
+
+typedef AStar<FlatGeoPoint, HashPoint, EqualPoint> GridAStar;
+
+static constexpr int GRID_SIZE = 10;
+
+/**
+ * A grid with a wall at x=5, which has a gap only at the top row.
+ */
+static bool
+IsFree(const FlatGeoPoint &p)
+{
+  return p.longitude >= 0 && p.longitude < GRID_SIZE &&
+    p.latitude >= 0 && p.latitude < GRID_SIZE &&
+    (p.longitude != 5 || p.latitude == GRID_SIZE - 1);
+}
+
+/**
+ * Search the grid from (0,0) to (9,0), and return the number of
+ * steps of the path, or -1 if the goal was not found.
+ */
+static int
+SolveGrid(GridAStar &astar)
+{
+  const FlatGeoPoint start(0, 0), goal(GRID_SIZE - 1, 0);
+  astar.Restart(start);
+
+  while (!astar.IsEmpty()) {
+    const FlatGeoPoint node = astar.Pop();
+    if (node == goal) {
+      int steps = 0;
+      for (FlatGeoPoint p = node, q = astar.GetPredecessor(p);
+           !(q == p); p = q, q = astar.GetPredecessor(p))
+        ++steps;
+
+      if (astar.GetNodeValue(goal).g != (unsigned)steps)
+        return -1;
+
+      return steps;
+    }
+
+    static constexpr int dx[] = { 1, -1, 0, 0 };
+    static constexpr int dy[] = { 0, 0, 1, -1 };
+    for (unsigned i = 0; i < 4; ++i) {
+      const FlatGeoPoint next(node.longitude + dx[i], node.latitude + dy[i]);
+      if (IsFree(next))
+        astar.Link(next, node, AStarPriorityValue(1));
+    }
+  }
+
+  return -1;
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(6);
+
+  GridAStar astar;
+
+  /* around the wall: 13 steps to the gap, 2 through it, 12 down */
+  ok1(SolveGrid(astar) == 27);
+  ok1(astar.GetNodeCount() <= GRID_SIZE * GRID_SIZE);
+
+  /* a long chain of nodes is cut off at the limit */
+  astar.Restart(FlatGeoPoint(0, 0));
+  while (!astar.IsEmpty()) {
+    const FlatGeoPoint node = astar.Pop();
+    astar.Link(FlatGeoPoint(node.longitude + 1, 0), node,
+               AStarPriorityValue(1));
+  }
+
+  ok1(astar.GetNodeCount() == ASTAR_MAX_NODES);
+  ok1(astar.GetOverflowCount() == 1);
+
+  /* the search can be restarted after that */
+  ok1(SolveGrid(astar) == 27);
+  ok1(astar.GetOverflowCount() == 0);
+
+  return exit_status();
+}
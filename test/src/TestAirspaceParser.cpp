@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "Airspace/AirspaceParser.hpp"
+#include "Airspace/CompiledAirspaceFile.hpp"
 #include "Engine/Airspace/AbstractAirspace.hpp"
 #include "Engine/Airspace/AirspaceCircle.hpp"
 #include "Engine/Airspace/AirspacePolygon.hpp"
@@ -62,14 +63,8 @@ ParseFile(const TCHAR *path, Airspaces &airspaces)
 }
 
 static void
-TestOpenAir()
+CheckOpenAir(const Airspaces &airspaces)
 {
-  Airspaces airspaces;
-  if (!ParseFile(_T("test/data/airspace/openair.txt"), airspaces)) {
-    skip(3, 0, "Failed to parse input file");
-    return;
-  }
-
   const AirspaceClassTestCouple classes[] = {
     { _T("Class-R-Test"), RESTRICT },
     { _T("Class-Q-Test"), DANGER },
@@ -167,6 +162,48 @@ TestOpenAir()
   }
 }
 
+static void
+TestOpenAir()
+{
+  Airspaces airspaces;
+  if (!ParseFile(_T("test/data/airspace/openair.txt"), airspaces)) {
+    skip(3, 0, "Failed to parse input file");
+    return;
+  }
+
+  CheckOpenAir(airspaces);
+}
+
+static void
+TestCompiled()
+{
+  Airspaces parsed;
+  if (!ParseFile(_T("test/data/airspace/openair.txt"), parsed)) {
+    skip(1, 0, "Failed to parse input file");
+    return;
+  }
+
+  const TCHAR *path = _T("output/TestCompiledAirspaces.bin");
+  const TCHAR *source_path = _T("test/data/airspace/openair.txt");
+
+  FILE *file = _tfopen(path, _T("wb"));
+  if (!ok1(file != NULL)) {
+    skip(1, 0, "Failed to create the compiled airspace file");
+    return;
+  }
+
+  ok1(SaveCompiledAirspaces(file, source_path, parsed));
+  fclose(file);
+
+  Airspaces airspaces;
+  CompiledAirspacesLoader loader(airspaces);
+  if (!ok1(CompiledFile::Load(path, 0, source_path, loader)))
+    return;
+
+  airspaces.Optimise();
+  CheckOpenAir(airspaces);
+}
+
 static void
 TestTNP()
 {
@@ -276,10 +313,11 @@ TestTNP()
 
 int main(int argc, char **argv)
 {
-  plan_tests(103);
+  plan_tests(157);
 
   TestOpenAir();
   TestTNP();
+  TestCompiled();
 
   return exit_status();
 }
@@ -97,13 +97,33 @@ Test2()
   ok1(!line.ReadChecked(temp_int) && temp_int == 42);
 }
 
+static void
+Test3()
+{
+  const char *input = "$GPRMC,,abc,ab";
+  CSVLine line(input);
+
+  // Test read_view()
+  const auto column = line.ReadView();
+  ok1(column.begin() == input && column.end() == input + 6);
+
+  ok1(line.ReadView().empty());
+
+  // Test read_compare() with a prefix and a longer value
+  ok1(!line.ReadCompare("ab"));
+  ok1(!line.ReadCompare("abc"));
+
+  ok1(line.ReadView().empty());
+}
+
 int
 main(int argc, char **argv)
 {
-  plan_tests(19);
+  plan_tests(24);
 
   Test1();
   Test2();
+  Test3();
 
   return exit_status();
 }
@@ -0,0 +1,160 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IO/CompiledFile.hpp"
+#include "IO/MemoryReader.hpp"
+#include "TestUtil.hpp"
+
+#include <stdint.h>
+
+static const TCHAR *const path = _T("output/TestCompiledFile.bin");
+static const TCHAR *const source_path = _T("test/data/source.txt");
+
+/**
+ * Reads a payload of uint32_t values.
+ */
+class TestLoader final : public CompiledFile::Loader {
+  unsigned pending;
+
+public:
+  unsigned sum;
+  bool committed;
+
+  TestLoader():sum(0), committed(false) {}
+
+  virtual bool Read(MemoryReader &reader, unsigned n_records) override {
+    pending = 0;
+    for (unsigned i = 0; i < n_records; ++i) {
+      uint32_t value;
+      if (!reader.Read(value))
+        return false;
+
+      pending += value;
+    }
+
+    return true;
+  }
+
+  virtual void Commit() override {
+    sum = pending;
+    committed = true;
+  }
+};
+
+/**
+ * Write a compiled file with the given number of records in the
+ * header, followed by the values 1..n_values.
+ */
+static bool
+WriteFile(unsigned n_records, unsigned n_values)
+{
+  FILE *file = _tfopen(path, _T("wb"));
+  if (file == NULL)
+    return false;
+
+  bool success = CompiledFile::WriteHeader(file, source_path, n_records);
+  for (uint32_t i = 1; i <= n_values; ++i)
+    success = success && fwrite(&i, sizeof(i), 1, file) == 1;
+
+  fclose(file);
+  return success;
+}
+
+static void
+TestValid()
+{
+  if (!ok1(WriteFile(3, 3))) {
+    skip(3, 0, "Failed to create the compiled file");
+    return;
+  }
+
+  TestLoader loader;
+  ok1(CompiledFile::Load(path, 0, source_path, loader));
+  ok1(loader.committed);
+  ok1(loader.sum == 6);
+}
+
+static void
+TestWrongSource()
+{
+  if (!ok1(WriteFile(3, 3))) {
+    skip(2, 0, "Failed to create the compiled file");
+    return;
+  }
+
+  TestLoader loader;
+  ok1(!CompiledFile::Load(path, 0, _T("test/data/other.txt"), loader));
+  ok1(!loader.committed);
+}
+
+static void
+TestBadOffset()
+{
+  if (!ok1(WriteFile(3, 3))) {
+    skip(2, 0, "Failed to create the compiled file");
+    return;
+  }
+
+  TestLoader loader;
+  ok1(!CompiledFile::Load(path, 4096, source_path, loader));
+  ok1(!loader.committed);
+}
+
+static void
+TestTruncated()
+{
+  if (!ok1(WriteFile(3, 2))) {
+    skip(2, 0, "Failed to create the compiled file");
+    return;
+  }
+
+  TestLoader loader;
+  ok1(!CompiledFile::Load(path, 0, source_path, loader));
+  ok1(!loader.committed);
+}
+
+static void
+TestTrailingData()
+{
+  if (!ok1(WriteFile(2, 3))) {
+    skip(2, 0, "Failed to create the compiled file");
+    return;
+  }
+
+  TestLoader loader;
+  ok1(!CompiledFile::Load(path, 0, source_path, loader));
+  ok1(!loader.committed);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(16);
+
+  TestValid();
+  TestWrongSource();
+  TestBadOffset();
+  TestTruncated();
+  TestTrailingData();
+
+  return exit_status();
+}
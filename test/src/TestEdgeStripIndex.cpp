@@ -0,0 +1,176 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/EdgeStripIndex.hpp"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <vector>
+
+/**
+ * A zig-zag polyline with edges of varying length.
+ */
+static std::vector<fixed>
+MakeVertices(unsigned n)
+{
+  std::vector<fixed> vertices;
+  vertices.reserve(n);
+  unsigned seed = 1;
+  for (unsigned i = 0; i < n; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    vertices.push_back(fixed((int)((seed >> 16) % 2000) - 1000) / 10);
+  }
+
+  return vertices;
+}
+
+static bool
+IsSortedUnique(const unsigned *begin, const unsigned *end)
+{
+  return std::adjacent_find(begin, end,
+                            [](unsigned a, unsigned b) {
+                              return a >= b;
+                            }) == end;
+}
+
+/**
+ * Does the result of Find() contain all edges whose range includes
+ * the value?
+ */
+static bool
+CheckFind(const EdgeStripIndex &index, const std::vector<fixed> &vertices,
+          fixed value)
+{
+  const EdgeStripIndex::Range r = index.Find(value);
+  if (!IsSortedUnique(r.first, r.second))
+    return false;
+
+  for (unsigned i = 0; i + 1 < vertices.size(); ++i) {
+    const fixed a = std::min(vertices[i], vertices[i + 1]);
+    const fixed b = std::max(vertices[i], vertices[i + 1]);
+    if (value >= a && value <= b &&
+        !std::binary_search(r.first, r.second, i))
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * Does the result of Find() contain all edges whose range overlaps
+ * the given range?
+ */
+static bool
+CheckFind(const EdgeStripIndex &index, const std::vector<fixed> &vertices,
+          fixed range_min, fixed range_max)
+{
+  std::vector<unsigned> edges;
+  index.Find(range_min, range_max, edges);
+  if (!IsSortedUnique(edges.data(), edges.data() + edges.size()))
+    return false;
+
+  for (unsigned i = 0; i + 1 < vertices.size(); ++i) {
+    const fixed a = std::min(vertices[i], vertices[i + 1]);
+    const fixed b = std::max(vertices[i], vertices[i + 1]);
+    if (b >= range_min && a <= range_max &&
+        !std::binary_search(edges.begin(), edges.end(), i))
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestPolyline(unsigned n, unsigned edges_per_strip)
+{
+  const std::vector<fixed> vertices = MakeVertices(n);
+
+  EdgeStripIndex index;
+  ok1(!index.IsDefined());
+
+  index.Build(vertices, edges_per_strip);
+  ok1(index.IsDefined());
+
+  bool found = true;
+  for (int v = -1050; v <= 1050; v += 7)
+    if (!CheckFind(index, vertices, fixed(v) / 10))
+      found = false;
+
+  /* the vertices themselves are on the strip borders */
+  for (const fixed v : vertices)
+    if (!CheckFind(index, vertices, v))
+      found = false;
+
+  ok1(found);
+
+  found = true;
+  for (int v = -1100; v <= 1000; v += 37)
+    for (int length : {0, 5, 100, 700})
+      if (!CheckFind(index, vertices, fixed(v) / 10,
+                     fixed(v + length) / 10))
+        found = false;
+
+  ok1(found);
+
+  /* outside of the polyline */
+  const EdgeStripIndex::Range r = index.Find(fixed(200));
+  ok1(r.first == r.second);
+
+  std::vector<unsigned> edges;
+  index.Find(fixed(-300), fixed(-200), edges);
+  ok1(edges.empty());
+
+  index.Clear();
+  ok1(!index.IsDefined());
+}
+
+static void
+TestFlat()
+{
+  /* all vertices at the same value: one strip with all edges */
+  const std::vector<fixed> vertices(5, fixed(3));
+
+  EdgeStripIndex index;
+  index.Build(vertices);
+
+  const EdgeStripIndex::Range r = index.Find(fixed(3));
+  ok1(r.second - r.first == 4);
+
+  std::vector<unsigned> edges;
+  index.Find(fixed(0), fixed(10), edges);
+  ok1(edges.size() == 4);
+
+  ok1(index.Find(fixed(4)).first == index.Find(fixed(4)).second);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(3 * 7 + 3);
+
+  TestPolyline(2, 8);
+  TestPolyline(33, 8);
+  TestPolyline(500, 4);
+  TestFlat();
+
+  return exit_status();
+}
@@ -28,7 +28,7 @@
 
 int main(int argc, char **argv)
 {
-  plan_tests(15);
+  plan_tests(23);
 
   FlarmNetDatabase db;
   int count = FlarmNetReader::LoadFile(_T("test/data/flarmnet/data.fln"), db);
@@ -76,5 +76,29 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  /* the result is limited by the buffer size */
+  ok1(db.FindIdsByCallSign(_T("TH"), ids, 1) == 1);
+  ok1(ids[0] == id);
+
+  ok1(db.FindIdsByCallSign(_T("T"), ids, 3) == 0);
+  ok1(db.FindRecordById(FlarmId::Parse("DDA85B", NULL)) == NULL);
+
+  record = db.FindFirstRecordByCallSign(_T("TH"));
+  ok1(record != NULL && _tcscmp(record->id, _T("DDA85C")) == 0);
+
+  record = db.FindFirstRecordByCallSign(_T("1A"));
+  ok1(record != NULL && _tcscmp(record->id, _T("DDA86A")) == 0);
+  ok1(db.FindFirstRecordByCallSign(_T("ZZ")) == NULL);
+
+  /* records are iterated in id order */
+  bool sorted = true;
+  const FlarmNetRecord *previous = NULL;
+  for (const FlarmNetRecord &i : db) {
+    if (previous != NULL && !(previous->GetId() < i.GetId()))
+      sorted = false;
+    previous = &i;
+  }
+  ok1(sorted);
+
   return exit_status();
 }
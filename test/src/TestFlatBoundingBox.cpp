@@ -0,0 +1,67 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Geo/Flat/FlatBoundingBox.hpp"
+#include "TestUtil.hpp"
+
+static void
+TestDistance()
+{
+  const FlatBoundingBox a(FlatGeoPoint(0, 0), FlatGeoPoint(10, 10));
+
+  // overlapping and touching boxes
+  ok1(a.Distance(a) == 0);
+  ok1(a.Distance(FlatBoundingBox(FlatGeoPoint(5, 5),
+                                 FlatGeoPoint(20, 20))) == 0);
+  ok1(a.Distance(FlatBoundingBox(FlatGeoPoint(10, 0),
+                                 FlatGeoPoint(20, 10))) == 0);
+
+  // disjoint along one axis
+  const FlatBoundingBox east(FlatGeoPoint(20, 0), FlatGeoPoint(30, 10));
+  ok1(a.Distance(east) == 10);
+  ok1(east.Distance(a) == 10);
+
+  const FlatBoundingBox north(FlatGeoPoint(5, 25), FlatGeoPoint(8, 30));
+  ok1(a.Distance(north) == 15);
+  ok1(north.Distance(a) == 15);
+
+  // disjoint along both axes
+  const FlatBoundingBox north_east(FlatGeoPoint(40, 50),
+                                   FlatGeoPoint(45, 55));
+  ok1(a.Distance(north_east) == 50);
+  ok1(north_east.Distance(a) == 50);
+
+  const FlatBoundingBox south_west(FlatGeoPoint(-13, -14),
+                                   FlatGeoPoint(-10, -10));
+  ok1(a.Distance(south_west) == 14);
+  ok1(south_west.Distance(a) == 14);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(11);
+
+  TestDistance();
+
+  return exit_status();
+}
@@ -39,6 +39,7 @@ private:
   void TestBallast();
   void TestBugs();
   void TestMC();
+  void TestSpeedToFly();
 };
 
 void
@@ -163,6 +164,41 @@ GlidePolarTest::TestMC()
   ok1(equals(polar.GetVBestLD(), 25.830434162));
 }
 
+/**
+ * Find the airspeed which minimises the sink over ground by scanning
+ * the whole speed range.
+ */
+static fixed
+ScanSpeedToFly(const GlidePolar &polar, fixed sink_offset, fixed head_wind)
+{
+  fixed best_v = polar.GetVMin(), best_f = fixed(1000000);
+  for (fixed v = polar.GetVMin(); v <= polar.GetVMax(); v += fixed(0.001)) {
+    const fixed f = (polar.SinkRate(v) + sink_offset) / (v - head_wind);
+    if (f < best_f) {
+      best_f = f;
+      best_v = v;
+    }
+  }
+
+  return best_v;
+}
+
+void
+GlidePolarTest::TestSpeedToFly()
+{
+  ok1(equals(polar.GetSpeedToFly(fixed(0), fixed(0)), polar.GetVBestLD()));
+
+  for (unsigned i = 0; i < 3; ++i) {
+    const fixed sink_offset(i);
+    for (int head_wind = -10; head_wind <= 10; head_wind += 10) {
+      const fixed v = polar.GetSpeedToFly(sink_offset, fixed(head_wind));
+      const fixed expected = ScanSpeedToFly(polar, sink_offset,
+                                            fixed(head_wind));
+      ok1(fabs(v - expected) < fixed(0.01));
+    }
+  }
+}
+
 void
 GlidePolarTest::Run()
 {
@@ -171,11 +207,12 @@ GlidePolarTest::Run()
   TestBallast();
   TestBugs();
   TestMC();
+  TestSpeedToFly();
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(46);
+  plan_tests(56);
 
   GlidePolarTest test;
   test.Run();
@@ -0,0 +1,133 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Util/StringPool.hpp"
+#include "Util/InternedString.hpp"
+#include "Util/StringUtil.hpp"
+#include "TestUtil.hpp"
+
+#include <vector>
+
+#include <stdio.h>
+
+static void
+TestIntern()
+{
+  StringPool pool;
+
+  const TCHAR *a = pool.Intern(_T("Bergneustadt"));
+  ok1(StringIsEqual(a, _T("Bergneustadt")));
+  ok1(pool.Intern(_T("Bergneustadt")) == a);
+  ok1(pool.Intern(_T("Bergneustadt [A]"), 12) == a);
+  ok1(pool.Intern(_T("Bergneu"), 7) != a);
+  ok1(StringIsEqual(pool.Intern(_T("Bergneustadt"), 7), _T("Bergneu")));
+  ok1(pool.GetCount() == 2);
+
+  const TCHAR *empty = pool.Intern(_T(""));
+  ok1(StringIsEmpty(empty));
+  ok1(pool.Intern(_T("abc"), 0) == empty);
+}
+
+static void
+TestStable()
+{
+  StringPool pool;
+
+  /* fill several chunks and make the hash table grow; previously
+     returned strings must not move */
+  std::vector<const TCHAR *> values;
+  for (unsigned i = 0; i < 10000; ++i) {
+    TCHAR buffer[32];
+    _stprintf(buffer, _T("waypoint %u"), i);
+    values.push_back(pool.Intern(buffer));
+  }
+
+  ok1(pool.GetCount() == 10000);
+  ok1(pool.GetMemoryUsage() > 0);
+
+  bool all_equal = true, all_same = true;
+  for (unsigned i = 0; i < 10000; ++i) {
+    TCHAR buffer[32];
+    _stprintf(buffer, _T("waypoint %u"), i);
+    all_equal &= StringIsEqual(values[i], buffer);
+    all_same &= pool.Intern(buffer) == values[i];
+  }
+
+  ok1(all_equal);
+  ok1(all_same);
+  ok1(pool.GetCount() == 10000);
+
+  /* a string which does not fit into a chunk */
+  const tstring long_string(100000, _T('x'));
+  const TCHAR *a = pool.Intern(long_string.c_str());
+  ok1(long_string == a);
+  ok1(pool.Intern(long_string.c_str()) == a);
+
+  /* the current chunk is still used after the long string */
+  const TCHAR *b = pool.Intern(_T("after"));
+  ok1(StringIsEqual(b, _T("after")));
+  ok1(StringIsEqual(values.back(), _T("waypoint 9999")));
+}
+
+static void
+TestInternedString()
+{
+  InternedString a;
+  ok1(a.empty());
+  ok1(a.length() == 0);
+  ok1(a == _T(""));
+
+  InternedString b(_T("Aconcagua"));
+  ok1(!b.empty());
+  ok1(b.length() == 9);
+  ok1(b == _T("Aconcagua"));
+  ok1(b != a);
+
+  InternedString c(tstring(_T("Aconcagua")));
+  ok1(c == b);
+  ok1(c.c_str() == b.c_str());
+
+  c = _T("Red Square");
+  ok1(c != b);
+  ok1(StringIsEqual(b.c_str(), _T("Aconcagua")));
+
+  c.assign(_T("Aconcagua summit"), 9);
+  ok1(c == b);
+
+  c.clear();
+  ok1(c.empty());
+  ok1(c == a);
+  ok1(c == InternedString(_T("")));
+  ok1(b.ToString() == _T("Aconcagua"));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(33);
+
+  TestIntern();
+  TestStable();
+  TestInternedString();
+
+  return exit_status();
+}
@@ -0,0 +1,95 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Terrain/RasterTileCache.hpp"
+#include "Terrain/RasterLocation.hpp"
+#include "TestUtil.hpp"
+
+#include <memory>
+
+/**
+ * A terrain without tiles: the overview is flat at 0 m, with a
+ * 200 m ridge across the middle.
+ */
+class SyntheticTerrain : public RasterTileCache {
+public:
+  static constexpr unsigned SIZE = 1024;
+  static constexpr short RIDGE = 200;
+
+  SyntheticTerrain() {
+    SetSize(SIZE, SIZE, SIZE, SIZE, 1, 1);
+
+    /* the ridge covers the pixels 448 to 575 */
+    const unsigned overview_size = overview.GetWidth();
+    short *p = GetOverview();
+    for (unsigned y = 0; y < overview_size; ++y)
+      for (unsigned x = 0; x < overview_size; ++x)
+        *p++ = x >= overview_size * 7 / 16 && x < overview_size * 9 / 16
+          ? RIDGE : 0;
+
+    BuildOverviewPyramid();
+    SetInitialised(true);
+  }
+};
+
+/**
+ * Check a line across the ridge, which rises by 1 m per pixel from
+ * 100 m.  Returns true if an intersection was found.
+ */
+static bool
+CrossRidge(const RasterTileCache &terrain, int h_dest, bool can_climb)
+{
+  RasterLocation location;
+  int h;
+  return terrain.FirstIntersection(100, 512, 900, 512, 100, h_dest,
+                                   1 << RASTER_SLOPE_FACT, 10000, 0,
+                                   location, h, can_climb);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(6);
+
+  std::unique_ptr<SyntheticTerrain> terrain(new SyntheticTerrain());
+
+  /* the rising line passes the ridge at more than 400 m */
+  ok1(!CrossRidge(*terrain, 100, false));
+  ok1(!CrossRidge(*terrain, 1000, true));
+
+  /* climbing only up to the destination height: capped at 300 m,
+     the line still clears the ridge */
+  ok1(!CrossRidge(*terrain, 300, true));
+
+  /* capped at 150 m or at the origin height, it doesn't; the capped
+     heights must not be proven clear with the uncapped line */
+  ok1(CrossRidge(*terrain, 150, true));
+  ok1(CrossRidge(*terrain, 50, true));
+
+  /* a level line below the ridge */
+  RasterLocation location;
+  int h;
+  ok1(terrain->FirstIntersection(100, 512, 900, 512, 100, 100, 0, 10000, 0,
+                                 location, h, false));
+
+  return exit_status();
+}
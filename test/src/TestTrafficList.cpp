@@ -0,0 +1,230 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARM/List.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static FlarmId
+MakeId(unsigned i)
+{
+  char buffer[16];
+  sprintf(buffer, "%X", 0x100 + i * 0x100);
+  return FlarmId::Parse(buffer, NULL);
+}
+
+static FlarmTraffic *
+AddTraffic(TrafficList &list, unsigned i, fixed clock)
+{
+  FlarmTraffic *traffic = list.AllocateTraffic(MakeId(i));
+  if (traffic != NULL) {
+    traffic->valid.Update(clock);
+    traffic->alarm_level = FlarmTraffic::AlarmType::NONE;
+    traffic->distance = fixed(i * 100);
+  }
+
+  return traffic;
+}
+
+static bool
+CheckAll(const TrafficList &list, unsigned first, unsigned step)
+{
+  for (unsigned i = first; i < TrafficList::MAX_COUNT; i += step) {
+    const FlarmTraffic *traffic = list.FindTraffic(MakeId(i));
+    if (traffic == NULL || !(traffic->id == MakeId(i)))
+      return false;
+  }
+
+  return true;
+}
+
+static void
+TestAllocate()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; ++i)
+    AddTraffic(list, i, fixed(0));
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(list.AllocateTraffic(MakeId(TrafficList::MAX_COUNT)) == NULL);
+  ok1(CheckAll(list, 0, 1));
+  ok1(list.FindTraffic(MakeId(TrafficList::MAX_COUNT)) == NULL);
+
+  /* refresh every other target and let the rest expire */
+  for (unsigned i = 0; i < TrafficList::MAX_COUNT; i += 2)
+    list.FindTraffic(MakeId(i))->valid.Update(fixed(10));
+
+  list.Expire(fixed(11));
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT / 2);
+  ok1(CheckAll(list, 0, 2));
+
+  bool found = false;
+  for (unsigned i = 1; i < TrafficList::MAX_COUNT; i += 2)
+    if (list.FindTraffic(MakeId(i)) != NULL)
+      found = true;
+  ok1(!found);
+
+  /* the free slots can be allocated again */
+  for (unsigned i = 1; i < TrafficList::MAX_COUNT; i += 2)
+    AddTraffic(list, i, fixed(11));
+
+  ok1(list.GetActiveTrafficCount() == TrafficList::MAX_COUNT);
+  ok1(CheckAll(list, 0, 1));
+
+  list.Clear();
+  ok1(list.IsEmpty());
+  ok1(list.FindTraffic(MakeId(0)) == NULL);
+}
+
+static void
+TestIndex()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (unsigned i = 0; i < 100; ++i)
+    AddTraffic(list, i, fixed(0));
+
+  list.FindTraffic(MakeId(70))->alarm_level = FlarmTraffic::AlarmType::LOW;
+  list.FindTraffic(MakeId(20))->alarm_level = FlarmTraffic::AlarmType::LOW;
+  list.FindTraffic(MakeId(90))->alarm_level = FlarmTraffic::AlarmType::IMPORTANT;
+
+  /* without index, everything is visited */
+  unsigned n = 0;
+  list.VisitWithin(fixed(500), [&n](const FlarmTraffic &, unsigned) {
+      ++n;
+    });
+  ok1(n == 100);
+
+  list.UpdateIndex();
+
+  /* traffic up to 500m, plus the rest of the first ring */
+  n = 0;
+  bool inside = true, positions = true;
+  list.VisitWithin(fixed(500),
+                   [&n, &inside, &positions, &list](const FlarmTraffic &traffic,
+                                                    unsigned i) {
+      ++n;
+      if (traffic.distance >= fixed(TrafficList::RING_WIDTH))
+        inside = false;
+      if (&list.list[i] != &traffic)
+        positions = false;
+    });
+  ok1(n == 10);
+  ok1(inside);
+  ok1(positions);
+
+  n = 0;
+  list.VisitWithin(fixed(100000), [&n](const FlarmTraffic &, unsigned) {
+      ++n;
+    });
+  ok1(n == 100);
+
+  /* the alarms are visited by distance */
+  fixed last(-1);
+  bool sorted = true;
+  n = 0;
+  list.VisitAlarms([&n, &last, &sorted](const FlarmTraffic &traffic,
+                                        unsigned) {
+      ++n;
+      if (fixed(traffic.distance) < last)
+        sorted = false;
+      last = traffic.distance;
+    });
+  ok1(n == 3);
+  ok1(sorted);
+
+  const FlarmTraffic *alert = list.FindMaximumAlert();
+  ok1(alert != NULL && alert->id == MakeId(90));
+
+  list.FindTraffic(MakeId(90))->alarm_level = FlarmTraffic::AlarmType::NONE;
+  alert = list.FindMaximumAlert();
+  ok1(alert != NULL && alert->id == MakeId(20));
+}
+
+static void
+TestCopy()
+{
+  TrafficList list;
+  list.Clear();
+
+  for (unsigned i = 0; i < 100; ++i)
+    AddTraffic(list, i, fixed(0));
+
+  list.FindTraffic(MakeId(20))->alarm_level = FlarmTraffic::AlarmType::LOW;
+  list.UpdateIndex();
+
+  /* overwrite a list which has more items than the source */
+  TrafficList copy;
+  copy.Clear();
+  for (unsigned i = 0; i < 200; ++i)
+    AddTraffic(copy, 1000 + i, fixed(0));
+
+  copy = list;
+  ok1(copy.GetActiveTrafficCount() == 100);
+
+  /* look up through a const reference, which keeps the index */
+  const TrafficList &const_copy = copy;
+  bool found = true;
+  for (unsigned i = 0; i < 100; ++i) {
+    const FlarmTraffic *traffic = const_copy.FindTraffic(MakeId(i));
+    if (traffic == NULL || !(traffic->id == MakeId(i)))
+      found = false;
+  }
+
+  ok1(found);
+  ok1(const_copy.FindTraffic(MakeId(1000)) == NULL);
+
+  /* the distance index is copied, too */
+  unsigned n = 0;
+  copy.VisitWithin(fixed(500), [&n](const FlarmTraffic &, unsigned) {
+      ++n;
+    });
+  ok1(n == 10);
+
+  const FlarmTraffic *alert = copy.FindMaximumAlert();
+  ok1(alert != NULL && alert->id == MakeId(20));
+
+  /* a stale index stays stale */
+  list.FindTraffic(MakeId(30));
+  const TrafficList copy2(list);
+  n = 0;
+  copy2.VisitWithin(fixed(500), [&n](const FlarmTraffic &, unsigned) {
+      ++n;
+    });
+  ok1(n == 100);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(26);
+
+  TestAllocate();
+  TestIndex();
+  TestCopy();
+
+  return exit_status();
+}
@@ -0,0 +1,68 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2013 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/TripleBuffer.hpp"
+#include "TestUtil.hpp"
+
+int main(int argc, char **argv)
+{
+  plan_tests(14);
+
+  TripleBuffer<int> buffer;
+
+  /* nothing has been published yet */
+  ok1(!buffer.Fetch());
+
+  buffer.GetBack() = 1;
+  ok1(buffer.Publish());
+  ok1(buffer.Fetch());
+  ok1(buffer.GetFront() == 1);
+
+  /* the value can be fetched only once */
+  ok1(!buffer.Fetch());
+  ok1(buffer.GetFront() == 1);
+
+  /* a newer value replaces the one which was not fetched */
+  buffer.GetBack() = 2;
+  ok1(buffer.Publish());
+  buffer.GetBack() = 3;
+  ok1(!buffer.Publish());
+  ok1(buffer.Fetch());
+  ok1(buffer.GetFront() == 3);
+
+  /* the producer never gets the buffer held by the consumer */
+  buffer.GetBack() = 4;
+  ok1(buffer.GetFront() == 3);
+
+  /* discarded values are not fetched */
+  buffer.Publish();
+  buffer.Discard();
+  ok1(!buffer.Fetch());
+  ok1(buffer.GetFront() == 3);
+
+  buffer.GetBack() = 5;
+  buffer.Publish();
+  ok1(buffer.Fetch() && buffer.GetFront() == 5);
+
+  return exit_status();
+}
@@ -22,6 +22,7 @@
 
 #include "Waypoint/WaypointReader.hpp"
 #include "Waypoint/WaypointReaderBase.hpp"
+#include "Waypoint/CompiledWaypointFile.hpp"
 #include "Engine/Waypoint/Waypoints.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "Units/System.hpp"
@@ -203,7 +204,7 @@ TestWaypointFile(const TCHAR* filename, Waypoints &way_points, unsigned num_wps)
 static const Waypoint*
 GetWaypoint(const Waypoint org_wp, const Waypoints &way_points)
 {
-  const Waypoint *wp = way_points.LookupName(org_wp.name);
+  const Waypoint *wp = way_points.LookupName(org_wp.name.c_str());
   if (!ok1(wp != NULL)) {
     skip(2, 0, "waypoint not found");
     return NULL;
@@ -319,9 +320,11 @@ TestZander(wp_vector org_wp)
 
   wp_vector::iterator it;
   for (it = org_wp.begin(); it < org_wp.end(); it++) {
-    if (it->name.length() > 12)
-      it->name = it->name.erase(12);
-    trim_inplace(it->name);
+    tstring name = it->name.ToString();
+    if (name.length() > 12)
+      name.erase(12);
+    trim_inplace(name);
+    it->name = name;
     const Waypoint *wp = GetWaypoint(*it, way_points);
     TestZanderWaypoint(*it, wp);
   }
@@ -339,9 +342,11 @@ TestFS(wp_vector org_wp)
 
   wp_vector::iterator it;
   for (it = org_wp.begin(); it < org_wp.end(); it++) {
-    if (it->name.length() > 8)
-      it->name = it->name.erase(8);
-    trim_inplace(it->name);
+    tstring name = it->name.ToString();
+    if (name.length() > 8)
+      name.erase(8);
+    trim_inplace(name);
+    it->name = name;
     GetWaypoint(*it, way_points);
   }
 }
@@ -358,9 +363,11 @@ TestFS_UTM(wp_vector org_wp)
 
   wp_vector::iterator it;
   for (it = org_wp.begin(); it < org_wp.end(); it++) {
-    if (it->name.length() > 8)
-      it->name = it->name.erase(8);
-    trim_inplace(it->name);
+    tstring name = it->name.ToString();
+    if (name.length() > 8)
+      name.erase(8);
+    trim_inplace(name);
+    it->name = name;
     GetWaypoint(*it, way_points);
   }
 }
@@ -377,7 +384,9 @@ TestOzi(wp_vector org_wp)
 
   wp_vector::iterator it;
   for (it = org_wp.begin(); it < org_wp.end(); it++) {
-    trim_inplace(it->name);
+    tstring name = it->name.ToString();
+    trim_inplace(name);
+    it->name = name;
     GetWaypoint(*it, way_points);
   }
 }
@@ -394,14 +403,16 @@ TestCompeGPS(wp_vector org_wp)
 
   wp_vector::iterator it;
   for (it = org_wp.begin(); it < org_wp.end(); it++) {
+    tstring name = it->name.ToString();
     size_t pos;
-    while ((pos = it->name.find_first_of(_T(' '))) != tstring::npos)
-      it->name.erase(pos, 1);
+    while ((pos = name.find_first_of(_T(' '))) != tstring::npos)
+      name.erase(pos, 1);
 
-    if (it->name.length() > 6)
-      it->name = it->name.erase(6);
+    if (name.length() > 6)
+      name.erase(6);
 
-    trim_inplace(it->name);
+    trim_inplace(name);
+    it->name = name;
     const Waypoint *wp = GetWaypoint(*it, way_points);
     ok1(wp->comment == it->comment);
   }
@@ -419,19 +430,60 @@ TestCompeGPS_UTM(wp_vector org_wp)
 
   wp_vector::iterator it;
   for (it = org_wp.begin(); it < org_wp.end(); it++) {
+    tstring name = it->name.ToString();
     size_t pos;
-    while ((pos = it->name.find_first_of(_T(' '))) != tstring::npos)
-      it->name.erase(pos, 1);
+    while ((pos = name.find_first_of(_T(' '))) != tstring::npos)
+      name.erase(pos, 1);
 
-    if (it->name.length() > 6)
-      it->name = it->name.erase(6);
+    if (name.length() > 6)
+      name.erase(6);
 
-    trim_inplace(it->name);
+    trim_inplace(name);
+    it->name = name;
     const Waypoint *wp = GetWaypoint(*it, way_points);
     ok1(wp->comment == it->comment);
   }
 }
 
+static void
+TestCompiled(wp_vector org_wp)
+{
+  const TCHAR *source_path = _T("test/data/waypoints.cup");
+
+  Waypoints parsed;
+  if (!TestWaypointFile(source_path, parsed, org_wp.size())) {
+    skip(3 + 10 * org_wp.size(), 0, "opening waypoint file failed");
+    return;
+  }
+
+  const TCHAR *path = _T("output/TestCompiledWaypoints.bin");
+
+  FILE *file = _tfopen(path, _T("wb"));
+  if (!ok1(file != NULL)) {
+    skip(2 + 10 * org_wp.size(), 0,
+         "Failed to create the compiled waypoint file");
+    return;
+  }
+
+  ok1(SaveCompiledWaypoints(file, source_path, parsed));
+  fclose(file);
+
+  Waypoints way_points;
+  CompiledWaypointsLoader loader(way_points);
+  if (!ok1(CompiledFile::Load(path, 0, source_path, loader))) {
+    skip(10 * org_wp.size(), 0, "loading compiled waypoint file failed");
+    return;
+  }
+
+  way_points.Optimise();
+
+  wp_vector::iterator it;
+  for (it = org_wp.begin(); it < org_wp.end(); it++) {
+    const Waypoint *wp = GetWaypoint(*it, way_points);
+    TestSeeYouWaypoint(*it, wp);
+  }
+}
+
 static wp_vector
 CreateOriginalWaypoints()
 {
@@ -529,7 +581,7 @@ int main(int argc, char **argv)
 {
   wp_vector org_wp = CreateOriginalWaypoints();
 
-  plan_tests(315);
+  plan_tests(372);
 
   TestExtractParameters();
 
@@ -541,6 +593,7 @@ int main(int argc, char **argv)
   TestOzi(org_wp);
   TestCompeGPS(org_wp);
   TestCompeGPS_UTM(org_wp);
+  TestCompiled(org_wp);
 
   return exit_status();
 }
@@ -283,7 +283,7 @@ TestReplace(Waypoints& waypoints, unsigned id)
   if (wp == NULL)
     return false;
 
-  tstring oldName = wp->name;
+  const InternedString old_name = wp->name;
 
   Waypoint copy = *wp;
   copy.name = _T("Fred");
@@ -291,7 +291,7 @@ TestReplace(Waypoints& waypoints, unsigned id)
   waypoints.Optimise();
 
   wp = waypoints.LookupId(id);
-  return wp != NULL && wp->name != oldName && wp->name == _T("Fred");
+  return wp != NULL && wp->name != old_name && wp->name == _T("Fred");
 }
 
 int
@@ -28,15 +28,23 @@ class ZeroFinderTest: public ZeroFinder
   unsigned func;
 
 public:
+  /** shifts the function to the right */
+  fixed shift;
+
   ZeroFinderTest(fixed x_min, fixed x_max, unsigned _func = 0) :
-    ZeroFinder(x_min, x_max, fixed(0.0001)), func(_func) {}
+    ZeroFinder(x_min, x_max, fixed(0.0001)), func(_func), shift(fixed(0)) {}
+
+  fixed f(fixed x);
 
-  fixed f(const fixed x);
+  using ZeroFinder::find_zero_tentative;
+  using ZeroFinder::commit_hint;
 };
 
 fixed
-ZeroFinderTest::f(const fixed x)
+ZeroFinderTest::f(fixed x)
 {
+  x -= shift;
+
   if (func == 0)
     return fixed(2) * x * x - fixed(3) * x - fixed(5);
 
@@ -51,9 +59,68 @@ ZeroFinderTest::f(const fixed x)
   return fixed(0);
 }
 
+/**
+ * Solve a slowly moving function repeatedly, like the task solvers
+ * do, with and without a hint.  The results must be the same, but
+ * the hint must save evaluations.
+ */
+static void
+TestHint(unsigned func, fixed x_min, fixed x_max)
+{
+  ZeroFinder::Hint hint;
+  unsigned n_plain = 0, n_hint = 0;
+  bool equal = true;
+
+  for (unsigned i = 0; i < 50; ++i) {
+    const fixed shift = fixed(i) / 100;
+
+    ZeroFinderTest plain(x_min, x_max, func);
+    plain.shift = shift;
+    const fixed expected = plain.find_zero(x_min);
+    n_plain += plain.get_evaluation_count();
+
+    ZeroFinderTest hinted(x_min, x_max, func);
+    hinted.shift = shift;
+    hinted.set_hint(hint);
+    const fixed x = hinted.find_zero(x_min);
+    n_hint += hinted.get_evaluation_count();
+
+    if (fabs(x - expected) > fixed(0.0002))
+      equal = false;
+  }
+
+  ok1(equal);
+  ok1(n_hint < n_plain);
+}
+
+/**
+ * A tentative search must not touch the hint; only the committed
+ * solution may.
+ */
+static void
+TestCommitHint()
+{
+  ZeroFinder::Hint hint;
+
+  ZeroFinderTest first(fixed(0), fixed(10), 1);
+  first.set_hint(hint);
+  const fixed x = first.find_zero(fixed(0));
+  ok1(hint.defined && equals(hint.x, x));
+
+  ZeroFinderTest moved(fixed(0), fixed(10), 1);
+  moved.shift = fixed(2);
+  moved.set_hint(hint);
+  const fixed x_moved = moved.find_zero_tentative(fixed(0));
+  ok1(fabs(x_moved - fixed(3.584963)) < fixed(0.0002));
+  ok1(equals(hint.x, x));
+
+  moved.commit_hint(x_moved);
+  ok1(equals(hint.x, x_moved));
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(18);
+  plan_tests(28);
 
   ZeroFinderTest zf(fixed(-100), fixed(100), 0);
   ok1(equals(zf.find_zero(fixed(-150)), fixed(-1)));
@@ -84,5 +151,11 @@ int main(int argc, char **argv)
   ok1(equals(zf4.find_min(fixed(1)), fixed_pi));
   ok1(equals(zf4.find_min(fixed(140)), fixed_pi));
 
+  TestHint(0, fixed(0), fixed(100));
+  TestHint(1, fixed(0), fixed(10));
+  TestHint(2, fixed(0), fixed_pi + fixed(1));
+
+  TestCommitHint();
+
   return exit_status();
 }
@@ -234,6 +234,17 @@ run_flight(TestFlightComponents components, TaskManager &task_manager,
   if (verbose)
     PrintDistanceCounts();
 
+  if (verbose > 1 && airspace_warnings &&
+      airspace_warnings->GetUpdateCount() > 0) {
+    const unsigned n = airspace_warnings->GetUpdateCount();
+    printf("# Airspace warnings\n");
+    printf("#     airspace re-queries/c %d%%\n",
+           100 * airspace_warnings->GetRequeryCount() / n);
+    printf("#     airspaces examined/c %d\n",
+           (int)(airspace_warnings->GetExaminedCount() / n));
+    printf("#    (total cycles %d)\n#\n", n);
+  }
+
   if (airspace_warnings)
     delete airspace_warnings;
 
@@ -26,6 +26,7 @@
 #include "TestUtil.hpp"
 #include "Route/TerrainRoute.hpp"
 #include "Engine/Route/ReachResult.hpp"
+#include "Engine/Route/ReachWorkers.hpp"
 #include "Terrain/RasterMap.hpp"
 #include "OS/PathName.hpp"
 #include "Compatibility/path.h"
@@ -35,6 +36,44 @@
 #include "Operation/Operation.hpp"
 #include "OS/FileUtil.hpp"
 
+#include <vector>
+
+/**
+ * Runs the parts of a job one after another, in reverse order, to
+ * check that the result does not depend on the order.
+ */
+class SerialReachWorkers final : public ReachWorkers {
+public:
+  virtual void Run(Job &job) override {
+    for (unsigned i = 3; i-- > 0;)
+      job.Run(i, 3);
+  }
+};
+
+/**
+ * Records all fans of a reach, to compare two of them.
+ */
+class FanRecorder final : public TriangleFanVisitor {
+public:
+  std::vector<GeoPoint> points;
+  std::vector<unsigned> fan_sizes;
+
+  virtual void StartFan() override {
+    fan_sizes.push_back(0);
+  }
+
+  virtual void AddPoint(const GeoPoint &p) override {
+    points.push_back(p);
+    ++fan_sizes.back();
+  }
+
+  virtual void EndFan() override {}
+
+  bool operator==(const FanRecorder &other) const {
+    return fan_sizes == other.fan_sizes && points == other.points;
+  }
+};
+
 static void test_reach(const RasterMap& map, fixed mwind, fixed mc)
 {
   GlideSettings settings;
@@ -66,6 +105,69 @@ static void test_reach(const RasterMap& map, fixed mwind, fixed mc)
   GeoPoint dest(origin.longitude-Angle::Degrees(0.02),
                 origin.latitude-Angle::Degrees(0.02));
 
+  {
+    /* the batched search must give the same results as searching
+       each destination on its own */
+    std::vector<AGeoPoint> dests;
+    for (unsigned i = 0; i < 20; ++i) {
+      for (unsigned j = 0; j < 20; ++j) {
+        fixed fx = (fixed)i / 19 * 2 - fixed(1);
+        fixed fy = (fixed)j / 19 * 2 - fixed(1);
+        GeoPoint x(origin.longitude + Angle::Degrees(fixed(0.6) * fx),
+                   origin.latitude + Angle::Degrees(fixed(0.6) * fy));
+        dests.push_back(AGeoPoint(x,
+                                  RoughAltitude(map.GetInterpolatedHeight(x))));
+      }
+    }
+
+    std::vector<ReachResult> batch(dests.size());
+    ok1(route.FindPositiveArrival(dests.data(), dests.size(), batch.data()));
+
+    bool equal = true;
+    for (unsigned i = 0; i < dests.size(); ++i) {
+      ReachResult single;
+      route.FindPositiveArrival(dests[i], single);
+      if (single.direct != batch[i].direct ||
+          single.terrain_valid != batch[i].terrain_valid ||
+          single.terrain != batch[i].terrain)
+        equal = false;
+    }
+
+    ok(equal, "batched arrival", 0);
+
+    /* the reach solved by workers must have the same fans as the
+       sequential one */
+    const RoutePolars rpolars =
+      route.PrepareReach(aorigin, config, RoughAltitude::Max());
+
+    ReachFan sequential;
+    sequential.Solve(aorigin, rpolars, &map, true);
+
+    SerialReachWorkers workers;
+    ReachFan parallel;
+    parallel.Solve(aorigin, rpolars, &map, true, &workers);
+
+    FanRecorder sequential_fans, parallel_fans;
+    sequential.AcceptInRange(map.GetBounds(), sequential_fans);
+    parallel.AcceptInRange(map.GetBounds(), parallel_fans);
+    ok(!sequential_fans.fan_sizes.empty() &&
+       sequential_fans == parallel_fans, "parallel fans", 0);
+
+    route.SwapReach(parallel, rpolars);
+
+    std::vector<ReachResult> batch2(dests.size());
+    route.FindPositiveArrival(dests.data(), dests.size(), batch2.data());
+
+    equal = true;
+    for (unsigned i = 0; i < dests.size(); ++i)
+      if (batch2[i].direct != batch[i].direct ||
+          batch2[i].terrain_valid != batch[i].terrain_valid ||
+          batch2[i].terrain != batch[i].terrain)
+        equal = false;
+
+    ok(equal, "parallel reach", 0);
+  }
+
   {
     Directory::Create(_T("output/results"));
     std::ofstream fout("output/results/terrain.txt");
@@ -119,7 +221,7 @@ int main(int argc, char** argv) {
     map.SetViewCenter(map.GetMapCenter(), fixed(100000));
   } while (map.IsDirty());
 
-  plan_tests(1);
+  plan_tests(5);
   test_reach(map, fixed(0), fixed(0.1));
 
   return exit_status();
@@ -33,6 +33,7 @@
 #include "Terrain/RasterMap.hpp"
 #include "OS/PathName.hpp"
 #include "OS/FileUtil.hpp"
+#include "OS/Clock.hpp"
 #include "Compatibility/path.h"
 #include "Operation/Operation.hpp"
 
@@ -143,10 +144,13 @@ test_route(const unsigned n_airspaces, const RasterMap& map)
       loc_end.latitude += Angle::Degrees(0.1);
       loc_end.altitude = map.GetHeight(loc_end) + 100;
       route.Synchronise(airspaces, loc_start, loc_end);
+      const unsigned start_time = MonotonicClockUS();
       if (route.Solve(loc_start, loc_end, config)) {
         sol = true;
         if (verbose) {
+          const unsigned elapsed = MonotonicClockUS() - start_time;
           PrintHelper::print_route(route);
+          printf("# solved in %u us\n", elapsed);
         }
       } else {
         if (verbose) {